@@ -0,0 +1,419 @@
+/*
+  ==============================================================================
+
+    ChorusFlangerBatch.cpp
+    Created: 18 Oct 2026 3:05:12am
+
+  ==============================================================================
+*/
+
+#include "ChorusFlangerBatch.h"
+#include "DspKernels.h"
+
+/** the copies must round alike, see DspKernels.cpp. GCC gets -ffp-contract=off from the project's
+    compiler flags */
+#if JUCE_CLANG
+ #pragma clang fp contract(off)
+#endif
+
+namespace
+{
+    constexpr int kGroupSize = ChorusFlangerBatch::kLaneAlignment;
+
+    /** the longest chunk of samples gathered at once, 1 ms at 32 kHz, beyond that the gathered
+        samples outgrow the stack */
+    constexpr int kMaxChunkSize = 32;
+
+    /** one group's ramps and LFO phases, copied out of the lane arrays for a sub-block */
+    struct GroupRamps
+    {
+        float values[ParameterSmoothers::kNumSmoothers][kGroupSize];
+        float targets[ParameterSmoothers::kNumSmoothers][kGroupSize];
+        float steps[ParameterSmoothers::kNumSmoothers][kGroupSize];
+        int countdowns[ParameterSmoothers::kNumSmoothers][kGroupSize];
+        float phases[kGroupSize];
+    };
+
+    /** one group's sub-block: sample-by-lane arrays of kGroupSize values per sample, the group's
+        columns of the lane arrays and its delay line */
+    struct GroupBlock
+    {
+        float* lfo;             // the phases, then the LFO outputs
+        float* depths;
+        float* feedbacks;
+        float* wets;
+        float* fractions;
+        int* readIndices;
+        int* nextIndices;
+        float* frames;          // the input going in and the output coming out
+
+        /** the old Type's reads, while isFading */
+        float* fadeFractions;
+        int* fadeReadIndices;
+        int* fadeNextIndices;
+
+        const float* minDelay;
+        const float* maxDelay;
+        const float* fadeScales;
+        const float* fadeOffsets;
+        const int* fadePositions;
+        float* feedbackState;
+
+        /** whether any lane of the group is fading to a new Type */
+        bool isFading;
+        int fadeLength;
+
+        float* data;
+        int mask;
+        float length;
+        int writeHead;
+
+        double sampleRate;
+        int chunkSize;
+        int numSamples;
+    };
+
+    /** the stages of processGroup but the LFO, which has kernels of its own */
+    struct GroupKernels
+    {
+        void (*stepRamps)(GroupRamps& ramps, const GroupBlock& block);
+        void (*mapPositions)(const GroupBlock& block);
+        void (*mapFadingPositions)(const GroupBlock& block);
+        void (*mixChunks)(const GroupBlock& block);
+    };
+
+    #define KP_KERNEL
+    namespace generic
+    {
+        #include "ChorusFlangerBatchImpl.h"
+    }
+    #undef KP_KERNEL
+
+   #if KP_MULTI_ISA
+    #define KP_KERNEL KP_TARGET_SSE41
+    namespace sse41
+    {
+        #include "ChorusFlangerBatchImpl.h"
+    }
+    #undef KP_KERNEL
+
+    #define KP_KERNEL KP_TARGET_AVX2
+    namespace avx2
+    {
+        #include "ChorusFlangerBatchImpl.h"
+    }
+    #undef KP_KERNEL
+
+    #define KP_KERNEL KP_TARGET_AVX512
+    namespace avx512
+    {
+        #include "ChorusFlangerBatchImpl.h"
+    }
+    #undef KP_KERNEL
+   #endif
+
+    /** a build without the other copies runs the generic one for every Isa */
+    const GroupKernels* const groupTables[DspKernels::kNumIsas] =
+    {
+        &generic::groupKernels,
+       #if KP_MULTI_ISA
+        &sse41::groupKernels,
+        &avx2::groupKernels,
+        &avx512::groupKernels
+       #else
+        &generic::groupKernels,
+        &generic::groupKernels,
+        &generic::groupKernels
+       #endif
+    };
+}
+
+//==============================================================================
+ChorusFlangerBatch::ChorusFlangerBatch()
+{
+    mSampleRate = 44100;
+    mMaxBlockSize = 0;
+    mNumLanes = 0;
+    mNumPaddedLanes = 0;
+    mTypeFadeLength = 1;
+
+    for (auto& length : mRampLengths){
+        length = 0;
+    }
+}
+
+void ChorusFlangerBatch::prepare (double sampleRate, int maximumBlockSize, int numLanes)
+{
+    mSampleRate = sampleRate;
+    mMaxBlockSize = juce::jmax(1, maximumBlockSize);
+    mNumLanes = juce::jmax(1, numLanes);
+    mNumPaddedLanes = (mNumLanes + kLaneAlignment - 1) / kLaneAlignment * kLaneAlignment;
+
+    /** the same ramp lengths juce::SmoothedValue works out in ParameterSmoothers::prepare */
+    for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+        const double rampSeconds = ParameterSmoothers::getRampTimeMs((ParameterSmoothers::Index)smoother) / 1000.0;
+        mRampLengths[smoother] = (int)std::floor(rampSeconds * sampleRate);
+    }
+
+    /** and the engine's Type fade, see ChorusFlangerEngine::startTypeFade */
+    mTypeFadeLength = juce::jmax(1, (int)(sampleRate * ChorusFlangerEngine::kTypeFadeMs / 1000.0));
+
+    mLaneState.setSize(kNumLaneArrays, mNumPaddedLanes, false, false, true);
+    mLaneState.clear();
+    mRampCountdowns.allocate((size_t)(ParameterSmoothers::kNumSmoothers * mNumPaddedLanes), true);
+    mFrames.allocate((size_t)(mMaxBlockSize * mNumPaddedLanes), true);
+    mGroupScratch.setSize(kNumGroupArrays, mMaxBlockSize * kLaneAlignment, false, false, true);
+    mGroupScratch.clear();
+    mGroupIndices.allocate((size_t)(4 * mMaxBlockSize * kLaneAlignment), true);
+    mFadePositions.allocate((size_t)mNumPaddedLanes, true);
+
+    /** a delay line per group with a channel per lane, padding lanes included, so a group's frame is
+        one cache line and its whole history one contiguous block */
+    const int numGroups = mNumPaddedLanes / kLaneAlignment;
+    mDelayLines.resize((size_t)numGroups);
+
+    for (auto& delayLine : mDelayLines){
+        if (delayLine == nullptr){
+            delayLine = std::make_unique<DelayLine>();
+        }
+        delayLine->prepare(sampleRate, MAX_DELAY_TIME, kLaneAlignment);
+    }
+
+    mLFO.reset();
+
+    const ParameterSnapshot defaults;
+    for (int lane = 0; lane < mNumPaddedLanes; lane++){
+        startLane(lane, defaults);
+    }
+}
+
+void ChorusFlangerBatch::releaseMemory()
+{
+    mLaneState.setSize(0, 0);
+    mRampCountdowns.free();
+    mFrames.free();
+    mGroupScratch.setSize(0, 0);
+    mGroupIndices.free();
+    mFadePositions.free();
+    mDelayLines.clear();
+
+    mNumLanes = 0;
+    mNumPaddedLanes = 0;
+}
+
+void ChorusFlangerBatch::reset()
+{
+    for (auto& delayLine : mDelayLines){
+        delayLine->clear();
+    }
+    mLFO.reset();
+
+    juce::FloatVectorOperations::clear(getLaneArray(kPhase), mNumPaddedLanes);
+    juce::FloatVectorOperations::clear(getLaneArray(kFeedbackState), mNumPaddedLanes);
+
+    for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+        juce::FloatVectorOperations::copy(getRampArray(kRampValue, smoother), getRampArray(kRampTarget, smoother), mNumPaddedLanes);
+        std::fill(getCountdowns(smoother), getCountdowns(smoother) + mNumPaddedLanes, 0);
+    }
+
+    std::fill(mFadePositions.get(), mFadePositions.get() + mNumPaddedLanes, mTypeFadeLength);
+}
+
+//==============================================================================
+void ChorusFlangerBatch::setParameters (int lane, const ParameterSnapshot& snapshot)
+{
+    jassert (lane >= 0 && lane < mNumPaddedLanes);
+
+    setLaneTargets(lane, snapshot, false);
+    setLaneRange(lane, snapshot.type, false);
+}
+
+void ChorusFlangerBatch::startLane (int lane, const ParameterSnapshot& snapshot)
+{
+    jassert (lane >= 0 && lane < mNumPaddedLanes);
+
+    setLaneTargets(lane, snapshot, true);
+    setLaneRange(lane, snapshot.type, true);
+
+    getLaneArray(kPhase)[lane] = 0;
+    getLaneArray(kFeedbackState)[lane] = 0;
+
+    /** the lane's column of its group's delay line, one sample per frame */
+    auto& delayLine = *mDelayLines[(size_t)(lane / kLaneAlignment)];
+    for (int frame = 0; frame < delayLine.getLength(); frame++){
+        delayLine.setSample(lane % kLaneAlignment, frame, 0);
+    }
+}
+
+void ChorusFlangerBatch::setLaneTargets (int lane, const ParameterSnapshot& snapshot, bool shouldJump)
+{
+    for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+        const float newTarget = ParameterSmoothers::getValue(snapshot, (ParameterSmoothers::Index)smoother);
+
+        float& value = getRampArray(kRampValue, smoother)[lane];
+        float& target = getRampArray(kRampTarget, smoother)[lane];
+        float& step = getRampArray(kRampStep, smoother)[lane];
+        int& countdown = getCountdowns(smoother)[lane];
+
+        /** juce::SmoothedValue::setTargetValue, lane by lane */
+        if (shouldJump || mRampLengths[smoother] <= 0){
+            value = target = newTarget;
+            countdown = 0;
+            continue;
+        }
+
+        if (newTarget == target){
+            continue;
+        }
+
+        target = newTarget;
+        countdown = mRampLengths[smoother];
+        step = (target - value) / (float)countdown;
+    }
+}
+
+void ChorusFlangerBatch::setLaneRange (int lane, int type, bool shouldJump)
+{
+    float minDelay, maxDelay;
+    ChorusFlangerEngine::getDelayRange(type, minDelay, maxDelay);
+
+    float& laneMinDelay = getLaneArray(kMinDelay)[lane];
+    float& laneMaxDelay = getLaneArray(kMaxDelay)[lane];
+    float& fadeScale = getLaneArray(kFadeScale)[lane];
+    float& fadeOffset = getLaneArray(kFadeOffset)[lane];
+
+    if (shouldJump){
+        fadeScale = 1;
+        fadeOffset = 0;
+        mFadePositions[lane] = mTypeFadeLength;
+    } else if (minDelay != laneMinDelay || maxDelay != laneMaxDelay){
+        /** the old Type keeps sweeping in step with the new one, its delays mapped from the new range to its own */
+        fadeScale = (laneMaxDelay - laneMinDelay) / (maxDelay - minDelay);
+        fadeOffset = (float)(mSampleRate * laneMinDelay - fadeScale * mSampleRate * minDelay);
+        mFadePositions[lane] = 0;
+    }
+
+    laneMinDelay = minDelay;
+    laneMaxDelay = maxDelay;
+}
+
+//==============================================================================
+void ChorusFlangerBatch::process (const float* const* inputs, float* const* outputs, int numSamples)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    /** there are no frames to process in until prepare() */
+    jassert(mMaxBlockSize > 0);
+
+    if (mMaxBlockSize <= 0){
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += mMaxBlockSize){
+        const int blockLength = juce::jmin(mMaxBlockSize, numSamples - start);
+
+        /** lanes into frames, a lane's samples end up kLaneAlignment apart */
+        for (int lane = 0; lane < mNumLanes; lane++){
+            const float* input = inputs[lane] + start;
+            float* frames = getFrames(lane);
+
+            for (int i = 0; i < blockLength; i++){
+                frames[i * kLaneAlignment] = input[i];
+            }
+        }
+
+        for (int firstLane = 0; firstLane < mNumPaddedLanes; firstLane += kLaneAlignment){
+            processGroup(firstLane, blockLength);
+        }
+
+        for (int lane = 0; lane < mNumLanes; lane++){
+            float* output = outputs[lane] + start;
+            const float* frames = getFrames(lane);
+
+            for (int i = 0; i < blockLength; i++){
+                output[i] = frames[i * kLaneAlignment];
+            }
+        }
+    }
+
+    /** a decaying feedback loop would otherwise crawl through denormals */
+    float* feedbackState = getLaneArray(kFeedbackState);
+    for (int lane = 0; lane < mNumPaddedLanes; lane++){
+        feedbackState[lane] = std::abs(feedbackState[lane]) < std::numeric_limits<float>::min() ? 0.f : feedbackState[lane];
+    }
+}
+
+void ChorusFlangerBatch::processGroup (int firstLane, int numSamples)
+{
+    const auto& kernels = *groupTables[DspKernels::getIsa()];
+    auto& delayLine = *mDelayLines[(size_t)(firstLane / kLaneAlignment)];
+
+    GroupBlock block;
+    block.lfo = mGroupScratch.getWritePointer(kGroupLFO);
+    block.depths = mGroupScratch.getWritePointer(kGroupDepth);
+    block.feedbacks = mGroupScratch.getWritePointer(kGroupFeedback);
+    block.wets = mGroupScratch.getWritePointer(kGroupWet);
+    block.fractions = mGroupScratch.getWritePointer(kGroupFraction);
+    block.readIndices = mGroupIndices.get();
+    block.nextIndices = mGroupIndices.get() + mMaxBlockSize * kLaneAlignment;
+    block.frames = getFrames(firstLane);
+    block.fadeFractions = mGroupScratch.getWritePointer(kGroupFadeFraction);
+    block.fadeReadIndices = mGroupIndices.get() + 2 * mMaxBlockSize * kLaneAlignment;
+    block.fadeNextIndices = mGroupIndices.get() + 3 * mMaxBlockSize * kLaneAlignment;
+    block.minDelay = getLaneArray(kMinDelay) + firstLane;
+    block.maxDelay = getLaneArray(kMaxDelay) + firstLane;
+    block.fadeScales = getLaneArray(kFadeScale) + firstLane;
+    block.fadeOffsets = getLaneArray(kFadeOffset) + firstLane;
+    block.fadePositions = mFadePositions.get() + firstLane;
+    block.feedbackState = getLaneArray(kFeedbackState) + firstLane;
+    block.fadeLength = mTypeFadeLength;
+    block.isFading = std::any_of(block.fadePositions, block.fadePositions + kGroupSize, [this] (int position) { return position < mTypeFadeLength; });
+    block.data = delayLine.getData();
+    block.mask = delayLine.getMask();
+    block.length = (float)delayLine.getLength();
+    block.writeHead = delayLine.getWriteHead();
+    block.sampleRate = mSampleRate;
+    block.chunkSize = juce::jlimit(1, kMaxChunkSize, (int)(mSampleRate * FLANGER_MIN_DELAY_TIME) - 2);
+    block.numSamples = numSamples;
+
+    GroupRamps ramps;
+    std::copy(getLaneArray(kPhase) + firstLane, getLaneArray(kPhase) + firstLane + kGroupSize, ramps.phases);
+
+    for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+        std::copy(getRampArray(kRampValue, smoother) + firstLane, getRampArray(kRampValue, smoother) + firstLane + kGroupSize, ramps.values[smoother]);
+        std::copy(getRampArray(kRampTarget, smoother) + firstLane, getRampArray(kRampTarget, smoother) + firstLane + kGroupSize, ramps.targets[smoother]);
+        std::copy(getRampArray(kRampStep, smoother) + firstLane, getRampArray(kRampStep, smoother) + firstLane + kGroupSize, ramps.steps[smoother]);
+        std::copy(getCountdowns(smoother) + firstLane, getCountdowns(smoother) + firstLane + kGroupSize, ramps.countdowns[smoother]);
+    }
+
+    kernels.stepRamps(ramps, block);
+
+    std::copy(ramps.phases, ramps.phases + kGroupSize, getLaneArray(kPhase) + firstLane);
+
+    for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+        std::copy(ramps.values[smoother], ramps.values[smoother] + kGroupSize, getRampArray(kRampValue, smoother) + firstLane);
+        std::copy(ramps.countdowns[smoother], ramps.countdowns[smoother] + kGroupSize, getCountdowns(smoother) + firstLane);
+    }
+
+    /** stage 2: the whole block of phases through the LFO in one call, in place */
+    mLFO.process(block.lfo, block.lfo, numSamples * kLaneAlignment);
+
+    if (block.isFading){
+        kernels.mapFadingPositions(block);
+    } else {
+        kernels.mapPositions(block);
+    }
+
+    kernels.mixChunks(block);
+
+    delayLine.advance(numSamples);
+
+    /** a fade runs to the end of the sub-block it finishes in, as the engine's does */
+    if (block.isFading){
+        int* fadePositions = mFadePositions.get() + firstLane;
+
+        for (int lane = 0; lane < kGroupSize; lane++){
+            fadePositions[lane] = juce::jmin(mTypeFadeLength, fadePositions[lane] + numSamples);
+        }
+    }
+}
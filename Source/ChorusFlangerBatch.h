@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    ChorusFlangerBatch.h
+    Created: 18 Oct 2026 3:05:12am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LFO.h"
+#include "DelayLine.h"
+#include "Parameters.h"
+#include "ChorusFlangerEngine.h"
+
+//==============================================================================
+/**
+    Many independent mono chorus/flangers run side by side, one per lane.
+
+    Each lane is a stream of its own, with its own Depth, Rate, Phase Offset,
+    Feedback, Dry Wet and Type. The algorithm is the block pipeline of
+    ChorusFlangerEngine with the sine LFO, linear interpolation, one voice and no
+    oversampling. Phase Offset shifts a lane's LFO against the others, so lanes
+    at the same rate do not sweep in step.
+
+    The state is stored as structure of arrays, one row per value with a column
+    per lane: LFO phases, the ramps and targets of the continuous parameters,
+    feedback values and delay ranges. Lanes are processed in groups of
+    kLaneAlignment, one AVX-512 register of floats, a whole block per group, so a
+    group's state stays in cache. Each group has a delay line interleaving its
+    lanes frame by frame, so they share one write head and writing a frame is a
+    single contiguous store. Within a group every stage is a loop across the
+    lanes with no branches. The loops are built once per DspKernels::Isa, as the
+    kernels are, and the copy of DspKernels::getIsa() runs, so AVX2 and AVX-512
+    machines get vector code with gathers for the delay line reads from the same
+    binary. The number of lanes is padded to a whole group.
+
+    Input and output are one channel pointer per lane. Each block is transposed
+    into sample-by-lane blocks, one per group, processed in place, and transposed
+    back.
+
+    prepare() and releaseMemory() allocate, everything else is real-time safe.
+*/
+class ChorusFlangerBatch
+{
+public:
+
+    static constexpr int kLaneAlignment = 16;
+
+    ChorusFlangerBatch();
+
+    /** allocate for numLanes streams and calls of up to maximumBlockSize samples, longer calls are
+        processed in pieces. Every lane starts silent at the default parameters */
+    void prepare(double sampleRate, int maximumBlockSize, int numLanes);
+
+    /** hand all memory back, prepare allocates it again */
+    void releaseMemory();
+
+    /** silence every lane, restart the LFOs and jump each lane to its current targets */
+    void reset();
+
+    int getNumLanes() const     { return mNumLanes; }
+
+    //==============================================================================
+    /** the parameters of one lane from the next sample on. Continuous values ramp and a new Type
+        fades in over ChorusFlangerEngine::kTypeFadeMs, as they do in the engine. Waveform,
+        interpolation, voices, oversampling, tempo sync and Morph's delay range are not used */
+    void setParameters(int lane, const ParameterSnapshot& snapshot);
+
+    /** a new stream on one lane: clear its delay line and feedback, restart its LFO and jump to
+        the snapshot without a ramp. The other lanes carry on undisturbed */
+    void startLane(int lane, const ParameterSnapshot& snapshot);
+
+    //==============================================================================
+    /** process numSamples of every lane, one channel pointer per lane. Input and output may be
+        the same buffers */
+    void process(const float* const* inputs, float* const* outputs, int numSamples);
+
+private:
+
+    /** rows of mLaneState, one column per lane */
+    enum LaneArrays
+    {
+        kPhase = 0,
+        kMinDelay,
+        kMaxDelay,
+        kFadeScale,
+        kFadeOffset,
+        kFeedbackState,
+        kRampValue,
+        kRampTarget = kRampValue + ParameterSmoothers::kNumSmoothers,
+        kRampStep = kRampTarget + ParameterSmoothers::kNumSmoothers,
+        kNumLaneArrays = kRampStep + ParameterSmoothers::kNumSmoothers
+    };
+
+    float* getLaneArray(int index)                  { return mLaneState.getWritePointer(index); }
+    float* getRampArray(int first, int smoother)    { return mLaneState.getWritePointer(first + smoother); }
+    int* getCountdowns(int smoother)                { return mRampCountdowns.get() + smoother * mNumPaddedLanes; }
+
+    /** rows of mGroupScratch, one sample-by-lane block of a single group each */
+    enum GroupArrays
+    {
+        kGroupLFO = 0,
+        kGroupDepth,
+        kGroupFeedback,
+        kGroupWet,
+        kGroupFraction,
+        kGroupFadeFraction,
+        kNumGroupArrays
+    };
+
+    /** a lane's first sample in mFrames, the next is kLaneAlignment further on */
+    float* getFrames(int lane)      { return mFrames.get() + ((lane / kLaneAlignment) * mMaxBlockSize * kLaneAlignment) + lane % kLaneAlignment; }
+
+    /** one sub-block of at most mMaxBlockSize samples for the group of lanes starting at firstLane,
+        in place in mFrames */
+    void processGroup(int firstLane, int numSamples);
+
+    /** set one lane's ramp targets, jumping straight to them if shouldJump */
+    void setLaneTargets(int lane, const ParameterSnapshot& snapshot, bool shouldJump);
+
+    /** set one lane's delay range to its Type's. A new range fades in unless shouldJump, with the
+        old one sweeping in step, as ChorusFlangerEngine::startTypeFade does */
+    void setLaneRange(int lane, int type, bool shouldJump);
+
+    double mSampleRate;
+    int mMaxBlockSize;
+    int mNumLanes;
+    int mNumPaddedLanes;
+
+    /** ramp length of each smoother in samples */
+    int mRampLengths[ParameterSmoothers::kNumSmoothers];
+
+    juce::AudioBuffer<float> mLaneState;
+    juce::HeapBlock<int> mRampCountdowns;
+    juce::AudioBuffer<float> mGroupScratch;
+
+    /** the two sample indices of each linear read in a group's sub-block, then those of the old
+        Type's reads while a lane of the group fades to a new one */
+    juce::HeapBlock<int> mGroupIndices;
+
+    /** how far each lane's Type fade has got, mTypeFadeLength once it is over */
+    juce::HeapBlock<int> mFadePositions;
+    int mTypeFadeLength;
+
+    /** a sample-by-lane block of mMaxBlockSize frames per group, the input going in and the output
+        coming out */
+    juce::HeapBlock<float> mFrames;
+
+    /** one per group, a channel per lane interleaved frame by frame */
+    std::vector<std::unique_ptr<DelayLine>> mDelayLines;
+
+    /** turns a row of phases into a row of sine values */
+    LFO mLFO;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusFlangerBatch)
+};
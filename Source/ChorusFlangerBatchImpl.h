@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    ChorusFlangerBatchImpl.h
+    Created: 18 Oct 2026 3:05:12am
+
+  ==============================================================================
+*/
+
+/** The group loops behind ChorusFlangerBatch. ChorusFlangerBatch.cpp includes this file once per
+    Isa, inside a namespace of its own and with KP_KERNEL set to that Isa's target attribute, as
+    DspKernels.cpp does with DspKernelsImpl.h, so there is no include guard.
+
+    Every loop runs across the kGroupSize lanes of a group with no branches, so each copy vectorises
+    for its own Isa, the delay line reads becoming gathers from AVX2 on. GCC will not inline a
+    function built for another target, so juce::jmin and juce::jmap are written out as the calls
+    they stand for */
+
+/** a phase up to 2 wrapped as the engine does it, x - 1 only when x > 1. With a comparison GCC keeps
+    a branch and the loop stays scalar on AVX2, a truncation vectorises. 2 - x is exact from 1 to 2,
+    so its integer part is 0 exactly when x > 1 */
+KP_KERNEL inline float wrapPhase(float x)
+{
+    const int truncated = (int)(2.f - x);
+    const int wholeCycles = 1 - (truncated < 1 ? truncated : 1);
+    return x - (float)wholeCycles;
+}
+
+/** stage 1: step the ramps, juce::SmoothedValue::getNextValue without the branch so a lane lands
+    exactly on its target, keeping the values the later stages need. Then each lane's LFO phase,
+    shifted by its phase offset, before the accumulator steps on. A ramp selects first and adds
+    after, so the add is not conditional and the loop needs no masked arithmetic on AVX2.
+    The ramps are copied to the stack, where the compiler can see nothing else writes to them */
+KP_KERNEL void stepRamps(GroupRamps& state, const GroupBlock& block)
+{
+    GroupRamps ramps = state;
+
+    const double sampleRate = block.sampleRate;
+    const int numSamples = block.numSamples;
+    float* lfo = block.lfo;
+    float* depths = block.depths;
+    float* feedbacks = block.feedbacks;
+    float* wets = block.wets;
+
+    const float* wet = ramps.values[ParameterSmoothers::kDryWet];
+    const float* depth = ramps.values[ParameterSmoothers::kDepth];
+    const float* rate = ramps.values[ParameterSmoothers::kRate];
+    const float* phaseOffset = ramps.values[ParameterSmoothers::kPhaseOffset];
+    const float* feedback = ramps.values[ParameterSmoothers::kFeedback];
+    float* phase = ramps.phases;
+
+    for (int i = 0; i < numSamples; i++){
+        const int row = i * kGroupSize;
+
+        for (int smoother = 0; smoother < ParameterSmoothers::kNumSmoothers; smoother++){
+            for (int lane = 0; lane < kGroupSize; lane++){
+                const int remaining = ramps.countdowns[smoother][lane] > 0 ? ramps.countdowns[smoother][lane] - 1 : 0;
+                const bool isRamping = remaining > 0;
+                ramps.values[smoother][lane] = (isRamping ? ramps.values[smoother][lane] : ramps.targets[smoother][lane])
+                                             + (isRamping ? ramps.steps[smoother][lane] : 0.f);
+                ramps.countdowns[smoother][lane] = remaining;
+            }
+        }
+
+        for (int lane = 0; lane < kGroupSize; lane++){
+            lfo[row + lane] = wrapPhase(phase[lane] + phaseOffset[lane]);
+            phase[lane] = wrapPhase((float)(phase[lane] + rate[lane] / sampleRate));
+
+            depths[row + lane] = depth[lane];
+            feedbacks[row + lane] = feedback[lane];
+            wets[row + lane] = wet[lane];
+        }
+    }
+
+    state = ramps;
+}
+
+/** a lane's read position in samples, wrapped into the delay line, from its LFO output times its depth */
+KP_KERNEL inline float getReadPosition(float modulation, float minDelay, float maxDelay, double sampleRate, int writeHead, float length)
+{
+    const float delayTime = minDelay + ((maxDelay - minDelay) * (modulation + 1.f)) / 2.f;
+    const float delayTimeInSample = (float)(sampleRate * delayTime);
+
+    float delayReadHead = writeHead - delayTimeInSample;
+    delayReadHead += (delayReadHead < 0 ? length : 0.f);
+    return delayReadHead;
+}
+
+/** stage 3: map the LFO outputs to read positions, split into the two sample indices of each
+    linear read, each in its lane's column, and the fraction between them */
+KP_KERNEL void mapPositions(const GroupBlock& block)
+{
+    const double sampleRate = block.sampleRate;
+    const int numSamples = block.numSamples;
+    const int firstWriteHead = block.writeHead;
+    const int mask = block.mask;
+    const float length = block.length;
+    const float* minDelay = block.minDelay;
+    const float* maxDelay = block.maxDelay;
+    const float* lfo = block.lfo;
+    const float* depths = block.depths;
+    float* fractions = block.fractions;
+    int* readIndices = block.readIndices;
+    int* nextIndices = block.nextIndices;
+
+    for (int i = 0; i < numSamples; i++){
+        const int row = i * kGroupSize;
+        const int writeHead = (firstWriteHead + i) & mask;
+
+        for (int lane = 0; lane < kGroupSize; lane++){
+            const float delayReadHead = getReadPosition(lfo[row + lane] * depths[row + lane], minDelay[lane], maxDelay[lane], sampleRate, writeHead, length);
+
+            const int readHead_x = (int)delayReadHead;
+            fractions[row + lane] = delayReadHead - readHead_x;
+            readIndices[row + lane] = (readHead_x & mask) * kGroupSize + lane;
+            nextIndices[row + lane] = ((readHead_x + 1) & mask) * kGroupSize + lane;
+        }
+    }
+}
+
+/** stage 3 while a lane of the group fades to a new Type: the reads of mapPositions, and those of
+    the old Type, which sweeps in step with the new one with its delays mapped to its own range as
+    ChorusFlangerEngine::fadeOutPreviousType does. Lanes that are not fading get reads that
+    mixChunks leaves out */
+KP_KERNEL void mapFadingPositions(const GroupBlock& block)
+{
+    const double sampleRate = block.sampleRate;
+    const int numSamples = block.numSamples;
+    const int firstWriteHead = block.writeHead;
+    const int mask = block.mask;
+    const float length = block.length;
+    const float* minDelay = block.minDelay;
+    const float* maxDelay = block.maxDelay;
+    const float* fadeScales = block.fadeScales;
+    const float* fadeOffsets = block.fadeOffsets;
+    const float* lfo = block.lfo;
+    const float* depths = block.depths;
+    float* fractions = block.fractions;
+    int* readIndices = block.readIndices;
+    int* nextIndices = block.nextIndices;
+    float* fadeFractions = block.fadeFractions;
+    int* fadeReadIndices = block.fadeReadIndices;
+    int* fadeNextIndices = block.fadeNextIndices;
+
+    for (int i = 0; i < numSamples; i++){
+        const int row = i * kGroupSize;
+        const int writeHead = (firstWriteHead + i) & mask;
+        const float writePosition = (float)writeHead;
+
+        for (int lane = 0; lane < kGroupSize; lane++){
+            const float delayReadHead = getReadPosition(lfo[row + lane] * depths[row + lane], minDelay[lane], maxDelay[lane], sampleRate, writeHead, length);
+
+            const int readHead_x = (int)delayReadHead;
+            fractions[row + lane] = delayReadHead - readHead_x;
+            readIndices[row + lane] = (readHead_x & mask) * kGroupSize + lane;
+            nextIndices[row + lane] = ((readHead_x + 1) & mask) * kGroupSize + lane;
+
+            float delay = writePosition - delayReadHead;
+            delay += (delay < 0 ? length : 0.f);
+
+            float fadeReadHead = writePosition - (delay * fadeScales[lane] + fadeOffsets[lane]);
+            fadeReadHead += (fadeReadHead < 0 ? length : 0.f);
+
+            const int fadeHead_x = (int)fadeReadHead;
+            fadeFractions[row + lane] = fadeReadHead - fadeHead_x;
+            fadeReadIndices[row + lane] = (fadeHead_x & mask) * kGroupSize + lane;
+            fadeNextIndices[row + lane] = ((fadeHead_x + 1) & mask) * kGroupSize + lane;
+        }
+    }
+}
+
+/** stage 4: gather, interpolate and feed back in chunks shorter than the shortest delay either
+    Type reaches, with a sample to spare for the old Type's reads, as the engine does. Every read
+    in a chunk lands on frames written before it, so the reads are one flat loop of gathers and the
+    writes follow. The gathered samples go to a local array, which the compiler knows the delay
+    line cannot overlap. A fading lane crossfades from the old Type's reads to the new ones */
+KP_KERNEL void mixChunks(const GroupBlock& block)
+{
+    const int numSamples = block.numSamples;
+    const int chunkSize = block.chunkSize;
+    const int firstWriteHead = block.writeHead;
+    const int mask = block.mask;
+    const int fadeLength = block.fadeLength;
+    const float* fractions = block.fractions;
+    const float* fadeFractions = block.fadeFractions;
+    const int* fadeReadIndices = block.fadeReadIndices;
+    const int* fadeNextIndices = block.fadeNextIndices;
+    const int* fadePositions = block.fadePositions;
+    const float* feedbacks = block.feedbacks;
+    const float* wets = block.wets;
+    const int* readIndices = block.readIndices;
+    const int* nextIndices = block.nextIndices;
+    float* frames = block.frames;
+    float* data = block.data;
+    float* feedbackState = block.feedbackState;
+
+    float delayed[kMaxChunkSize * kGroupSize];
+
+    for (int start = 0; start < numSamples; start += chunkSize){
+        const int chunkLength = (numSamples - start < chunkSize) ? numSamples - start : chunkSize;
+        const int first = start * kGroupSize;
+
+        for (int j = 0; j < chunkLength * kGroupSize; j++){
+            delayed[j] = (1 - fractions[first + j]) * data[readIndices[first + j]] + fractions[first + j] * data[nextIndices[first + j]];
+        }
+
+        if (block.isFading){
+            for (int i = 0; i < chunkLength; i++){
+                const int row = (start + i) * kGroupSize;
+
+                for (int lane = 0; lane < kGroupSize; lane++){
+                    const float x0 = data[fadeReadIndices[row + lane]];
+                    const float fadingOut = x0 + fadeFractions[row + lane] * (data[fadeNextIndices[row + lane]] - x0);
+                    const float fadeIn = (float)(fadePositions[lane] + start + i + 1) / (float)fadeLength;
+                    const float newest = delayed[i * kGroupSize + lane];
+                    const float faded = fadingOut + (newest - fadingOut) * (fadeIn < 1.f ? fadeIn : 1.f);
+
+                    delayed[i * kGroupSize + lane] = fadePositions[lane] < fadeLength ? faded : newest;
+                }
+            }
+        }
+
+        for (int i = 0; i < chunkLength; i++){
+            const int row = (start + i) * kGroupSize;
+            float* frame = frames + row;
+            float* writeFrame = data + ((firstWriteHead + start + i) & mask) * kGroupSize;
+
+            for (int lane = 0; lane < kGroupSize; lane++){
+                const float input = frame[lane];
+                const float delayedSample = delayed[i * kGroupSize + lane];
+
+                writeFrame[lane] = input + feedbackState[lane];
+                feedbackState[lane] = delayedSample * feedbacks[row + lane];
+                frame[lane] = input * (1 - wets[row + lane]) + delayedSample * wets[row + lane];
+            }
+        }
+    }
+}
+
+//==============================================================================
+const GroupKernels groupKernels =
+{
+    &stepRamps,
+    &mapPositions,
+    &mapFadingPositions,
+    &mixChunks
+};
@@ -0,0 +1,1193 @@
+/*
+  ==============================================================================
+
+    ChorusFlangerEngine.cpp
+    Created: 18 Oct 2026 2:26:53am
+
+  ==============================================================================
+*/
+
+#include "ChorusFlangerEngine.h"
+#include "DspKernels.h"
+#include "Instrumentation.h"
+#include "ModulationTrace.h"
+
+/** the reference and the block pipeline round each multiply and add on its own, so a compiler that
+    fuses them cannot fuse them differently in each. GCC, which fuses by default on FMA targets, gets
+    -ffp-contract=off from the project's compiler flags */
+#if JUCE_CLANG
+ #pragma clang fp contract(off)
+#elif JUCE_MSVC
+ #pragma fp_contract (off)
+#endif
+
+namespace
+{
+    /** depth of each voice relative to the Depth parameter, so stacked voices sweep different ranges */
+    constexpr float kVoiceDepths[DelayLineReader::kMaxVoices] = { 1.f, 0.8f, 0.9f, 0.7f, 0.95f, 0.75f, 0.85f, 0.65f };
+
+    /** the shortest and longest delay each Type sweeps, in seconds, in ChorusFlangerEngine::Type order */
+    constexpr float kDelayRanges[ChorusFlangerEngine::kNumTypes][2] =
+    {
+        { CHORUS_MIN_DELAY_TIME, CHORUS_MAX_DELAY_TIME },
+        { FLANGER_MIN_DELAY_TIME, FLANGER_MAX_DELAY_TIME }
+    };
+}
+
+//==============================================================================
+ChorusFlangerEngine::ChorusFlangerEngine()
+{
+    mUseDoublePrecision = false;
+    mSampleRate = 0;
+    mMaxBlockSize = 0;
+    mNumChannels = 2;
+
+    mReservedSampleRate = 0;
+    mMaxOversamplingIndex = Oversampler::kMaxFactorIndex;
+
+    mOversamplingIndex = 0;
+    mOversamplingFactor = 1;
+    mProcessingSampleRate = 44100;
+
+    mNumSilentSamples = 0;
+    mSilentTailSamples = 0;
+    mSkippingBlock = false;
+    mIsIdle = false;
+    mNumBlocks = 0;
+    mNumSkippedBlocks = 0;
+
+    mSwitchCountdown = 0;
+
+    mInstrumentation = nullptr;
+    mModulationTrace = nullptr;
+    mTraceCountdown = 0;
+
+    mLFOPhase = 0;
+    mUseReferenceProcessing = false;
+
+    setNumVoices(1);
+}
+
+void ChorusFlangerEngine::prepare (double sampleRate, int maximumBlockSize, int numChannels, bool useDoublePrecision)
+{
+    mSampleRate = sampleRate;
+    mNumChannels = juce::jlimit(1, (int)DelayLine::kMaxChannels, numChannels);
+
+    /** a new start has no wet signal to protect, a waiting switch is made at once */
+    mSwitchCountdown = 0;
+    mSnapshot = mRequested;
+
+    resetModulation();
+    setNumVoices(mSnapshot.voices);
+
+    mNumSilentSamples = 0;
+    mSilentTailSamples = 0;
+    mSkippingBlock = false;
+    mIsIdle = false;
+
+    /** allocate the block pipeline arrays, longer calls are split into sub-blocks of mMaxBlockSize,
+        which become up to the reserved factor times longer when oversampled.
+        The memory is kept when a later prepare asks for the same size or less */
+    const int maxFactor = 1 << mMaxOversamplingIndex;
+
+    mMaxBlockSize = juce::jmax(1, maximumBlockSize);
+    mBlockScratch.setSize(kNumSharedScratchArrays + DelayLineReader::kMaxVoices * mNumChannels + 1,
+                          mMaxBlockSize * maxFactor, false, false, true);
+    mBlockScratch.clear();
+
+    /** only the precision being prepared needs memory */
+    mUseDoublePrecision = useDoublePrecision;
+
+    if (mUseDoublePrecision){
+        mFloatPath.releaseMemory();
+    } else {
+        mDoublePath.releaseMemory();
+    }
+
+    withSignalPath([this, sampleRate, maxFactor] (auto& path){
+        /** reserve the circular buffer for the longest delay at the reserved rate and oversampling factor,
+            so a change of factor or a new prepare at any rate up to it only resizes the buffer inside
+            the memory it already has */
+        path.delayLine.reserve(juce::jmax(sampleRate, mReservedSampleRate) * maxFactor, MAX_DELAY_TIME, mNumChannels);
+
+        /** the reader's tap arrays and the delayed samples cover a whole sub-block */
+        path.reader.prepare(mBlockScratch.getNumSamples());
+        path.delayed.setSize(mNumChannels, mBlockScratch.getNumSamples(), false, false, true);
+        path.delayed.clear();
+
+        /** at 1x the half-band filters never run, so they hold no memory */
+        if (mMaxOversamplingIndex > 0){
+            path.oversampler.prepare(mNumChannels, mMaxBlockSize);
+        } else {
+            path.oversampler.releaseMemory();
+        }
+
+        for (auto& state : path.feedbackState){
+            state = 0;
+        }
+    });
+
+    /** start the smoothers at the current parameter values and size the delay line for the
+        processing rate, this also clears it and resets the write head */
+    setOversampling(getOversamplingIndex(mSnapshot));
+}
+
+void ChorusFlangerEngine::setMemoryReservation (double maxSampleRate, int maxOversamplingIndex)
+{
+    mReservedSampleRate = juce::jmax(0.0, maxSampleRate);
+    mMaxOversamplingIndex = juce::jlimit(0, (int)Oversampler::kMaxFactorIndex, maxOversamplingIndex);
+}
+
+void ChorusFlangerEngine::releaseMemory()
+{
+    mFloatPath.releaseMemory();
+    mDoublePath.releaseMemory();
+    mBlockScratch.setSize(0, 0);
+    mMaxBlockSize = 0;
+}
+
+void ChorusFlangerEngine::reset()
+{
+    /** return every piece of processing state to where a newly prepared engine starts, at the
+        oversampling factor and with the values the parameters ask for */
+    applyPendingOversampling();
+
+    if (mSwitchCountdown > 0){
+        mSwitchCountdown = 0;
+        applyParameters(mRequested);
+    }
+
+    resetModulation();
+    mSmoothers.reset(mSnapshot);
+
+    withSignalPath([] (auto& path){
+        path.clear();
+    });
+
+    mNumSilentSamples = 0;
+    mSilentTailSamples = 0;
+    mSkippingBlock = false;
+    mIsIdle = false;
+    mTypeFade.length = 0;
+}
+
+void ChorusFlangerEngine::resetModulation()
+{
+    mLFOPhase = 0;
+    mTempoSync.reset();
+
+    for (auto& channelLFOs : mLFOs){
+        for (auto& lfo : channelLFOs){
+            lfo.reset();
+        }
+    }
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::SignalPath<SampleType>::clear()
+{
+    delayLine.clear();
+    reader.reset();
+    oversampler.reset();
+
+    for (auto& state : feedbackState){
+        state = 0;
+    }
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::SignalPath<SampleType>::releaseMemory()
+{
+    delayLine.releaseMemory();
+    reader.releaseMemory();
+    oversampler.releaseMemory();
+    delayed.setSize(0, 0);
+}
+
+//==============================================================================
+void ChorusFlangerEngine::setParameters (const ParameterSnapshot& snapshot)
+{
+    mRequested = snapshot;
+
+    /** a new Waveform, Interpolation, Voices or tempo sync would jump the wet signal. It waits while the
+        wet signal ramps to silence with the old values running, see advanceDiscreteSwitch() */
+    if (mSampleRate > 0 && hasDiscreteChange(snapshot, mSnapshot)){
+        if (mSwitchCountdown == 0){
+            const double rampTime = ParameterSmoothers::getRampTimeMs(ParameterSmoothers::kDryWet) / 1000.0;
+            mSwitchCountdown = juce::jmax(1, (int)std::ceil(mSampleRate * rampTime));
+        }
+
+        auto running = snapshot;
+        running.waveform = mSnapshot.waveform;
+        running.interpolation = mSnapshot.interpolation;
+        running.voices = mSnapshot.voices;
+        running.tempoSync = mSnapshot.tempoSync;
+        running.noteValue = mSnapshot.noteValue;
+        running.dryWet = 0;
+
+        applyParameters(running);
+        return;
+    }
+
+    /** no switch, or back to the values that are running, so a waiting one is called off */
+    mSwitchCountdown = 0;
+    applyParameters(snapshot);
+}
+
+bool ChorusFlangerEngine::hasDiscreteChange (const ParameterSnapshot& a, const ParameterSnapshot& b)
+{
+    /** the note value is only heard while the LFO is synced */
+    return a.waveform != b.waveform || a.interpolation != b.interpolation || a.voices != b.voices
+        || a.tempoSync != b.tempoSync || (a.noteValue != b.noteValue && a.tempoSync != 0);
+}
+
+void ChorusFlangerEngine::advanceDiscreteSwitch (int numSamples)
+{
+    if (mSwitchCountdown <= 0){
+        return;
+    }
+
+    jassert(numSamples <= mSwitchCountdown);
+    mSwitchCountdown -= numSamples;
+
+    /** the wet signal is silent, the new values come in and it ramps back up */
+    if (mSwitchCountdown <= 0){
+        mSwitchCountdown = 0;
+        applyParameters(mRequested);
+    }
+}
+
+void ChorusFlangerEngine::applyParameters (const ParameterSnapshot& snapshot)
+{
+    /** hosts pass the same values block after block, the setup is only worked out again when it depends on what moved */
+    const bool setupChanged = (snapshot.type != mSnapshot.type || snapshot.depth != mSnapshot.depth
+                               || snapshot.feedback != mSnapshot.feedback || snapshot.interpolation != mSnapshot.interpolation
+                               || snapshot.minDelayTime != mSnapshot.minDelayTime || snapshot.maxDelayTime != mSnapshot.maxDelayTime);
+
+    /** a new Type, or a morph starting or ending, jumps the delay range. A morph moving it between
+        the two only steps it as far as the morph moved */
+    const bool isMorphingRange = (snapshot.maxDelayTime > 0), wasMorphingRange = (mSnapshot.maxDelayTime > 0);
+    const bool rangeJumps = (isMorphingRange != wasMorphingRange) || (snapshot.type != mSnapshot.type && ! isMorphingRange);
+
+    const auto previous = mSnapshot;
+    mSnapshot = snapshot;
+
+    /** before the first prepare the values are only kept, prepare starts the ramps at them */
+    if (mSampleRate <= 0){
+        return;
+    }
+
+    /** a new oversampling factor clears the delay line, so it waits until that cannot be heard, see
+        applyPendingOversampling() */
+    if (setupChanged){
+        if (rangeJumps){
+            startTypeFade(previous);
+        }
+
+        updateBlockSetup();
+    }
+
+    mSmoothers.setTargets(mSnapshot);
+}
+
+void ChorusFlangerEngine::updateTimeline (juce::AudioPlayHead* playHead)
+{
+    /** a synced LFO takes its position from the host's timeline, at the processing rate */
+    if (mSnapshot.tempoSync != 0){
+        mTempoSync.update(playHead);
+    }
+}
+
+int ChorusFlangerEngine::getOversamplingIndex (const ParameterSnapshot& snapshot) const
+{
+    if (mUseReferenceProcessing){
+        return 0;
+    }
+
+    return juce::jlimit(0, mMaxOversamplingIndex, snapshot.oversampling);
+}
+
+void ChorusFlangerEngine::setOversampling (int factorIndex)
+{
+    withSignalPath([this, factorIndex] (auto& path){
+        path.oversampler.setFactorIndex(factorIndex);
+        mOversamplingIndex = path.oversampler.getFactorIndex();
+        mOversamplingFactor = path.oversampler.getFactor();
+        mProcessingSampleRate = mSampleRate * mOversamplingFactor;
+
+        /** fits in the storage reserved by prepare, so this only resizes and clears */
+        path.delayLine.prepare(mProcessingSampleRate, MAX_DELAY_TIME, mNumChannels);
+        path.reader.reset();
+
+        for (auto& state : path.feedbackState){
+            state = 0;
+        }
+    });
+
+    /** ramp lengths follow the processing rate, and the ramps start at the current parameter values */
+    mSmoothers.prepare(mProcessingSampleRate, mSnapshot);
+    mTempoSync.prepare(mProcessingSampleRate);
+
+    /** the delay line was cleared, there is nothing left of the old Type to fade out */
+    mTypeFade.length = 0;
+
+    updateBlockSetup();
+}
+
+bool ChorusFlangerEngine::hasPendingOversampling() const
+{
+    return mSampleRate > 0 && getOversamplingIndex(mSnapshot) != mOversamplingIndex;
+}
+
+void ChorusFlangerEngine::applyPendingOversampling()
+{
+    if (hasPendingOversampling()){
+        setOversampling(getOversamplingIndex(mSnapshot));
+    }
+}
+
+void ChorusFlangerEngine::updateBlockSetup()
+{
+    mSetup.tailSamples = (juce::int64)std::ceil(getTailLengthSeconds(mSnapshot) * mSampleRate);
+
+    /** every read in a chunk has to land on samples written before the chunk, see processSubBlock() */
+    getDelayRange(mSnapshot, mSetup.minDelayTime, mSetup.maxDelayTime);
+    const auto interpolation = (DelayLineReader::Mode)mSnapshot.interpolation;
+    mSetup.chunkSize = juce::jmax(1, (int)(mProcessingSampleRate * mSetup.minDelayTime) - 1 - DelayLineReader::getTapsAhead(interpolation));
+
+    for (int channel = 0; channel < DelayLine::kMaxChannels; channel++){
+        mSetup.channelSpreads[channel] = getChannelPhaseSpread(channel);
+    }
+
+    mSetup.floatKernel = findKernel<float>(mNumChannels, mSnapshot.interpolation);
+    mSetup.doubleKernel = findKernel<double>(mNumChannels, mSnapshot.interpolation);
+}
+
+void ChorusFlangerEngine::startTypeFade (const ParameterSnapshot& previous)
+{
+    /** the old Type keeps sweeping in step with the new one, its delays mapped from the new range to its own */
+    float minOld, maxOld, minNew, maxNew;
+    getDelayRange(previous, minOld, maxOld);
+    getDelayRange(mSnapshot, minNew, maxNew);
+
+    const double sampleRate = mProcessingSampleRate;
+
+    mTypeFade.position = 0;
+    mTypeFade.length = juce::jmax(1, (int)(sampleRate * kTypeFadeMs / 1000.0));
+    mTypeFade.delayScale = (maxOld - minOld) / (maxNew - minNew);
+    mTypeFade.delayOffset = (float)(sampleRate * minOld - mTypeFade.delayScale * sampleRate * minNew);
+    mTypeFade.chunkSize = juce::jmax(1, (int)(sampleRate * minOld) - 2);
+}
+
+int ChorusFlangerEngine::getLatencySamples() const
+{
+    const double latency = mUseDoublePrecision ? mDoublePath.oversampler.getLatencyInSamples()
+                                               : mFloatPath.oversampler.getLatencyInSamples();
+
+    return juce::roundToInt(latency);
+}
+
+void ChorusFlangerEngine::setUseReferenceProcessing (bool shouldUseReference)
+{
+    mUseReferenceProcessing = shouldUseReference;
+
+    /** the reference always runs at 1x, a prepared engine switches factor straight away. This is a
+        switch for tests, made between renders */
+    applyPendingOversampling();
+}
+
+void ChorusFlangerEngine::setLFOBackend (LFO::Backend newBackend)
+{
+    for (auto& channelLFOs : mLFOs){
+        for (auto& lfo : channelLFOs){
+            lfo.setBackend(newBackend);
+        }
+    }
+}
+
+//==============================================================================
+void ChorusFlangerEngine::process (const float* const* input, float* const* output, int numSamples)
+{
+    processTemplate(input, output, numSamples);
+}
+
+void ChorusFlangerEngine::process (const double* const* input, double* const* output, int numSamples)
+{
+    processTemplate(input, output, numSamples);
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::processTemplate (const SampleType* const* input, SampleType* const* output, int numSamples)
+{
+    for (int channel = 0; channel < mNumChannels; channel++){
+        if (input[channel] != output[channel]){
+            juce::FloatVectorOperations::copy(output[channel], input[channel], numSamples);
+        }
+    }
+
+    startBlock(output, mNumChannels, numSamples);
+    processSegment(output, 0, numSamples);
+    finishBlock();
+}
+
+template <typename SampleType>
+bool ChorusFlangerEngine::startBlock (const SampleType* const* input, int numInputChannels, int numSamples)
+{
+    jassert(mUseDoublePrecision == (std::is_same<SampleType, double>::value));
+
+    /** some hosts send zero-length blocks, they leave every piece of state, the idle count included, as it was */
+    if (numSamples <= 0){
+        mSkippingBlock = true;
+        return false;
+    }
+
+    mSkippingBlock = updateIdleState(getSignalPath((SampleType*)nullptr), input, numInputChannels, numSamples);
+
+    /** only this thread writes the counts, so a plain store is enough and keeps a locked add out of every call */
+    mNumBlocks.store(mNumBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (mSkippingBlock){
+        mNumSkippedBlocks.store(mNumSkippedBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        /** the delay line has decayed to silence, so clearing it for a new oversampling factor is inaudible */
+        applyPendingOversampling();
+    }
+
+    return ! mSkippingBlock;
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::processSegment (SampleType* const* channels, int startSample, int numSamples)
+{
+    /** the input of a skipped block is all zeros, which is already the right output. The LFO, ramps
+        and write head still carry on through each stretch, so a parameter change between them starts
+        its ramp at the same sample as in a processed block */
+    if (mSkippingBlock){
+        advanceModulation(numSamples);
+        return;
+    }
+
+    /** there are no scratch arrays to run the pipeline in until prepare() */
+    jassert(mMaxBlockSize > 0);
+
+    if (mMaxBlockSize <= 0){
+        return;
+    }
+
+    auto& path = getSignalPath((SampleType*)nullptr);
+
+    /** a waiting switch of the discrete values lands on its own sample whatever the block size, so
+        the segment is split there */
+    while (numSamples > 0){
+        const int numThisTime = (mSwitchCountdown > 0) ? juce::jmin(numSamples, mSwitchCountdown) : numSamples;
+
+        if (mUseReferenceProcessing){
+            processBlockReference(path, channels, startSample, numThisTime);
+        } else {
+            processSubBlocks(path, channels, startSample, numThisTime);
+        }
+
+        advanceDiscreteSwitch(numThisTime);
+        startSample += numThisTime;
+        numSamples -= numThisTime;
+    }
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::processSubBlocks (SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples)
+{
+    /** run the block pipeline in sub-blocks no longer than the prepared scratch arrays */
+    const int factor = mOversamplingFactor;
+
+    for (int start = 0; start < numSamples; start += mMaxBlockSize){
+        const int numThisTime = juce::jmin(mMaxBlockSize, numSamples - start);
+
+        if (factor == 1){
+            processSubBlock(path, channels, startSample + start, numThisTime);
+            continue;
+        }
+
+        /** the whole pipeline, dry path included, runs at the oversampled rate between the half-band filters */
+        SampleType* const* oversampled = path.oversampler.upsample(channels, startSample + start, numThisTime);
+        processSubBlock(path, oversampled, 0, numThisTime * factor);
+        path.oversampler.downsample(channels, startSample + start, numThisTime);
+    }
+}
+
+void ChorusFlangerEngine::finishBlock()
+{
+    if (mSkippingBlock){
+        return;
+    }
+
+    withSignalPath([this] (auto& path){
+        flushDenormals(path);
+    });
+}
+
+void ChorusFlangerEngine::advanceModulation (juce::int64 numSamples)
+{
+    if (mMaxBlockSize <= 0){
+        return;
+    }
+
+    /** split where a waiting discrete switch lands, as processSegment does */
+    while (numSamples > 0){
+        const auto numThisTime = (mSwitchCountdown > 0) ? juce::jmin(numSamples, (juce::int64)mSwitchCountdown) : numSamples;
+        advanceSubBlocks(numThisTime);
+        advanceDiscreteSwitch((int)numThisTime);
+        numSamples -= numThisTime;
+    }
+}
+
+void ChorusFlangerEngine::advanceSubBlocks (juce::int64 numSamples)
+{
+    /** the modulation only depends on the parameters and the sample count, so it can run ahead without audio.
+        Stepping through the same sub-block sizes as processSegment keeps the LFO backends block-aligned */
+    const int maxSubBlockSize = mMaxBlockSize * mOversamplingFactor;
+    numSamples *= mOversamplingFactor;
+
+    while (numSamples > 0){
+        const int numThisTime = (int)juce::jmin((juce::int64)maxSubBlockSize, numSamples);
+        computeModulation(numThisTime);
+        numSamples -= numThisTime;
+
+        /** the mix and feedback ramps advance with the audio, so step them as well */
+        mSmoothers.fillRamp(ParameterSmoothers::kDryWet, mBlockScratch.getWritePointer(kDryWet), numThisTime);
+        mSmoothers.fillRamp(ParameterSmoothers::kFeedback, mBlockScratch.getWritePointer(kFeedback), numThisTime);
+
+        /** the write head moves too, read positions then round exactly as they would have */
+        withSignalPath([numThisTime] (auto& path){
+            path.delayLine.advance(numThisTime);
+        });
+
+        /** and a Type fade runs its course, one started in an idle gap is over when the audio is back */
+        if (mTypeFade.length > 0){
+            mTypeFade.position += numThisTime;
+
+            if (mTypeFade.position >= mTypeFade.length){
+                mTypeFade.length = 0;
+            }
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void ChorusFlangerEngine::flushDenormals (SignalPath<SampleType>& path)
+{
+    /** the feedback state carries the tail from block to block, so checking it once per block
+        catches a decaying tail before it fills the delay line with subnormals */
+    int numFlushed = 0;
+
+    for (int channel = 0; channel < mNumChannels; channel++){
+        auto& state = path.feedbackState[channel];
+
+        if (state != 0 && std::abs(state) < std::numeric_limits<float>::min()){
+            state = 0;
+            numFlushed++;
+        }
+    }
+
+    if (mInstrumentation != nullptr){
+        mInstrumentation->addDenormalFlushes(numFlushed);
+    }
+}
+
+template <typename SampleType>
+bool ChorusFlangerEngine::updateIdleState (SignalPath<SampleType>& path, const SampleType* const* input, int numInputChannels, int numSamples)
+{
+    bool inputIsSilent = true;
+
+    for (int channel = 0; channel < numInputChannels && inputIsSilent; channel++){
+        const auto range = juce::FloatVectorOperations::findMinAndMax(input[channel], numSamples);
+        inputIsSilent = (range.getStart() == 0 && range.getEnd() == 0);
+    }
+
+    /** the tail of the last sounding block, or longer if the parameters have grown it since */
+    const auto tailSamples = mSetup.tailSamples;
+
+    if (! inputIsSilent){
+        /** the delay line was cleared on the way in, so the input starts against silence. The
+            modulation has been advanced through the skipped blocks and carries on from there */
+        if (mIsIdle){
+            mIsIdle = false;
+        }
+
+        mNumSilentSamples = 0;
+        mSilentTailSamples = tailSamples;
+        return false;
+    }
+
+    if (mIsIdle){
+        return true;
+    }
+
+    mSilentTailSamples = juce::jmax(mSilentTailSamples, tailSamples);
+
+    /** every output sample of this block comes after the tail, so what is left in the delay line is below kTailLevel */
+    if (mNumSilentSamples >= mSilentTailSamples){
+        const int writeHead = path.delayLine.getWriteHead();
+        path.clear();
+
+        /** the write head keeps its place, so read positions round the same as if nothing was skipped */
+        path.delayLine.advance(writeHead);
+        mIsIdle = true;
+        mTypeFade.length = 0;
+        return true;
+    }
+
+    mNumSilentSamples += numSamples;
+    return false;
+}
+
+double ChorusFlangerEngine::getTailLengthSeconds (const ParameterSnapshot& snapshot) const
+{
+    float minDelayTime, maxDelayTime;
+    getDelayRange(snapshot, minDelayTime, maxDelayTime);
+
+    /** the LFO peaks at depth either side of the middle of the delay range */
+    const double longestDelay = 0.5 * (minDelayTime + maxDelayTime) + 0.5 * (maxDelayTime - minDelayTime) * snapshot.depth;
+
+    /** the first echo arrives after one trip, each further trip scales it by the feedback */
+    const double feedback = juce::jmin(0.999, std::abs((double)snapshot.feedback));
+    double numTrips = 1;
+
+    if (feedback > 0){
+        numTrips += std::ceil(std::log((double)kTailLevel) / std::log(feedback));
+    }
+
+    const double latency = (mSampleRate > 0) ? getLatencySamples() / mSampleRate : 0.0;
+
+    return numTrips * longestDelay + latency;
+}
+
+void ChorusFlangerEngine::getDelayRange (int type, float& minDelayTime, float& maxDelayTime)
+{
+    const auto& range = kDelayRanges[juce::jlimit(0, kNumTypes - 1, type)];
+    minDelayTime = range[0];
+    maxDelayTime = range[1];
+}
+
+void ChorusFlangerEngine::getDelayRange (const ParameterSnapshot& snapshot, float& minDelayTime, float& maxDelayTime)
+{
+    if (snapshot.maxDelayTime > 0){
+        minDelayTime = snapshot.minDelayTime;
+        maxDelayTime = snapshot.maxDelayTime;
+        return;
+    }
+
+    getDelayRange(snapshot.type, minDelayTime, maxDelayTime);
+}
+
+//==============================================================================
+template <typename SampleType>
+void ChorusFlangerEngine::processBlockReference (SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples)
+{
+    auto& delayLine = path.delayLine;
+    float lfoOut[DelayLine::kMaxChannels];
+    SampleType delayedSample[DelayLine::kMaxChannels];
+
+    /** the reference runs at the base rate, the timeline position is counted at the processing rate */
+    const bool tempoSync = (mSnapshot.tempoSync != 0);
+    const int positionStep = mOversamplingFactor;
+
+    if (tempoSync){
+        mLFOPhase = (float)mTempoSync.getPhase(mSnapshot.noteValue);
+    }
+
+    /** Chorus or Flanger delay range, or one a morph has moved between them */
+    float minDelayTime, maxDelayTime;
+    getDelayRange(mSnapshot, minDelayTime, maxDelayTime);
+
+    /** iterate through all the samples in the buffer */
+    for (int i = startSample; i < startSample + numSamples; i++){
+
+        /** a Type switch fades the old Type out as the block pipeline does, see fadeOutPreviousType() */
+        const bool isFading = (mTypeFade.length > 0);
+        const float fadeIn = isFading ? juce::jmin(1.f, (float)(mTypeFade.position + 1) / (float)mTypeFade.length) : 1.f;
+
+        /** write into Circular buffer */
+        const int writeHead = delayLine.getWriteHead();
+        for (int channel = 0; channel < mNumChannels; channel++){
+            delayLine.setSample(channel, writeHead, channels[channel][i] + path.feedbackState[channel]);
+        }
+
+
+        /** generate each channel's LFO output, the phase offset is spread across the channels */
+        const float phaseOffset = mSmoothers.getNextValue(ParameterSmoothers::kPhaseOffset);
+
+        for (int channel = 0; channel < mNumChannels; channel++){
+            float lfoPhase = mLFOPhase + phaseOffset * getChannelPhaseSpread(channel);
+            if (lfoPhase >1){
+                lfoPhase -= 1;
+            }
+            lfoOut[channel] = sin(2*M_PI * lfoPhase);
+        }
+
+        /** moving LFO phase forward, a synced phase follows the timeline position */
+        const float rate = mSmoothers.getNextValue(ParameterSmoothers::kRate);
+
+        if (tempoSync){
+            mTempoSync.advance(positionStep);
+            mLFOPhase = (float)mTempoSync.getPhase(mSnapshot.noteValue);
+        } else {
+            mLFOPhase += rate / mSampleRate;
+            if (mLFOPhase >1){
+                mLFOPhase -= 1;
+            }
+            mTempoSync.advance(positionStep);
+        }
+
+        /** calculate the LFO depth */
+        const float depth = mSmoothers.getNextValue(ParameterSmoothers::kDepth);
+
+        for (int channel = 0; channel < mNumChannels; channel++){
+            /** map our LFO output to our desired delay times */
+            const float lfoOutMapped = juce::jmap(lfoOut[channel] * depth, -1.f, 1.f, minDelayTime, maxDelayTime);
+
+            /** calculate the delay length in samples */
+            float delayTimeInSample = mSampleRate * lfoOutMapped;
+
+            /** calculate the read head position */
+            float delayReadHead = writeHead - delayTimeInSample;
+            if (delayReadHead < 0){
+                delayReadHead += delayLine.getLength();
+            }
+
+            /** calculate linear interpolation points */
+            int readHead_x = (int)delayReadHead;
+            int readHead_x1 = readHead_x + 1;
+            float readHeadFloat = delayReadHead - readHead_x;
+
+            readHead_x1 &= delayLine.getMask();
+
+            /** generate the output sample, a linear interpolation in the path's precision */
+            const SampleType phase = readHeadFloat;
+            delayedSample[channel] = (1 - phase) * delayLine.getSample(channel, readHead_x) + phase * delayLine.getSample(channel, readHead_x1);
+
+            /** the old Type reads at the same delay moved across to its own range. The delay is taken
+                back from the read head, as the block pipeline has to, so the two round alike */
+            if (isFading){
+                float delay = writeHead - delayReadHead;
+                if (delay < 0){
+                    delay += delayLine.getLength();
+                }
+
+                float fadingReadHead = writeHead - (delay * mTypeFade.delayScale + mTypeFade.delayOffset);
+                if (fadingReadHead < 0){
+                    fadingReadHead += delayLine.getLength();
+                }
+
+                const int fadingHead_x = (int)fadingReadHead;
+                const float fadingPhase = fadingReadHead - fadingHead_x;
+                const SampleType x0 = delayLine.getSample(channel, fadingHead_x & delayLine.getMask());
+                const SampleType x1 = delayLine.getSample(channel, (fadingHead_x + 1) & delayLine.getMask());
+                const SampleType fadingOut = x0 + fadingPhase * (x1 - x0);
+
+                delayedSample[channel] = fadingOut + (delayedSample[channel] - fadingOut) * fadeIn;
+            }
+        }
+
+        if (isFading && ++mTypeFade.position >= mTypeFade.length){
+            mTypeFade.length = 0;
+        }
+
+        /** write into feedback buffer*/
+        const float feedbackAmount = mSmoothers.getNextValue(ParameterSmoothers::kFeedback);
+        for (int channel = 0; channel < mNumChannels; channel++){
+            path.feedbackState[channel] = delayedSample[channel] * feedbackAmount;
+        }
+
+
+        delayLine.advance(1);
+
+        float wetAmount = mSmoothers.getNextValue(ParameterSmoothers::kDryWet);
+        float dryAmount =1 - wetAmount;
+
+        for (int channel = 0; channel < mNumChannels; channel++){
+            channels[channel][i] = channels[channel][i] * dryAmount + delayedSample[channel] * wetAmount;
+        }
+    }
+}
+
+float ChorusFlangerEngine::getChannelPhaseSpread (int channel) const
+{
+    /** with two channels this is 0 and 1, the original left/right offset */
+    return mNumChannels > 1 ? (float)channel / (float)(mNumChannels - 1) : 0.f;
+}
+
+void ChorusFlangerEngine::computeModulation (int numSamples)
+{
+    const double sampleRate = mProcessingSampleRate;
+
+    float* depth = mBlockScratch.getWritePointer(kDepth);
+    float* rate = mBlockScratch.getWritePointer(kRate);
+    float* phaseOffset = mBlockScratch.getWritePointer(kPhaseOffset);
+
+    /** the first channel runs at the base phase and is where the other channels are spread from */
+    float* basePhase = getModulationArray(0);
+
+
+    /** stage 1: run the smoothers as arrays, then the phase accumulator over them, storing the LFO phases */
+    mSmoothers.fillRamp(ParameterSmoothers::kPhaseOffset, phaseOffset, numSamples);
+    mSmoothers.fillRamp(ParameterSmoothers::kRate, rate, numSamples);
+    mSmoothers.fillRamp(ParameterSmoothers::kDepth, depth, numSamples);
+
+    if (mSnapshot.tempoSync != 0){
+        mTempoSync.fillPhases(mSnapshot.noteValue, basePhase, numSamples);
+
+        /** the free-running phase carries on from here if sync is switched off */
+        mLFOPhase = (float)mTempoSync.getPhase(mSnapshot.noteValue);
+    } else {
+        for (int i = 0; i < numSamples; i++){
+            basePhase[i] = mLFOPhase;
+
+            mLFOPhase += rate[i] / sampleRate;
+            if (mLFOPhase >1){
+                mLFOPhase -= 1;
+            }
+        }
+
+        mTempoSync.advance(numSamples);
+    }
+
+    for (int channel = 1; channel < mNumChannels; channel++){
+        float* lfoPhase = getModulationArray(channel);
+        const float spread = mSetup.channelSpreads[channel];
+
+        for (int i = 0; i < numSamples; i++){
+            float phase = basePhase[i] + phaseOffset[i] * spread;
+            if (phase >1){
+                phase -= 1;
+            }
+            lfoPhase[i] = phase;
+        }
+    }
+
+
+    if (mSnapshot.voices != mNumVoices){
+        setNumVoices(mSnapshot.voices);
+    }
+
+
+    /** stage 2: turn the phases into LFO outputs scaled by depth. Extra voices trail their channel's
+        phase by equal fractions of a cycle. For the sine, a voice is then a fixed rotation of the
+        channel's sine and cosine, so it costs two multiplies instead of an LFO of its own */
+    const auto waveform = (LFO::Waveform)mSnapshot.waveform;
+    const bool rotateVoices = (waveform == LFO::kSine);
+
+    for (int channel = 0; channel < mNumChannels; channel++){
+        float* lfo = getModulationArray(channel);
+
+        for (int voice = 1; voice < mNumVoices; voice++){
+            /** the cosine is the sine a quarter cycle ahead, only one is needed per channel */
+            if (rotateVoices && voice > 1){
+                break;
+            }
+
+            const float voiceOffset = rotateVoices ? 0.25f : (float)voice / (float)mNumVoices;
+            float* voicePhase = rotateVoices ? getVoiceArray() : getModulationArray(channel, voice);
+
+            for (int i = 0; i < numSamples; i++){
+                float phase = lfo[i] + voiceOffset;
+                if (phase >1){
+                    phase -= 1;
+                }
+                voicePhase[i] = phase;
+            }
+
+            mLFOs[channel][voice].setWaveform(waveform);
+            mLFOs[channel][voice].process(voicePhase, voicePhase, numSamples);
+        }
+
+        mLFOs[channel][0].setWaveform(waveform);
+        mLFOs[channel][0].process(lfo, lfo, numSamples);
+
+        for (int voice = 1; voice < mNumVoices; voice++){
+            float* voiceLFO = getModulationArray(channel, voice);
+
+            if (rotateVoices){
+                const float sineGain = mVoiceSineGains[voice];
+                const float cosineGain = mVoiceCosineGains[voice];
+                const float* cosine = getVoiceArray();
+
+                for (int i = 0; i < numSamples; i++){
+                    voiceLFO[i] = (lfo[i] * sineGain + cosine[i] * cosineGain) * depth[i];
+                }
+            }
+            else {
+                juce::FloatVectorOperations::multiply(voiceLFO, depth, numSamples);
+                juce::FloatVectorOperations::multiply(voiceLFO, kVoiceDepths[voice], numSamples);
+            }
+        }
+
+        juce::FloatVectorOperations::multiply(lfo, depth, numSamples);
+    }
+}
+
+void ChorusFlangerEngine::traceModulation (int numSamples, float minDelayTime, float maxDelayTime)
+{
+    const int interval = juce::jmax(1, (int)(mProcessingSampleRate / ModulationTrace::kPointsPerSecond));
+    const float* first = getModulationArray(0);
+    const float* last = getModulationArray(mNumChannels - 1);
+
+    int i = juce::jmin(mTraceCountdown, interval - 1);
+
+    for (; i < numSamples; i += interval){
+        ModulationTrace::Point point;
+        point.delayMs[0] = 1000.f * juce::jmap(first[i], -1.f, 1.f, minDelayTime, maxDelayTime);
+        point.delayMs[1] = 1000.f * juce::jmap(last[i], -1.f, 1.f, minDelayTime, maxDelayTime);
+        mModulationTrace->push(point);
+    }
+
+    mTraceCountdown = i - numSamples;
+}
+
+void ChorusFlangerEngine::setNumVoices (int numVoices)
+{
+    mNumVoices = juce::jlimit(1, (int)DelayLineReader::kMaxVoices, numVoices);
+
+    /** voices are spread evenly from the first channel's side to the last channel's side. Each
+        channel hears a voice by how close their positions are, then the gains are normalised so
+        a channel's voices always add up to the level, and feedback, of a single voice */
+    for (int channel = 0; channel < DelayLine::kMaxChannels; channel++){
+        const float channelPosition = mNumChannels > 1 ? -1.f + 2.f * channel / (mNumChannels - 1) : 0.f;
+        float sum = 0;
+
+        for (int voice = 0; voice < mNumVoices; voice++){
+            const float voicePosition = mNumVoices > 1 ? -1.f + 2.f * voice / (mNumVoices - 1) : 0.f;
+            mVoiceGains[channel][voice] = std::cos(std::abs(voicePosition - channelPosition) * juce::MathConstants<float>::pi / 4);
+            sum += mVoiceGains[channel][voice];
+        }
+
+        for (int voice = 0; voice < mNumVoices; voice++){
+            mVoiceGains[channel][voice] /= sum;
+        }
+    }
+
+    /** voice v of the sine trails its channel by v / mNumVoices of a cycle */
+    for (int voice = 0; voice < mNumVoices; voice++){
+        const float angle = juce::MathConstants<float>::twoPi * voice / mNumVoices;
+        mVoiceSineGains[voice] = std::cos(angle) * kVoiceDepths[voice];
+        mVoiceCosineGains[voice] = std::sin(angle) * kVoiceDepths[voice];
+    }
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::processSubBlock (SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples)
+{
+    float* feedbackAmounts = mBlockScratch.getWritePointer(kFeedback);
+    float* wetAmounts = mBlockScratch.getWritePointer(kDryWet);
+
+    /** stages 1 and 2: LFO outputs for the sub-block */
+    computeModulation(numSamples);
+
+    mSmoothers.fillRamp(ParameterSmoothers::kFeedback, feedbackAmounts, numSamples);
+    const bool wetIsRamping = mSmoothers.fillRamp(ParameterSmoothers::kDryWet, wetAmounts, numSamples);
+
+    if (mModulationTrace != nullptr && mModulationTrace->isActive()){
+        traceModulation(numSamples, mSetup.minDelayTime, mSetup.maxDelayTime);
+    }
+
+    /** stages 3 and 4: the kernel for the channel count and interpolation, picked when they last changed */
+    (this->*getKernel((SampleType*)nullptr))(path, channels, startSample, numSamples);
+
+
+    /** stage 5: dry/wet mix, per sample only while the mix is ramping. Like the feedback write in stage 4,
+        it runs one channel at a time and is vectorised along the samples, not across the channels, so
+        4 or 8 channels do not share a register. Each channel's samples are contiguous in the host's
+        buffers and in path.delayed, and a sub-block is far longer than a register */
+    const auto& kernels = DspKernels::get<SampleType>();
+
+    for (int channel = 0; channel < mNumChannels; channel++){
+        SampleType* output = channels[channel] + startSample;
+        const SampleType* delayed = path.delayed.getReadPointer(channel);
+
+        if (wetIsRamping){
+            kernels.mixRamp(output, delayed, wetAmounts, numSamples);
+        }
+        else {
+            kernels.mixConstant(output, delayed, (SampleType)(1 - wetAmounts[0]), (SampleType)wetAmounts[0], numSamples);
+        }
+    }
+}
+
+template <typename SampleType, int NumChannels, int Interpolation>
+void ChorusFlangerEngine::processKernel (SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples)
+{
+    const double sampleRate = mProcessingSampleRate;
+    auto& delayLine = path.delayLine;
+    const int numChannels = NumChannels > 0 ? NumChannels : mNumChannels;
+
+    const float* feedbackAmounts = mBlockScratch.getReadPointer(kFeedback);
+
+    /** stage 3: map the LFO outputs to delay times, then to read positions, in place */
+    const float minDelayTime = mSetup.minDelayTime;
+    const float maxDelayTime = mSetup.maxDelayTime;
+
+    for (int channel = 0; channel < numChannels; channel++){
+        float* modulation = getModulationArray(channel);
+
+        for (int i = 0; i < numSamples; i++){
+            const int writeHead = (delayLine.getWriteHead() + i) & delayLine.getMask();
+
+            float delayTimeInSample = sampleRate * juce::jmap(modulation[i], -1.f, 1.f, minDelayTime, maxDelayTime);
+
+            float delayReadHead = writeHead - delayTimeInSample;
+            if (delayReadHead < 0){
+                delayReadHead += delayLine.getLength();
+            }
+
+            modulation[i] = delayReadHead;
+        }
+    }
+
+    /** extra voices map in single precision, from write positions shared by every voice */
+    if (mNumVoices > 1){
+        float* writePositions = getVoiceArray();
+
+        for (int i = 0; i < numSamples; i++){
+            writePositions[i] = (float)((delayLine.getWriteHead() + i) & delayLine.getMask());
+        }
+
+        const float centreDelay = (float)(sampleRate * 0.5 * (minDelayTime + maxDelayTime));
+        const float halfRange = (float)(sampleRate * 0.5 * (maxDelayTime - minDelayTime));
+        const float length = (float)delayLine.getLength();
+
+        for (int voice = 1; voice < mNumVoices; voice++){
+            for (int channel = 0; channel < numChannels; channel++){
+                float* modulation = getModulationArray(channel, voice);
+
+                for (int i = 0; i < numSamples; i++){
+                    const float delayReadHead = writePositions[i] - (centreDelay + halfRange * modulation[i]);
+                    modulation[i] = delayReadHead < 0 ? delayReadHead + length : delayReadHead;
+                }
+            }
+        }
+    }
+
+
+    /** stage 4: gather, interpolate and feed back in chunks shorter than the minimum delay.
+        Every read in a chunk then lands on samples written before the chunk started, so all
+        reads can be done first and all writes after, without changing the result. Interpolators
+        reading further ahead than linear need correspondingly shorter chunks, and so does the
+        old Type while it fades out */
+    path.reader.setMode((typename BasicDelayLineReader<SampleType>::Mode)Interpolation);
+
+    const bool isFading = (mTypeFade.length > 0);
+    const int chunkSize = isFading ? juce::jmin(mSetup.chunkSize, mTypeFade.chunkSize) : mSetup.chunkSize;
+
+    for (int start = 0; start < numSamples; start += chunkSize){
+        const int chunkLength = juce::jmin(chunkSize, numSamples - start);
+
+        for (int channel = 0; channel < numChannels; channel++){
+            SampleType* delayed = path.delayed.getWritePointer(channel) + start;
+            path.reader.template readWithMode<Interpolation>(delayLine, channel, getModulationArray(channel) + start, delayed, chunkLength);
+
+            /** further voices read the same delay line and are mixed in with their pan gains */
+            if (mNumVoices > 1){
+                juce::FloatVectorOperations::multiply(delayed, (SampleType)mVoiceGains[channel][0], chunkLength);
+
+                for (int voice = 1; voice < mNumVoices; voice++){
+                    path.reader.template readAndAddWithMode<Interpolation>(delayLine, channel, getModulationArray(channel, voice) + start,
+                                                                          (SampleType)mVoiceGains[channel][voice], delayed, chunkLength, voice);
+                }
+            }
+
+            if (isFading){
+                fadeOutPreviousType(delayLine, channel, start, delayed, chunkLength);
+            }
+        }
+
+        for (int channel = 0; channel < numChannels; channel++){
+            writeWithFeedback(delayLine, channel, channels[channel] + startSample + start, path.delayed.getReadPointer(channel) + start,
+                              path.feedbackState[channel], feedbackAmounts + start, chunkLength);
+        }
+
+        delayLine.advance(chunkLength);
+    }
+
+    if (isFading){
+        mTypeFade.position += numSamples;
+
+        if (mTypeFade.position >= mTypeFade.length){
+            mTypeFade.length = 0;
+        }
+    }
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::fadeOutPreviousType (const BasicDelayLine<SampleType>& delayLine, int channel, int start, SampleType* delayed, int numSamples)
+{
+    const SampleType* circularBuffer = delayLine.getData() + channel;
+    const int mask = delayLine.getMask();
+    const int stride = delayLine.getNumChannels();
+    const int writeHead = delayLine.getWriteHead();
+    const float length = (float)delayLine.getLength();
+
+    for (int i = 0; i < numSamples; i++){
+        const float writePosition = (float)((writeHead + i) & mask);
+        SampleType fadingOut = 0;
+
+        for (int voice = 0; voice < mNumVoices; voice++){
+            /** the delay the new Type reads at, moved across to the old Type's range */
+            float delay = writePosition - getModulationArray(channel, voice)[start + i];
+            delay += (delay < 0 ? length : 0.f);
+
+            float position = writePosition - (delay * mTypeFade.delayScale + mTypeFade.delayOffset);
+            position += (position < 0 ? length : 0.f);
+
+            const int index = (int)position;
+            const float fraction = position - index;
+            const SampleType x0 = circularBuffer[(index & mask) * stride];
+            const SampleType x1 = circularBuffer[((index + 1) & mask) * stride];
+            const SampleType gain = mNumVoices > 1 ? (SampleType)mVoiceGains[channel][voice] : (SampleType)1;
+
+            fadingOut += gain * (x0 + fraction * (x1 - x0));
+        }
+
+        const float fadeIn = juce::jmin(1.f, (float)(mTypeFade.position + start + i + 1) / (float)mTypeFade.length);
+        delayed[i] = fadingOut + (delayed[i] - fadingOut) * fadeIn;
+    }
+}
+
+//==============================================================================
+template <typename SampleType, int NumChannels>
+const ChorusFlangerEngine::Kernel<SampleType> ChorusFlangerEngine::KernelRow<SampleType, NumChannels>::kernels[DelayLineReader::kNumModes] =
+{
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kLinear>,
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kHermite>,
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kLagrange3>,
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kLagrange5>,
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kThiran>,
+    &ChorusFlangerEngine::processKernel<SampleType, NumChannels, DelayLineReader::kSinc>
+};
+
+template <typename SampleType>
+ChorusFlangerEngine::Kernel<SampleType> ChorusFlangerEngine::findKernel (int numChannels, int interpolation)
+{
+    /** mono, stereo, then every other channel count */
+    static const Kernel<SampleType>* const kernels[3] =
+    {
+        KernelRow<SampleType, 1>::kernels, KernelRow<SampleType, 2>::kernels, KernelRow<SampleType, 0>::kernels
+    };
+
+    const int channelLayout = numChannels == 1 ? 0 : (numChannels == 2 ? 1 : 2);
+
+    return kernels[channelLayout][juce::jlimit(0, DelayLineReader::kNumModes - 1, interpolation)];
+}
+
+template <typename SampleType>
+void ChorusFlangerEngine::writeWithFeedback (BasicDelayLine<SampleType>& delayLine, int channel, const SampleType* input, const SampleType* delayed,
+                                             SampleType& feedbackState, const float* feedbackAmounts, int numSamples)
+{
+    DspKernels::get<SampleType>().writeWithFeedback(delayLine.getData() + channel, delayLine.getMask(), delayLine.getNumChannels(), delayLine.getWriteHead(),
+                                                    input, delayed, feedbackState, feedbackAmounts, numSamples);
+}
+
+//==============================================================================
+template bool ChorusFlangerEngine::startBlock<float> (const float* const*, int, int);
+template bool ChorusFlangerEngine::startBlock<double> (const double* const*, int, int);
+template void ChorusFlangerEngine::processSegment<float> (float* const*, int, int);
+template void ChorusFlangerEngine::processSegment<double> (double* const*, int, int);
@@ -0,0 +1,435 @@
+/*
+  ==============================================================================
+
+    ChorusFlangerEngine.h
+    Created: 18 Oct 2026 2:26:53am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "LFO.h"
+#include "DelayLine.h"
+#include "DelayLineReader.h"
+#include "Oversampler.h"
+#include "Parameters.h"
+#include "TempoSync.h"
+
+/** optional observers, only held by pointer, so an embedder that never sets them needs neither header */
+class Instrumentation;
+class ModulationTrace;
+
+/** delay ranges swept by the LFO in each mode, in seconds */
+#define CHORUS_MIN_DELAY_TIME 0.005f
+#define CHORUS_MAX_DELAY_TIME 0.03f
+#define FLANGER_MIN_DELAY_TIME 0.001f
+#define FLANGER_MAX_DELAY_TIME 0.005f
+
+/** the delay line only has to reach the longest delay either mode can ask for */
+#define MAX_DELAY_TIME CHORUS_MAX_DELAY_TIME
+
+//==============================================================================
+/**
+    The chorus/flanger DSP on its own: the delay line, the LFOs, the feedback and
+    the oversampling, driven by a ParameterSnapshot.
+
+    It needs juce_core and juce_audio_basics and nothing from the GUI or plugin
+    modules, so it builds as the KPChorusFlangerEngine static library and runs
+    without a host. The plugin's processor is an adapter around one engine that
+    adds the parameters, presets, state and MIDI controllers.
+
+        ChorusFlangerEngine engine;
+        engine.setParameters(snapshot);
+        engine.prepare(48000.0, 512, 2);
+        engine.process(input, output, numSamples);
+
+    prepare() and releaseMemory() allocate, everything else is real-time safe. The
+    memory covers the prepared rate at every oversampling factor unless
+    setMemoryReservation() asks for less. At 48 kHz stereo in blocks of 512 an
+    engine takes about 1 MB with every factor and about 100 kB limited to 1x, see
+    the benchmark's engine command.
+*/
+class ChorusFlangerEngine
+{
+public:
+
+    /** the modes of the Type parameter, each sweeps its own delay range */
+    enum Type
+    {
+        kChorus = 0,
+        kFlanger,
+        kNumTypes
+    };
+
+    ChorusFlangerEngine();
+
+    /** allocate for numChannels and calls of up to maximumBlockSize samples at sampleRate, longer calls
+        are processed in pieces. Memory from an earlier prepare is reused when it is large enough.
+        The ramps start at the parameters last given to setParameters() */
+    void prepare(double sampleRate, int maximumBlockSize, int numChannels, bool useDoublePrecision = false);
+
+    /** the channels every call processes, as prepared, at most DelayLine::kMaxChannels */
+    int getNumChannels() const                          { return mNumChannels; }
+
+    /** the highest sample rate and oversampling factor index that prepare() reserves memory for, so a
+        later prepare up to that rate reuses it. Oversampling is limited to the reserved factor, which
+        never allocates. By default the prepared rate at Oversampler::kMaxFactorIndex */
+    void setMemoryReservation(double maxSampleRate, int maxOversamplingIndex);
+
+    /** hand all memory back, prepare allocates it again */
+    void releaseMemory();
+
+    /** silence the delay line, filters and feedback, restart the LFOs and jump to the current parameters */
+    void reset();
+
+    //==============================================================================
+    /** the parameters for the following samples. Continuous values ramp from where they are, a new
+        oversampling factor restarts the delay line from silence, so it is held back until the next
+        prepare() or reset(), or until the input has been silent past the tail. The snapshot's
+        oversampling setting is used as it is, so callers choose between the live and offline settings.
+        A new Waveform, Interpolation, Voices or tempo sync would jump the wet signal, so the wet signal
+        ramps to silence over the dry/wet ramp time first, the values switch, and it ramps back */
+    void setParameters(const ParameterSnapshot& snapshot);
+    const ParameterSnapshot& getParameters() const      { return mRequested; }
+
+    /** read the host's timeline for a tempo-synced LFO at the start of a block, playHead may be nullptr */
+    void updateTimeline(juce::AudioPlayHead* playHead);
+
+    //==============================================================================
+    /** process numSamples of every channel from input to output, which may be the same buffers.
+        The precision must be the one prepared for */
+    void process(const float* const* input, float* const* output, int numSamples);
+    void process(const double* const* input, double* const* output, int numSamples);
+
+    /** the same call in three steps, for hosts that change parameters inside a block. startBlock() looks
+        at the whole block's input and returns false when it is silent past the tail and can be skipped.
+        Either way processSegment() runs each stretch in place, with setParameters() between them, only
+        moving the modulation on through a skipped block, and finishBlock() ends the block */
+    template <typename SampleType>
+    bool startBlock(const SampleType* const* input, int numInputChannels, int numSamples);
+
+    template <typename SampleType>
+    void processSegment(SampleType* const* channels, int startSample, int numSamples);
+
+    void finishBlock();
+
+    /** run the LFO, smoothers and write head forward by numSamples without writing audio, as if that
+        many samples had been processed in calls of the prepared size */
+    void advanceModulation(juce::int64 numSamples);
+
+    //==============================================================================
+    /** latency of the oversampling filters at the prepared rate, for the factor running now */
+    int getLatencySamples() const;
+
+    /** how long the output can keep sounding after the input stops, for a set of parameters. Each trip
+        round the feedback loop takes at most the longest delay the depth reaches and scales by the
+        feedback, so the tail ends after enough trips to fall below kTailLevel, plus the latency */
+    double getTailLengthSeconds(const ParameterSnapshot& snapshot) const;
+
+    /** the feedback tail is counted until it falls below this level, -120 dB */
+    static constexpr float kTailLevel = 1.0e-6f;
+
+    /** the delay range the LFO sweeps for a Type, Chorus or Flanger, in seconds */
+    static void getDelayRange(int type, float& minDelayTime, float& maxDelayTime);
+
+    /** the delay range a snapshot sweeps: a morphed one if it has one, otherwise its Type's */
+    static void getDelayRange(const ParameterSnapshot& snapshot, float& minDelayTime, float& maxDelayTime);
+
+    /** how long a new Type takes to fade in while the old one fades out */
+    static constexpr double kTypeFadeMs = 20.0;
+
+    /** blocks started since construction, and how many of them were skipped because the input had
+        been digital silence for longer than the tail. Safe to read from any thread */
+    juce::int64 getNumBlocks() const            { return mNumBlocks; }
+    juce::int64 getNumSkippedBlocks() const     { return mNumSkippedBlocks; }
+
+    /** true while the input is silent and the tail has decayed, so blocks are skipped */
+    bool isIdle() const                         { return mIsIdle; }
+
+    //==============================================================================
+    /** select the original sample-by-sample loop, kept as the reference for the staged block pipeline.
+        It always runs at 1x */
+    void setUseReferenceProcessing(bool shouldUseReference);
+    bool isUsingReferenceProcessing() const     { return mUseReferenceProcessing; }
+
+    /** choose the LFO implementation used by the block pipeline, see LFO::createBackendReport() */
+    void setLFOBackend(LFO::Backend newBackend);
+    LFO::Backend getLFOBackend() const          { return mLFOs[0][0].getBackend(); }
+
+    /** optional receivers for the denormal flush count and the swept delay times, nullptr for none */
+    void setInstrumentation(Instrumentation* instrumentation)   { mInstrumentation = instrumentation; }
+    void setModulationTrace(ModulationTrace* trace)             { mModulationTrace = trace; }
+
+private:
+
+    /** the audio state of one precision: the delay line and everything that filters or reads it.
+        Only the precision the engine was prepared for holds memory */
+    template <typename SampleType>
+    struct SignalPath
+    {
+        /** Circular Buffer Data */
+        BasicDelayLine<SampleType> delayLine;
+
+        /** fractional-delay reads for the block pipeline, the reference path always reads linearly */
+        BasicDelayLineReader<SampleType> reader;
+
+        /** Oversampling Data, the block pipeline runs at mProcessingSampleRate in sub-blocks of up to
+            mMaxBlockSize samples at the base rate */
+        BasicOversampler<SampleType> oversampler;
+
+        /** interpolated delay line output, one row per channel with all voices mixed */
+        juce::AudioBuffer<SampleType> delayed;
+
+        /** per-channel state, indexed by channel */
+        SampleType feedbackState[DelayLine::kMaxChannels] = {};
+
+        /** silence the delay line, the filters and the feedback */
+        void clear();
+
+        void releaseMemory();
+    };
+
+    /** call function with the signal path of the prepared precision */
+    template <typename Function>
+    void withSignalPath(Function&& function)
+    {
+        if (mUseDoublePrecision){
+            function(mDoublePath);
+        } else {
+            function(mFloatPath);
+        }
+    }
+
+    SignalPath<float>& getSignalPath(float*)        { return mFloatPath; }
+    SignalPath<double>& getSignalPath(double*)      { return mDoublePath; }
+
+    template <typename SampleType>
+    void processTemplate(const SampleType* const* input, SampleType* const* output, int numSamples);
+
+    /** the original per-sample implementation, kept as the reference for the block pipeline */
+    template <typename SampleType>
+    void processBlockReference(SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples);
+
+    /** the oversampling factor index the snapshot asks for, within the reserved memory. The reference
+        path always runs at the base rate */
+    int getOversamplingIndex(const ParameterSnapshot& snapshot) const;
+
+    /** switch the delay/feedback core to another oversampling factor without allocating. The delay
+        line holds samples at the old rate, so it restarts from silence */
+    void setOversampling(int factorIndex);
+
+    /** whether the parameters ask for another factor than the one running, and switching to it. A
+        switch waits for prepare(), reset() or a block skipped as idle, when the delay line is silent */
+    bool hasPendingOversampling() const;
+    void applyPendingOversampling();
+
+    /** set how many voices each channel reads and lay out their pans, does not allocate */
+    void setNumVoices(int numVoices);
+
+    /** restart every LFO and the timeline position */
+    void resetModulation();
+
+    /** work out mSetup again for the current snapshot, channel count and processing rate */
+    void updateBlockSetup();
+
+    /** staged block pipeline: LFO, delay times and read positions are computed as arrays for
+        the whole sub-block, then gathers, interpolation, feedback and mix run over them */
+    template <typename SampleType>
+    void processSubBlock(SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples);
+
+    /** stages 1 and 2 of the block pipeline: smoothers, phases and depth-scaled LFO outputs */
+    void computeModulation(int numSamples);
+
+    /** stages 3 and 4 for one channel count and interpolator. The delay range comes from the block
+        setup, so a morph can move it between the Types' ranges. The channel loop has a fixed count for
+        mono and stereo, NumChannels 0 taking any other, and the reads call the interpolator directly */
+    template <typename SampleType, int NumChannels, int Interpolation>
+    void processKernel(SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples);
+
+    template <typename SampleType>
+    using Kernel = void (ChorusFlangerEngine::*)(SignalPath<SampleType>&, SampleType* const*, int, int);
+
+    /** the kernels of one channel count, one per interpolator in DelayLineReader::Mode order */
+    template <typename SampleType, int NumChannels>
+    struct KernelRow
+    {
+        static const Kernel<SampleType> kernels[DelayLineReader::kNumModes];
+    };
+
+    /** look a kernel up in the table of every channel count and interpolator */
+    template <typename SampleType>
+    static Kernel<SampleType> findKernel(int numChannels, int interpolation);
+
+    /** whether b differs from a in a value that switches instead of ramping, apart from the Type,
+        which fades */
+    static bool hasDiscreteChange(const ParameterSnapshot& a, const ParameterSnapshot& b);
+
+    /** count a waiting discrete switch down by numSamples at the base rate, and make it once the wet
+        signal is silent. The caller splits its work so the count never goes past 0 */
+    void advanceDiscreteSwitch(int numSamples);
+
+    /** take a snapshot as the running values, aiming the ramps at it */
+    void applyParameters(const ParameterSnapshot& snapshot);
+
+    /** the block pipeline, and the modulation without it, for stretches without a discrete switch */
+    template <typename SampleType>
+    void processSubBlocks(SignalPath<SampleType>& path, SampleType* const* channels, int startSample, int numSamples);
+    void advanceSubBlocks(juce::int64 numSamples);
+
+    /** start fading from the delay range of previous to the snapshot's, from the current sample on */
+    void startTypeFade(const ParameterSnapshot& previous);
+
+    /** during a Type fade, read the old Type's delay for every voice of one chunk and crossfade delayed
+        from it. The old Type's read positions are the new ones mapped across to its range, read linearly */
+    template <typename SampleType>
+    void fadeOutPreviousType(const BasicDelayLine<SampleType>& delayLine, int channel, int start, SampleType* delayed, int numSamples);
+
+    /** push the delay times of the LFO outputs to the trace, every so many samples */
+    void traceModulation(int numSamples, float minDelayTime, float maxDelayTime);
+
+    /** write input plus feedback into one channel of the delay line, starting at the write head */
+    template <typename SampleType>
+    static void writeWithFeedback(BasicDelayLine<SampleType>& delayLine, int channel, const SampleType* input, const SampleType* delayed,
+                                  SampleType& feedbackState, const float* feedbackAmounts, int numSamples);
+
+    /** how far channel's LFO phase trails the first channel, as a fraction of the Phase Offset parameter.
+        The offset is spread evenly from 0 on the first channel to the full amount on the last */
+    float getChannelPhaseSpread(int channel) const;
+
+    /** set feedback values that have decayed into the subnormal range to zero, where the CPU's
+        flush-to-zero mode has not already done it, and count them */
+    template <typename SampleType>
+    void flushDenormals(SignalPath<SampleType>& path);
+
+    /** count silent input and enter or leave the idle state, returns true if this block can be skipped.
+        Entering clears the decayed tail from the delay line and filters, so waking starts from silence */
+    template <typename SampleType>
+    bool updateIdleState(SignalPath<SampleType>& path, const SampleType* const* input, int numInputChannels, int numSamples);
+
+    /** the values the current block was started with, and the ramps towards them */
+    ParameterSnapshot mSnapshot;
+    ParameterSmoothers mSmoothers;
+
+    /** Discrete Switch Data, the snapshot last given to setParameters(). While mSnapshot still has
+        other discrete values, the wet signal ramps to silence for mSwitchCountdown more samples at
+        the base rate, then mSnapshot takes them */
+    ParameterSnapshot mRequested;
+    int mSwitchCountdown;
+
+    /** Block Setup Data, what every call needs that only changes with the snapshot, the channel count
+        or the processing rate. It is worked out when one of them changes, so a call of a few samples
+        reads a handful of values instead of repeating the setup */
+    struct BlockSetup
+    {
+        /** the tail at the base rate, see getTailLengthSeconds() */
+        juce::int64 tailSamples = 0;
+
+        /** the delay range in seconds, the Type's or a morphed one, and the longest stage 4 chunk the
+            interpolation allows */
+        float minDelayTime = CHORUS_MIN_DELAY_TIME;
+        float maxDelayTime = CHORUS_MAX_DELAY_TIME;
+        int chunkSize = 1;
+
+        /** each channel's share of the Phase Offset, see getChannelPhaseSpread() */
+        float channelSpreads[DelayLine::kMaxChannels] = {};
+
+        /** stages 3 and 4 for the channel count and interpolation, in each precision */
+        Kernel<float> floatKernel = nullptr;
+        Kernel<double> doubleKernel = nullptr;
+    };
+
+    BlockSetup mSetup;
+
+    Kernel<float> getKernel(float*) const       { return mSetup.floatKernel; }
+    Kernel<double> getKernel(double*) const     { return mSetup.doubleKernel; }
+
+    /** Type Fade Data, while a new Type fades in over length samples at the processing rate. The old
+        Type's delays are the new ones times delayScale plus delayOffset, and its reads need chunks of
+        at most chunkSize */
+    struct TypeFade
+    {
+        int position = 0;
+        int length = 0;
+        float delayScale = 1;
+        float delayOffset = 0;
+        int chunkSize = 1;
+    };
+
+    TypeFade mTypeFade;
+
+    /** Signal Path Data, mUseDoublePrecision is the precision of the last prepare */
+    SignalPath<float> mFloatPath;
+    SignalPath<double> mDoublePath;
+    bool mUseDoublePrecision;
+
+    /** Format Data, the base rate and the largest sub-block at that rate, both 0 until prepared */
+    double mSampleRate;
+    int mMaxBlockSize;
+    int mNumChannels;
+
+    /** Memory Data, the rate and oversampling factor index reserved for, 0 for the prepared rate */
+    double mReservedSampleRate;
+    int mMaxOversamplingIndex;
+
+    /** Oversampling Data, the factor index of the prepared path's oversampler and its factor */
+    int mOversamplingIndex;
+    int mOversamplingFactor;
+    double mProcessingSampleRate;
+
+    /** Silence Data, silent input samples and the longest tail in samples since the input went silent */
+    juce::int64 mNumSilentSamples;
+    juce::int64 mSilentTailSamples;
+    bool mSkippingBlock;
+    std::atomic<bool> mIsIdle;
+    std::atomic<juce::int64> mNumBlocks;
+    std::atomic<juce::int64> mNumSkippedBlocks;
+
+    Instrumentation* mInstrumentation;
+
+    /** LFO Display Data, samples at the processing rate until the next traced point */
+    ModulationTrace* mModulationTrace;
+    int mTraceCountdown;
+
+    /**LFO Data */
+    float mLFOPhase;
+
+    /** the timeline position a synced LFO takes its phase from */
+    TempoSync mTempoSync;
+
+    /** one LFO per channel and voice, voice 0 is the channel's own LFO */
+    LFO mLFOs[DelayLine::kMaxChannels][DelayLineReader::kMaxVoices];
+
+    /** Voice Data, every voice of a channel reads the channel's delay line with its own LFO phase and
+        depth, then the voices are panned across the channels. mVoiceGains of a channel sum to 1 */
+    int mNumVoices;
+    float mVoiceGains[DelayLine::kMaxChannels][DelayLineReader::kMaxVoices];
+
+    /** the sine LFO's voices as rotations of the channel's sine and cosine, the gain of each including the voice's depth */
+    float mVoiceSineGains[DelayLineReader::kMaxVoices];
+    float mVoiceCosineGains[DelayLineReader::kMaxVoices];
+
+    /** Block Pipeline Data, the shared ramps come first, then one modulation row per channel
+        and voice, and a row for one voice's reads. The delayed samples are in the signal path */
+    enum BlockScratchArrays
+    {
+        kDepth = 0,
+        kRate,
+        kPhaseOffset,
+        kDryWet,
+        kFeedback,
+        kNumSharedScratchArrays
+    };
+
+    /** LFO phases, then LFO outputs, then read positions of one channel and voice, rewritten in place stage by stage */
+    float* getModulationArray(int channel, int voice = 0)   { return mBlockScratch.getWritePointer(kNumSharedScratchArrays + voice * mNumChannels + channel); }
+
+    /** scratch for the voices, the channel's LFO cosine in stage 2, then the write positions in stage 3 */
+    float* getVoiceArray()                  { return mBlockScratch.getWritePointer(kNumSharedScratchArrays + DelayLineReader::kMaxVoices * mNumChannels); }
+
+    juce::AudioBuffer<float> mBlockScratch;
+    bool mUseReferenceProcessing;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusFlangerEngine)
+};
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    DelayLine.cpp
+    Created: 17 Oct 2026 11:40:27am
+
+  ==============================================================================
+*/
+
+#include "DelayLine.h"
+
+namespace
+{
+    constexpr size_t kCacheLineSize = 64;
+}
+
+//==============================================================================
+template <typename SampleType>
+BasicDelayLine<SampleType>::BasicDelayLine()
+{
+    mData = nullptr;
+    mCapacity = 0;
+    mNumChannels = 0;
+    mLength = 0;
+    mWriteHead = 0;
+    mNumFramesInUse = 0;
+}
+
+template <typename SampleType>
+void BasicDelayLine<SampleType>::reserve(double sampleRate, float maxDelayTimeInSeconds, int numChannels)
+{
+    jassert(numChannels > 0 && numChannels <= kMaxChannels);
+
+    const size_t numBytes = (size_t)getRequiredLength(sampleRate, maxDelayTimeInSeconds) * numChannels * sizeof(SampleType);
+
+    if (numBytes > mCapacity || mData == nullptr){
+        allocate(numBytes);
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLine<SampleType>::prepare(double sampleRate, float maxDelayTimeInSeconds, int numChannels)
+{
+    jassert(numChannels > 0 && numChannels <= kMaxChannels);
+
+    const int newLength = getRequiredLength(sampleRate, maxDelayTimeInSeconds);
+    const size_t numBytes = (size_t)newLength * numChannels * sizeof(SampleType);
+
+    if (numBytes > mCapacity || mData == nullptr){
+        allocate(numBytes);
+    }
+
+    /** in a new layout every frame may hold samples of the old one, so all of it is cleared */
+    if (newLength != mLength || numChannels != mNumChannels){
+        mLength = newLength;
+        mNumChannels = numChannels;
+        mNumFramesInUse = mLength;
+    }
+
+    clear();
+}
+
+template <typename SampleType>
+void BasicDelayLine<SampleType>::releaseMemory()
+{
+    mStorage.free();
+    mData = nullptr;
+    mCapacity = 0;
+    mLength = 0;
+    mWriteHead = 0;
+    mNumFramesInUse = 0;
+}
+
+template <typename SampleType>
+void BasicDelayLine<SampleType>::clear()
+{
+    /** a short render only dirties the start of the buffer, so only that part is cleared */
+    if (mData != nullptr){
+        juce::zeromem(mData, (size_t)mNumFramesInUse * mNumChannels * sizeof(SampleType));
+    }
+
+    mWriteHead = 0;
+    mNumFramesInUse = 0;
+}
+
+template <typename SampleType>
+int BasicDelayLine<SampleType>::getRequiredLength(double sampleRate, float maxDelayTimeInSeconds)
+{
+    /** the longest read reaches maxDelay frames back plus one more for the interpolation neighbour */
+    const int requiredFrames = (int)std::ceil(sampleRate * maxDelayTimeInSeconds) + kInterpolationGuard + 1;
+    return juce::nextPowerOfTwo(requiredFrames);
+}
+
+template <typename SampleType>
+void BasicDelayLine<SampleType>::allocate(size_t numBytes)
+{
+    /** over-allocate by one cache line so the data can start on a line boundary */
+    mStorage.malloc(numBytes + kCacheLineSize);
+
+    const auto address = reinterpret_cast<uintptr_t>(mStorage.get());
+    const auto alignedAddress = (address + kCacheLineSize - 1) & ~(uintptr_t)(kCacheLineSize - 1);
+    mData = reinterpret_cast<SampleType*>(alignedAddress);
+
+    mCapacity = numBytes;
+
+    /** the new storage holds no layout yet, so the next prepare clears all of it */
+    mLength = 0;
+}
+
+template class BasicDelayLine<float>;
+template class BasicDelayLine<double>;
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    DelayLine.h
+    Created: 17 Oct 2026 11:40:27am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Multichannel circular delay buffer for the chorus/flanger, holding float or
+    double samples.
+
+    The length is the longest delay the modes can ask for plus a few guard samples
+    for interpolation, rounded up to a power of two so wrapping is a bitmask. All
+    channels are interleaved frame by frame in one cache-line aligned allocation,
+    so the channels of one frame share a cache line.
+*/
+template <typename SampleType>
+class BasicDelayLine
+{
+public:
+
+    /** enough for a 7.1.4 bed with room to spare */
+    static constexpr int kMaxChannels = 16;
+
+    /** extra frames beyond the maximum delay, enough for interpolators reading a few taps ahead */
+    static constexpr int kInterpolationGuard = 4;
+
+    BasicDelayLine();
+
+    /** make sure the storage can hold the given maximum delay and channel count, allocating only if it
+        cannot already. Reserve for the largest format up front and later prepare calls never allocate */
+    void reserve(double sampleRate, float maxDelayTimeInSeconds, int numChannels);
+
+    /** size the buffer for the given maximum delay and channel count, clears it and resets the write head.
+        Only allocates when the buffer needs more room than it has, so a buffer reserved for its largest
+        size can be prepared again, even from the audio thread */
+    void prepare(double sampleRate, float maxDelayTimeInSeconds, int numChannels);
+
+    /** hand the storage back, prepare or reserve allocate it again */
+    void releaseMemory();
+
+    /** zero the frames written since the last clear and reset the write head */
+    void clear();
+
+    int getNumChannels() const  { return mNumChannels; }
+    int getLength() const       { return mLength; }
+    int getMask() const         { return mLength - 1; }
+    int getWriteHead() const    { return mWriteHead; }
+
+    /** move the write head forward after numFrames frames have been written */
+    void advance(int numFrames)
+    {
+        mWriteHead = (mWriteHead + numFrames) & (mLength - 1);
+        mNumFramesInUse = juce::jmin(mLength, mNumFramesInUse + numFrames);
+    }
+
+    /** sample index into getData() for a channel at a frame position, any int is wrapped */
+    int getIndex(int channel, int frame) const { return ((frame & (mLength - 1)) * mNumChannels) + channel; }
+
+    SampleType* getData()               { return mData; }
+    const SampleType* getData() const   { return mData; }
+
+    SampleType getSample(int channel, int frame) const          { return mData[getIndex(channel, frame)]; }
+    void setSample(int channel, int frame, SampleType value)    { mData[getIndex(channel, frame)] = value; }
+
+private:
+
+    juce::HeapBlock<char> mStorage;
+    size_t mCapacity;
+    SampleType* mData;
+
+    int mNumChannels;
+    int mLength;
+    int mWriteHead;
+
+    /** frames from 0 that may hold something other than zero, the write head starts at 0 after a clear */
+    int mNumFramesInUse;
+
+    static int getRequiredLength(double sampleRate, float maxDelayTimeInSeconds);
+    void allocate(size_t numBytes);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicDelayLine)
+};
+
+/** the plugin's own precision, and where the shared constants are read from */
+using DelayLine = BasicDelayLine<float>;
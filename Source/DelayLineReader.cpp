@@ -0,0 +1,375 @@
+/*
+  ==============================================================================
+
+    DelayLineReader.cpp
+    Created: 17 Oct 2026 8:40:17pm
+
+  ==============================================================================
+*/
+
+#include "DelayLineReader.h"
+#include "DspKernels.h"
+
+namespace
+{
+    constexpr int kSincTaps = 8;
+    constexpr int kSincPhases = 256;
+
+    /** the sinc taps run from 3 before to 4 after the integer position */
+    constexpr int kSincFirstTap = 1 - kSincTaps / 2;
+
+    /** one row of kSincTaps coefficients per fractional position, plus a last row for a fraction
+        of exactly 1, so that neighbouring rows can always be interpolated */
+    template <typename SampleType>
+    struct SincTable
+    {
+        SincTable()
+        {
+            const double halfWidth = kSincTaps / 2;
+
+            for (int row = 0; row <= kSincPhases; row++){
+                const double fraction = (double)row / kSincPhases;
+                double coefficients[kSincTaps];
+                double sum = 0;
+
+                for (int k = 0; k < kSincTaps; k++){
+                    const double x = (k + kSincFirstTap) - fraction;
+                    const double sinc = (x == 0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    const double window = 0.42 + 0.5 * std::cos(M_PI * x / halfWidth) + 0.08 * std::cos(2.0 * M_PI * x / halfWidth);
+
+                    coefficients[k] = sinc * window;
+                    sum += coefficients[k];
+                }
+
+                /** unity gain at DC, so a constant signal reads back unchanged */
+                for (int k = 0; k < kSincTaps; k++){
+                    table[row * kSincTaps + k] = (SampleType)(coefficients[k] / sum);
+                }
+            }
+        }
+
+        SampleType table[(kSincPhases + 1) * kSincTaps];
+    };
+
+    template <typename SampleType>
+    const SincTable<SampleType>& getSincTable()
+    {
+        static const SincTable<SampleType> sincTable;
+        return sincTable;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+BasicDelayLineReader<SampleType>::BasicDelayLineReader()
+{
+    mMode = kLinear;
+    mMaxNumSamples = 0;
+    mCapacity = 0;
+
+    reset();
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::prepare(int maxNumSamples)
+{
+    mMaxNumSamples = juce::jmax(1, maxNumSamples);
+
+    /** one row per tap plus a last row for the fractional parts, kept when a later prepare needs less */
+    if (mMaxNumSamples > mCapacity){
+        mIndices.allocate((size_t)mMaxNumSamples, true);
+        mTaps.setSize(kMaxTaps + 1, mMaxNumSamples);
+        mVoiceOutput.allocate((size_t)mMaxNumSamples, true);
+        mCapacity = mMaxNumSamples;
+    }
+    mTaps.clear();
+
+    /** build the table and pick the instruction set now rather than on the audio thread */
+    getSincTable<SampleType>();
+    DspKernels::getIsa();
+
+    reset();
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::releaseMemory()
+{
+    mIndices.free();
+    mTaps.setSize(0, 0);
+    mVoiceOutput.free();
+    mMaxNumSamples = 0;
+    mCapacity = 0;
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::reset()
+{
+    for (auto& state : mAllpassState){
+        state = AllpassState();
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::setMode(Mode newMode)
+{
+    if (newMode != mMode){
+        mMode = newMode;
+        reset();
+    }
+}
+
+template <typename SampleType>
+typename BasicDelayLineReader<SampleType>::Mode BasicDelayLineReader<SampleType>::getMode() const
+{
+    return mMode;
+}
+
+template <typename SampleType>
+int BasicDelayLineReader<SampleType>::getTapsAhead(Mode mode)
+{
+    switch (mode){
+        case kHermite:
+        case kLagrange3:    return 2;
+        case kLagrange5:    return 3;
+        case kThiran:       return 2;
+        case kSinc:         return kSincTaps + kSincFirstTap - 1;
+        default:            return 1;
+    }
+}
+
+template <typename SampleType>
+int BasicDelayLineReader<SampleType>::getTapsBehind(Mode mode)
+{
+    switch (mode){
+        case kHermite:
+        case kLagrange3:    return 1;
+        case kLagrange5:    return 2;
+        case kSinc:         return -kSincFirstTap;
+        default:            return 0;
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::read(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples, int voice)
+{
+    switch (mMode){
+        case kLinear:       readWithMode<kLinear>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        case kHermite:      readWithMode<kHermite>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        case kLagrange3:    readWithMode<kLagrange3>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        case kLagrange5:    readWithMode<kLagrange5>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        case kThiran:       readWithMode<kThiran>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        case kSinc:         readWithMode<kSinc>(delayLine, channel, readPositions, destination, numSamples, voice); break;
+        default:            break;
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readAndAdd(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples, int voice)
+{
+    switch (mMode){
+        case kLinear:       readAndAddWithMode<kLinear>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        case kHermite:      readAndAddWithMode<kHermite>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        case kLagrange3:    readAndAddWithMode<kLagrange3>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        case kLagrange5:    readAndAddWithMode<kLagrange5>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        case kThiran:       readAndAddWithMode<kThiran>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        case kSinc:         readAndAddWithMode<kSinc>(delayLine, channel, readPositions, gain, destination, numSamples, voice); break;
+        default:            break;
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readLinearAndAdd(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples)
+{
+    /** linear reads are cheap enough that a separate pass to add them would cost as much again */
+    DspKernels::get<SampleType>().readLinearAndAdd(delayLine.getData() + channel, delayLine.getMask(), delayLine.getNumChannels(),
+                                                   readPositions, gain, destination, numSamples);
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::splitPositions(const float* readPositions, int numSamples)
+{
+    DspKernels::get<SampleType>().splitPositions(readPositions, mIndices.get(), mTaps.getWritePointer(kMaxTaps), numSamples);
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::gatherTaps(const BasicDelayLine<SampleType>& delayLine, int channel, int firstTap, int numTaps, int numSamples)
+{
+    const auto& kernels = DspKernels::get<SampleType>();
+
+    /** tap rows are numbered from the earliest tap, so row 0 is firstTap frames from the integer position */
+    for (int k = 0; k < numTaps; k++){
+        kernels.gatherTap(delayLine.getData() + channel, delayLine.getMask(), delayLine.getNumChannels(),
+                          mIndices.get(), firstTap + k, mTaps.getWritePointer(k), numSamples);
+    }
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readLinear(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples)
+{
+    DspKernels::get<SampleType>().readLinear(delayLine.getData() + channel, delayLine.getMask(), delayLine.getNumChannels(),
+                                             readPositions, destination, numSamples);
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readHermite(SampleType* destination, int numSamples)
+{
+    DspKernels::get<SampleType>().interpolateHermite(mTaps.getArrayOfReadPointers(), mTaps.getReadPointer(kMaxTaps), destination, numSamples);
+}
+
+template <typename SampleType>
+template <int NumTaps>
+void BasicDelayLineReader<SampleType>::readLagrange(SampleType* destination, int numSamples)
+{
+    static_assert (NumTaps == 4 || NumTaps == 6, "only the 3rd and 5th order kernels are built");
+
+    const auto& kernels = DspKernels::get<SampleType>();
+    const auto interpolate = (NumTaps == 4) ? kernels.interpolateLagrange3 : kernels.interpolateLagrange5;
+
+    interpolate(mTaps.getArrayOfReadPointers(), mTaps.getReadPointer(kMaxTaps), destination, numSamples);
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readThiran(AllpassState& allpassState, SampleType* destination, int numSamples)
+{
+    const SampleType* const* taps = mTaps.getArrayOfReadPointers();
+    const SampleType* fractions = mTaps.getReadPointer(kMaxTaps);
+    SampleType* coefficient = mTaps.getWritePointer(3);
+    SampleType* newest = mTaps.getWritePointer(4);
+    SampleType* previous = mTaps.getWritePointer(5);
+
+    /** taps 0 to 2 in, the coefficients and the allpass inputs out in rows 3 to 5 */
+    DspKernels::get<SampleType>().thiranCoefficients(taps, fractions, coefficient, newest, previous, numSamples);
+
+    /** the recursion itself is serial. A delay measured from the next tap is over a sample, so its
+        coefficient is negative. When a swept delay crosses half a sample the allpass starts measuring
+        from the other tap, and its last output no longer matches the new taps and coefficient. That
+        output is worked out again as the new measure would have given it, from the read before */
+    AllpassState state = allpassState;
+
+    for (int i = 0; i < numSamples; i++){
+        const bool usesNext = coefficient[i] < 0;
+
+        if (usesNext != state.usedNext){
+            const SampleType delay = (usesNext ? 2 : 1) - state.fraction;
+            const SampleType lastCoefficient = (1 - delay) / (1 + delay);
+            const SampleType lastNewest = usesNext ? state.taps[2] : state.taps[1];
+            const SampleType lastPrevious = usesNext ? state.taps[1] : state.taps[0];
+
+            state.output = lastCoefficient * (lastNewest - state.previousOutput) + lastPrevious;
+        }
+
+        state.previousOutput = state.output;
+        state.output = coefficient[i] * (newest[i] - state.output) + previous[i];
+        destination[i] = state.output;
+
+        state.taps[0] = taps[0][i];
+        state.taps[1] = taps[1][i];
+        state.taps[2] = taps[2][i];
+        state.fraction = fractions[i];
+        state.usedNext = usesNext;
+    }
+
+    allpassState = state;
+}
+
+template <typename SampleType>
+void BasicDelayLineReader<SampleType>::readSinc(SampleType* destination, int numSamples)
+{
+    /** the index and fraction arrays are reused for the table row and the position between rows */
+    DspKernels::get<SampleType>().interpolateSinc(mTaps.getArrayOfReadPointers(), kSincTaps, getSincTable<SampleType>().table, kSincPhases,
+                                                  mIndices.get(), mTaps.getWritePointer(kMaxTaps), destination, numSamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+juce::String BasicDelayLineReader<SampleType>::createReport(int numSamples)
+{
+    const int blockSize = 512;
+    const double highFrequency = 0.35;
+    const double sweepFrequency = 0.1;
+
+    /** a one second line, long enough that the reads never wrap onto freshly written samples */
+    BasicDelayLine<SampleType> delayLine;
+    delayLine.prepare(44100, 1.0f, 1);
+
+    numSamples = juce::jmin(numSamples, delayLine.getLength() - 64);
+
+    std::vector<float> positions (numSamples);
+    std::vector<SampleType> output (numSamples);
+
+    juce::String report;
+    report << "Mode          gain at 0.35 fs (dB)   max |error| at 0.1 fs   ns/sample\n";
+
+    const auto names = getModeNames();
+
+    for (int m = 0; m < kNumModes; m++){
+        BasicDelayLineReader reader;
+        reader.prepare(blockSize);
+        reader.setMode((Mode)m);
+
+        /** gain: a sine near the top of the band read exactly half a sample late, the worst case for linear */
+        for (int i = 0; i < delayLine.getLength(); i++){
+            delayLine.setSample(0, i, (SampleType)std::sin(2.0 * M_PI * highFrequency * i));
+        }
+        for (int i = 0; i < numSamples; i++){
+            positions[i] = 32.5f + i;
+        }
+        for (int i = 0; i < numSamples; i += blockSize){
+            reader.read(delayLine, 0, positions.data() + i, output.data() + i, juce::jmin(blockSize, numSamples - i));
+        }
+
+        double outputPower = 0;
+        double idealPower = 0;
+        for (int i = 64; i < numSamples; i++){
+            const double ideal = std::sin(2.0 * M_PI * highFrequency * positions[i]);
+            outputPower += output[i] * output[i];
+            idealPower += ideal * ideal;
+        }
+        const double gainDecibels = 10.0 * std::log10(outputPower / idealPower);
+
+        /** error and cost: a lower sine read through a sweeping fractional delay, as the LFO does */
+        for (int i = 0; i < delayLine.getLength(); i++){
+            delayLine.setSample(0, i, (SampleType)std::sin(2.0 * M_PI * sweepFrequency * i));
+        }
+        for (int i = 0; i < numSamples; i++){
+            positions[i] = 32.5f + i + 0.49f * (float)std::sin(2.0 * M_PI * i / 1000.0);
+        }
+
+        reader.reset();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numSamples; i += blockSize){
+            reader.read(delayLine, 0, positions.data() + i, output.data() + i, juce::jmin(blockSize, numSamples - i));
+        }
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        double maxError = 0;
+        for (int i = 64; i < numSamples; i++){
+            maxError = juce::jmax(maxError, std::abs(output[i] - std::sin(2.0 * M_PI * sweepFrequency * positions[i])));
+        }
+
+        const double nsPerSample = 1.0e9 * juce::Time::highResolutionTicksToSeconds(elapsed) / numSamples;
+
+        report << names[m].paddedRight(' ', 14)
+               << juce::String(gainDecibels, 3).paddedRight(' ', 23)
+               << juce::String(maxError, 7).paddedRight(' ', 24)
+               << juce::String(nsPerSample, 2) << "\n";
+    }
+
+    return report;
+}
+
+template <typename SampleType>
+juce::StringArray BasicDelayLineReader<SampleType>::getModeNames()
+{
+    return { "Linear", "Hermite", "Lagrange 3", "Lagrange 5", "Thiran", "Sinc" };
+}
+
+template class BasicDelayLineReader<float>;
+template class BasicDelayLineReader<double>;
+
+/** readWithMode() is defined in the header, the Lagrange readers it calls are only instantiated here */
+template void BasicDelayLineReader<float>::readLagrange<4>(float*, int);
+template void BasicDelayLineReader<float>::readLagrange<6>(float*, int);
+template void BasicDelayLineReader<double>::readLagrange<4>(double*, int);
+template void BasicDelayLineReader<double>::readLagrange<6>(double*, int);
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    DelayLineReader.h
+    Created: 17 Oct 2026 8:40:17pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayLine.h"
+
+//==============================================================================
+/**
+    Fractional-delay reads from a BasicDelayLine of the same sample type, with a
+    choice of interpolators. Read positions are float in both precisions, they
+    come from the modulation, which stays single precision.
+
+    Linear is the original reader and stays the default. The higher orders keep
+    more of the top octave and add less modulation noise on fast, short sweeps,
+    at a cost per sample that createReport() measures.
+
+    Reads work on a run of positions at once. Positions are split into integer
+    and fractional parts, the taps are gathered into one array per tap, then the
+    taps are combined across the whole run. The split and combine loops are
+    straight-line arithmetic over arrays, so they vectorise. Thiran is the one
+    exception: it is recursive, so only its coefficients vectorise. The loops
+    themselves are in DspKernels, built for each instruction set.
+*/
+template <typename SampleType>
+class BasicDelayLineReader
+{
+public:
+
+    enum Mode
+    {
+        kLinear = 0,        // 2 taps, the original lin_interp
+        kHermite,           // 4-point cubic Hermite
+        kLagrange3,         // 4-point 3rd-order Lagrange
+        kLagrange5,         // 6-point 5th-order Lagrange
+        kThiran,            // 1st-order allpass, flat magnitude, needs per-channel state, for fixed or slow delays
+        kSinc,              // 8-point Blackman-windowed sinc, polyphase table
+        kNumModes
+    };
+
+    /** taps that can read the same channel at once, each keeps its own allpass state */
+    static constexpr int kMaxVoices = 8;
+
+    BasicDelayLineReader();
+
+    /** allocate the tap arrays for runs of up to maxNumSamples and clear the allpass state.
+        Only allocates when the arrays are too short for maxNumSamples */
+    void prepare(int maxNumSamples);
+
+    /** hand the tap arrays back, prepare allocates them again */
+    void releaseMemory();
+
+    /** clear the allpass state */
+    void reset();
+
+    /** changing mode clears the allpass state, so a switch to Thiran starts cleanly */
+    void setMode(Mode newMode);
+    Mode getMode() const;
+
+    /** taps read after the integer part of a position, the processor keeps its feedback
+        chunks short enough that these have always been written */
+    static int getTapsAhead(Mode mode);
+
+    /** taps read before the integer part of a position */
+    static int getTapsBehind(Mode mode);
+
+    /** interpolate one channel at numSamples read positions, numSamples must not exceed the prepared size.
+        Each voice reading the same channel needs its own voice index */
+    void read(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples, int voice = 0);
+
+    /** interpolate like read() and add the result times gain into destination, for mixing voices */
+    void readAndAdd(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples, int voice);
+
+    /** read() and readAndAdd() with the interpolator fixed at compile time, for callers that pick a
+        kernel per mode once per block. ModeIndex must be the current mode */
+    template <int ModeIndex>
+    void readWithMode(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples, int voice = 0);
+
+    template <int ModeIndex>
+    void readAndAddWithMode(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples, int voice);
+
+    /** measure each mode's cost and its gain and error on a high sine read half a sample late */
+    static juce::String createReport(int numSamples = 1 << 16);
+
+    static juce::StringArray getModeNames();
+
+private:
+
+    static constexpr int kMaxTaps = 8;
+
+    void splitPositions(const float* readPositions, int numSamples);
+    void gatherTaps(const BasicDelayLine<SampleType>& delayLine, int channel, int firstTap, int numTaps, int numSamples);
+
+    void readLinear(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples);
+    void readLinearAndAdd(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples);
+    void readHermite(SampleType* destination, int numSamples);
+    template <int NumTaps>
+    void readLagrange(SampleType* destination, int numSamples);
+    /** Thiran Data, per channel and voice. Besides the last two outputs, the last read's three taps,
+        its fraction and which tap it measured from, so the state can be moved across when the
+        allpass starts measuring from the other tap */
+    struct AllpassState
+    {
+        SampleType output = 0;
+        SampleType previousOutput = 0;
+        SampleType taps[3] = {};
+        SampleType fraction = 0;
+        bool usedNext = false;
+    };
+
+    void readThiran(AllpassState& allpassState, SampleType* destination, int numSamples);
+    void readSinc(SampleType* destination, int numSamples);
+
+    Mode mMode;
+
+    /** integer and fractional parts of the read positions, then one row per tap */
+    juce::HeapBlock<int> mIndices;
+    juce::AudioBuffer<SampleType> mTaps;
+    juce::HeapBlock<SampleType> mVoiceOutput;
+    int mMaxNumSamples;
+    int mCapacity;
+
+    AllpassState mAllpassState[DelayLine::kMaxChannels * kMaxVoices];
+
+    JUCE_LEAK_DETECTOR (BasicDelayLineReader)
+};
+
+/** the plugin's own precision, and where the modes and shared constants are read from */
+using DelayLineReader = BasicDelayLineReader<float>;
+
+//==============================================================================
+template <typename SampleType>
+template <int ModeIndex>
+void BasicDelayLineReader<SampleType>::readWithMode(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType* destination, int numSamples, int voice)
+{
+    jassert(numSamples <= mMaxNumSamples && voice < kMaxVoices && ModeIndex == mMode);
+
+    if constexpr (ModeIndex == kLinear){
+        readLinear(delayLine, channel, readPositions, destination, numSamples);
+    } else {
+        constexpr auto mode = (Mode)ModeIndex;
+
+        splitPositions(readPositions, numSamples);
+
+        const int tapsBehind = getTapsBehind(mode);
+        gatherTaps(delayLine, channel, -tapsBehind, tapsBehind + getTapsAhead(mode) + 1, numSamples);
+
+        if constexpr (mode == kHermite){
+            readHermite(destination, numSamples);
+        } else if constexpr (mode == kLagrange3){
+            readLagrange<4>(destination, numSamples);
+        } else if constexpr (mode == kLagrange5){
+            readLagrange<6>(destination, numSamples);
+        } else if constexpr (mode == kThiran){
+            readThiran(mAllpassState[channel * kMaxVoices + voice], destination, numSamples);
+        } else {
+            static_assert(mode == kSinc, "every mode needs a reader");
+            readSinc(destination, numSamples);
+        }
+    }
+}
+
+template <typename SampleType>
+template <int ModeIndex>
+void BasicDelayLineReader<SampleType>::readAndAddWithMode(const BasicDelayLine<SampleType>& delayLine, int channel, const float* readPositions, SampleType gain, SampleType* destination, int numSamples, int voice)
+{
+    if constexpr (ModeIndex == kLinear){
+        readLinearAndAdd(delayLine, channel, readPositions, gain, destination, numSamples);
+    } else {
+        readWithMode<ModeIndex>(delayLine, channel, readPositions, mVoiceOutput.get(), numSamples, voice);
+        juce::FloatVectorOperations::addWithMultiply(destination, mVoiceOutput.get(), gain, numSamples);
+    }
+}
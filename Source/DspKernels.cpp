@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    DspKernels.cpp
+    Created: 18 Oct 2026 9:26:41am
+
+  ==============================================================================
+*/
+
+#include "DspKernels.h"
+#include "LFO.h"
+
+#if KP_MULTI_ISA
+ #include <immintrin.h>
+ #include <cpuid.h>
+#endif
+
+/** a multiply and an add stay two roundings in every copy, so that the copies are bit-identical.
+    Otherwise the AVX-512 copy, which implies FMA, would fuse them. GCC gets -ffp-contract=off from
+    the project's compiler flags */
+#if JUCE_CLANG
+ #pragma clang fp contract(off)
+#endif
+
+namespace
+{
+    #define KP_KERNEL
+    namespace generic
+    {
+        #include "DspKernelsImpl.h"
+    }
+    #undef KP_KERNEL
+
+   #if KP_MULTI_ISA
+    #define KP_KERNEL KP_TARGET_SSE41
+    namespace sse41
+    {
+        #include "DspKernelsImpl.h"
+    }
+    #undef KP_KERNEL
+
+    #define KP_KERNEL KP_TARGET_AVX2
+    namespace avx2
+    {
+        #include "DspKernelsImpl.h"
+    }
+    #undef KP_KERNEL
+
+    #define KP_KERNEL KP_TARGET_AVX512
+    namespace avx512
+    {
+        #include "DspKernelsImpl.h"
+    }
+    #undef KP_KERNEL
+
+    /** each copy proves its target with instructions only its Isa has. A copy the compiler built
+        without its target, for an attribute it ignored, would fail to inline these intrinsics rather
+        than quietly run the generic code */
+    namespace sse41
+    {
+        __attribute__((target("sse4.1"))) DspKernels::Isa getBuiltIsa(int one)
+        {
+            const __m128i minimum = _mm_min_epi32(_mm_set1_epi32(one), _mm_set1_epi32(2));
+            return _mm_cvtsi128_si32(minimum) == 1 ? DspKernels::kSSE41 : DspKernels::kGeneric;
+        }
+    }
+
+    namespace avx2
+    {
+        __attribute__((target("avx2"))) DspKernels::Isa getBuiltIsa(int one)
+        {
+            const __m256i minimum = _mm256_min_epi32(_mm256_set1_epi32(one), _mm256_set1_epi32(2));
+            return _mm_cvtsi128_si32(_mm256_castsi256_si128(minimum)) == 1 ? DspKernels::kAVX2 : DspKernels::kGeneric;
+        }
+    }
+
+    namespace avx512
+    {
+        /** one instruction from each of F, BW, DQ and VL */
+        __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"))) DspKernels::Isa getBuiltIsa(int one)
+        {
+            const __m512i bytes = _mm512_min_epi8(_mm512_set1_epi8((char)one), _mm512_set1_epi8(2));
+            const __m512i words = _mm512_cvtepi8_epi32(_mm512_castsi512_si128(bytes));
+            const __m512d doubles = _mm512_cvtepi64_pd(_mm512_cvtepi32_epi64(_mm512_castsi512_si256(words)));
+            const __m256i masked = _mm256_maskz_mov_epi32(0x01, _mm256_set1_epi32((int)_mm512_cvtsd_f64(doubles)));
+
+            return _mm_cvtsi128_si32(_mm256_castsi256_si128(masked)) == 1 ? DspKernels::kAVX512 : DspKernels::kGeneric;
+        }
+    }
+   #endif
+
+    /** a build without the other copies runs the generic one for every Isa */
+    template <typename Table>
+    struct IsaTables
+    {
+        const Table* tables[DspKernels::kNumIsas];
+    };
+
+    template <typename SampleType>
+    const IsaTables<DspKernels::SampleKernels<SampleType>> sampleTables =
+    {{
+        &generic::sampleKernels<SampleType>,
+       #if KP_MULTI_ISA
+        &sse41::sampleKernels<SampleType>,
+        &avx2::sampleKernels<SampleType>,
+        &avx512::sampleKernels<SampleType>
+       #else
+        &generic::sampleKernels<SampleType>,
+        &generic::sampleKernels<SampleType>,
+        &generic::sampleKernels<SampleType>
+       #endif
+    }};
+
+    const IsaTables<DspKernels::LFOKernels> lfoTables =
+    {{
+        &generic::lfoKernels,
+       #if KP_MULTI_ISA
+        &sse41::lfoKernels,
+        &avx2::lfoKernels,
+        &avx512::lfoKernels
+       #else
+        &generic::lfoKernels,
+        &generic::lfoKernels,
+        &generic::lfoKernels
+       #endif
+    }};
+
+    constexpr const char* kIsaVariable = "KPCHORUSFLANGER_ISA";
+
+    /** the detected Isa, or the one the environment asks for */
+    DspKernels::Isa getInitialIsa()
+    {
+        const auto name = juce::SystemStats::getEnvironmentVariable(kIsaVariable, {});
+        const auto isa = DspKernels::findIsa(name);
+
+        if (name.isNotEmpty() && isa == DspKernels::kNumIsas){
+            DBG(juce::String(kIsaVariable) + "=" + name + " is not an instruction set, using " + DspKernels::getIsaNames()[DspKernels::getDetectedIsa()]);
+        }
+
+        return DspKernels::isSupported(isa) ? isa : DspKernels::getDetectedIsa();
+    }
+
+   #if KP_MULTI_ISA
+    /** the register states the OS saves on a context switch, from XCR0. cpuid only says what the
+        processor has, an OS or hypervisor that leaves AVX off makes its instructions fault */
+    juce::uint64 getEnabledRegisterStates()
+    {
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        /** xgetbv is only there if the OS has turned on XSAVE */
+        if (! __get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_OSXSAVE) == 0){
+            return 0;
+        }
+
+        unsigned int low = 0, high = 0;
+        __asm__ volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+
+        return ((juce::uint64)high << 32) | low;
+    }
+   #endif
+
+    DspKernels::Isa detectIsa()
+    {
+       #if KP_MULTI_ISA
+        constexpr juce::uint64 kAVXStates = 0x06;       // SSE and the upper halves of the YMM registers, bits 1 and 2
+        constexpr juce::uint64 kAVX512States = 0xe6;    // and the opmask and ZMM registers, bits 5 to 7
+
+        const auto states = getEnabledRegisterStates();
+
+        /** AVX-512 needs all four subsets the copy is built for, the first Xeon Phis lack VL, BW and DQ */
+        if ((states & kAVX512States) == kAVX512States
+             && juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512VL()
+             && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512DQ()){
+            return DspKernels::kAVX512;
+        }
+
+        if ((states & kAVXStates) == kAVXStates && juce::SystemStats::hasAVX2()){
+            return DspKernels::kAVX2;
+        }
+
+        if (juce::SystemStats::hasSSE41()){
+            return DspKernels::kSSE41;
+        }
+       #endif
+
+        return DspKernels::kGeneric;
+    }
+
+    std::atomic<int>& getActiveIsa()
+    {
+        static std::atomic<int> activeIsa { (int)getInitialIsa() };
+        return activeIsa;
+    }
+}
+
+//==============================================================================
+const DspKernels::SampleKernels<float>& DspKernels::getSampleKernels(float*, Isa isa)
+{
+    return *sampleTables<float>.tables[juce::jlimit(0, kNumIsas - 1, (int)isa)];
+}
+
+const DspKernels::SampleKernels<double>& DspKernels::getSampleKernels(double*, Isa isa)
+{
+    return *sampleTables<double>.tables[juce::jlimit(0, kNumIsas - 1, (int)isa)];
+}
+
+const DspKernels::LFOKernels& DspKernels::getLFOKernels(Isa isa)
+{
+    return *lfoTables.tables[juce::jlimit(0, kNumIsas - 1, (int)isa)];
+}
+
+DspKernels::Isa DspKernels::getDetectedIsa()
+{
+    static const Isa detectedIsa = detectIsa();
+    return detectedIsa;
+}
+
+DspKernels::Isa DspKernels::getBuiltIsa(Isa isa)
+{
+    jassert(isSupported(isa));
+
+   #if KP_MULTI_ISA
+    /** the argument keeps the compiler from folding the instructions away */
+    static volatile int one = 1;
+
+    switch (isa){
+        case kSSE41:    return sse41::getBuiltIsa(one);
+        case kAVX2:     return avx2::getBuiltIsa(one);
+        case kAVX512:   return avx512::getBuiltIsa(one);
+        default:        break;
+    }
+   #endif
+
+    return kGeneric;
+}
+
+bool DspKernels::isSupported(Isa isa)
+{
+    return isa >= kGeneric && isa <= getDetectedIsa();
+}
+
+DspKernels::Isa DspKernels::getIsa()
+{
+    return (Isa)getActiveIsa().load(std::memory_order_relaxed);
+}
+
+DspKernels::Isa DspKernels::setIsa(Isa isa)
+{
+    const Isa used = isSupported(isa) ? isa : getDetectedIsa();
+    getActiveIsa().store((int)used, std::memory_order_relaxed);
+    return used;
+}
+
+juce::StringArray DspKernels::getIsaNames()
+{
+    return { "Generic", "SSE4.1", "AVX2", "AVX-512" };
+}
+
+DspKernels::Isa DspKernels::findIsa(const juce::String& name)
+{
+    const auto names = getIsaNames();
+
+    for (int isa = 0; isa < names.size(); isa++){
+        if (names[isa].removeCharacters(".-").equalsIgnoreCase(name.removeCharacters(".-_ "))){
+            return (Isa)isa;
+        }
+    }
+
+    return kNumIsas;
+}
@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    DspKernels.h
+    Created: 18 Oct 2026 9:26:41am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/** one copy of the loops per Isa needs per-function targets, which GCC and Clang have on x86. The
+    attributes of each copy, for every file built once per Isa */
+#if JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+ #define KP_MULTI_ISA 1
+ #define KP_TARGET_SSE41 __attribute__((target("sse4.1")))
+ #define KP_TARGET_AVX2 __attribute__((target("avx2,tune=skylake")))
+
+ /** Clang ignores the whole target attribute if it has a prefer-vector-width, and asks for 512-bit
+     vectors with an attribute of its own */
+ #if JUCE_CLANG
+  #define KP_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq"), min_vector_width(512)))
+ #else
+  #define KP_TARGET_AVX512 __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,prefer-vector-width=512,tune=skylake-avx512")))
+ #endif
+#else
+ #define KP_MULTI_ISA 0
+#endif
+
+//==============================================================================
+/**
+    The innermost loops of the delay line reader, the LFO and the dry/wet mix,
+    built for several instruction sets in one binary and chosen at run time.
+
+    Every loop is compiled once per Isa with the compiler's target attribute, so
+    the same build uses AVX-512 on machines that have it, AVX2 on others and
+    SSE4.1 or the generic x86-64 code on older ones. The best Isa the CPU
+    supports is picked from cpuid the first time a table is asked for. Setting
+    the environment variable KPCHORUSFLANGER_ISA to one of getIsaNames(), or
+    calling setIsa(), forces another, for testing. An Isa the CPU lacks falls
+    back to the best one it has.
+
+    The copies do the same operations in the same order and none of them
+    contracts a multiply and an add into an FMA, so they are bit-identical.
+    Builds for other processors, and MSVC, which has no per-function targets,
+    only have the generic copy. ChorusFlangerBatch builds its group loops the
+    same way and picks them with getIsa().
+
+    Each loop works on plain arrays and keeps no state, the callers own it.
+*/
+struct DspKernels
+{
+    enum Isa
+    {
+        kGeneric = 0,       // whatever the build targets, SSE2 on x86-64
+        kSSE41,
+        kAVX2,              // AVX2, without FMA
+        kAVX512,            // AVX-512 F, VL, BW and DQ, 512-bit vectors, without FMA
+        kNumIsas
+    };
+
+    /** the loops of one sample type. The delay line ones take its interleaved buffer at the
+        channel to read, its mask and its number of channels */
+    template <typename SampleType>
+    struct SampleKernels
+    {
+        /** linear interpolation straight from the buffer, set or added times gain */
+        void (*readLinear)(const SampleType* buffer, int mask, int stride, const float* positions, SampleType* destination, int numSamples);
+        void (*readLinearAndAdd)(const SampleType* buffer, int mask, int stride, const float* positions, SampleType gain, SampleType* destination, int numSamples);
+
+        /** split positions into integer and fractional parts, then copy one tap offset from the integer parts */
+        void (*splitPositions)(const float* positions, int* indices, SampleType* fractions, int numSamples);
+        void (*gatherTap)(const SampleType* buffer, int mask, int stride, const int* indices, int offset, SampleType* tap, int numSamples);
+
+        /** combine gathered taps, earliest first, at the fractions */
+        void (*interpolateHermite)(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples);
+        void (*interpolateLagrange3)(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples);
+        void (*interpolateLagrange5)(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples);
+
+        /** the Thiran allpass coefficient and its two inputs per sample, from three taps */
+        void (*thiranCoefficients)(const SampleType* const* taps, const SampleType* fractions, SampleType* coefficients,
+                                   SampleType* newest, SampleType* previous, int numSamples);
+
+        /** polyphase sinc from a table of numTaps coefficients per row, numPhases + 1 rows. Overwrites
+            rows and fractions */
+        void (*interpolateSinc)(const SampleType* const* taps, int numTaps, const SampleType* table, int numPhases,
+                                int* rows, SampleType* fractions, SampleType* destination, int numSamples);
+
+        /** output = output * (1 - wet) + delayed * wet, with a wet amount per sample or one for the whole run */
+        void (*mixRamp)(SampleType* output, const SampleType* delayed, const float* wetAmounts, int numSamples);
+        void (*mixConstant)(SampleType* output, const SampleType* delayed, SampleType dry, SampleType wet, int numSamples);
+
+        /** write input plus the feedback of the sample before into the buffer from writeHead on */
+        void (*writeWithFeedback)(SampleType* buffer, int mask, int stride, int writeHead, const SampleType* input, const SampleType* delayed,
+                                  SampleType& feedbackState, const float* feedbackAmounts, int numSamples);
+    };
+
+    /** the LFO loops, from phases of 0 to 1 */
+    struct LFOKernels
+    {
+        /** a table of tableSize + 1 values with linear interpolation */
+        void (*wavetable)(const float* table, int tableSize, const float* phases, float* output, int numSamples);
+
+        /** the polynomial sine, or the naive triangle and soft square, by LFO::Waveform */
+        void (*polynomial)(int waveform, const float* phases, float* output, int numSamples);
+    };
+
+    /** the tables of the Isa in use */
+    template <typename SampleType>
+    static const SampleKernels<SampleType>& get()       { return getSampleKernels((SampleType*)nullptr, getIsa()); }
+    static const LFOKernels& getLFO()                   { return getLFOKernels(getIsa()); }
+
+    /** the tables of any Isa, whether this CPU supports it or not */
+    static const SampleKernels<float>& getSampleKernels(float*, Isa isa);
+    static const SampleKernels<double>& getSampleKernels(double*, Isa isa);
+    static const LFOKernels& getLFOKernels(Isa isa);
+
+    /** the best Isa this build and CPU support, from cpuid and the register states the OS saves */
+    static Isa getDetectedIsa();
+    static bool isSupported(Isa isa);
+
+    /** the Isa the copy for isa was built for, found by running instructions of that Isa, so that a
+        target attribute the compiler dropped shows. kGeneric in a build with only the generic copy.
+        isa must be supported */
+    static Isa getBuiltIsa(Isa isa);
+
+    /** the Isa in use, and forcing another. An unsupported one is replaced by getDetectedIsa(), the
+        Isa actually used is returned. Takes effect from the next call into a kernel, on every thread */
+    static Isa getIsa();
+    static Isa setIsa(Isa isa);
+
+    static juce::StringArray getIsaNames();
+
+    /** the Isa named, as in getIsaNames() or in lower case without punctuation, e.g. "avx512",
+        or kNumIsas if there is none */
+    static Isa findIsa(const juce::String& name);
+};
@@ -0,0 +1,301 @@
+/*
+  ==============================================================================
+
+    DspKernelsImpl.h
+    Created: 18 Oct 2026 9:26:41am
+
+  ==============================================================================
+*/
+
+/** The loops behind DspKernels. DspKernels.cpp includes this file once per Isa, inside a namespace
+    of its own and with KP_KERNEL set to that Isa's target attribute, so there is no include guard.
+    The helpers are kernels too, so they are built for the same Isa and inline into their callers.
+
+    Arrays marked __restrict never overlap the others, which lets the indexed reads become gathers.
+    The LFO phases and output may be the same array */
+
+template <typename SampleType>
+KP_KERNEL void readLinear(const SampleType* __restrict buffer, int mask, int stride, const float* __restrict positions, SampleType* __restrict destination, int numSamples)
+{
+    /** the original reader. Read positions are already wrapped, but one a hair below zero wraps to
+        exactly the length once rounded to float, so the integer position is masked as well */
+    for (int i = 0; i < numSamples; i++){
+        int readHead_x = (int)positions[i];
+        int readHead_x1 = (readHead_x + 1) & mask;
+        float readHeadFloat = positions[i] - readHead_x;
+
+        readHead_x &= mask;
+
+        destination[i] = (1 - readHeadFloat) * buffer[readHead_x * stride]
+                       + readHeadFloat * buffer[readHead_x1 * stride];
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void readLinearAndAdd(const SampleType* __restrict buffer, int mask, int stride, const float* __restrict positions, SampleType gain,
+                                SampleType* __restrict destination, int numSamples)
+{
+    /** linear reads are cheap enough that a separate pass to add them would cost as much again */
+    for (int i = 0; i < numSamples; i++){
+        const int position = (int)positions[i];
+        const int readHead_x = position & mask;
+        const int readHead_x1 = (position + 1) & mask;
+        const float readHeadFloat = positions[i] - position;
+        const SampleType x0 = buffer[readHead_x * stride];
+
+        destination[i] += gain * (x0 + readHeadFloat * (buffer[readHead_x1 * stride] - x0));
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void splitPositions(const float* __restrict positions, int* __restrict indices, SampleType* __restrict fractions, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        const int index = (int)positions[i];
+        indices[i] = index;
+        fractions[i] = positions[i] - index;
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void gatherTap(const SampleType* __restrict buffer, int mask, int stride, const int* __restrict indices, int offset, SampleType* __restrict tap, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        tap[i] = buffer[((indices[i] + offset) & mask) * stride];
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void interpolateHermite(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples)
+{
+    const SampleType* xm1 = taps[0];
+    const SampleType* x0 = taps[1];
+    const SampleType* x1 = taps[2];
+    const SampleType* x2 = taps[3];
+
+    for (int i = 0; i < numSamples; i++){
+        const SampleType c1 = (SampleType)0.5 * (x1[i] - xm1[i]);
+        const SampleType c2 = xm1[i] - (SampleType)2.5 * x0[i] + (SampleType)2.0 * x1[i] - (SampleType)0.5 * x2[i];
+        const SampleType c3 = (SampleType)0.5 * (x2[i] - xm1[i]) + (SampleType)1.5 * (x0[i] - x1[i]);
+
+        destination[i] = ((c3 * fractions[i] + c2) * fractions[i] + c1) * fractions[i] + x0[i];
+    }
+}
+
+template <typename SampleType, int NumTaps>
+KP_KERNEL void interpolateLagrange(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples)
+{
+    /** the taps sit at firstTap .. firstTap + NumTaps - 1 around the integer position */
+    constexpr int firstTap = 1 - NumTaps / 2;
+
+    for (int i = 0; i < numSamples; i++){
+        destination[i] = 0;
+    }
+
+    for (int k = 0; k < NumTaps; k++){
+        /** the denominator of each basis polynomial is a constant */
+        SampleType denominator = 1;
+        for (int j = 0; j < NumTaps; j++){
+            if (j != k){
+                denominator *= (SampleType)(k - j);
+            }
+        }
+
+        const SampleType scale = (SampleType)1 / denominator;
+        const SampleType* tap = taps[k];
+
+        for (int i = 0; i < numSamples; i++){
+            SampleType basis = scale;
+            for (int j = 0; j < NumTaps; j++){
+                if (j != k){
+                    basis *= fractions[i] - (SampleType)(j + firstTap);
+                }
+            }
+            destination[i] += basis * tap[i];
+        }
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void interpolateLagrange3(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples)
+{
+    interpolateLagrange<SampleType, 4>(taps, fractions, destination, numSamples);
+}
+
+template <typename SampleType>
+KP_KERNEL void interpolateLagrange5(const SampleType* const* taps, const SampleType* fractions, SampleType* destination, int numSamples)
+{
+    interpolateLagrange<SampleType, 6>(taps, fractions, destination, numSamples);
+}
+
+template <typename SampleType>
+KP_KERNEL void thiranCoefficients(const SampleType* const* taps, const SampleType* fractions, SampleType* coefficients,
+                                  SampleType* newest, SampleType* previous, int numSamples)
+{
+    const SampleType* x0 = taps[0];
+    const SampleType* x1 = taps[1];
+    const SampleType* x2 = taps[2];
+
+    /** the allpass is best conditioned for delays of 0.5 to 1.5 samples, so measure the delay
+        back from x1 or, for small delays, from x2. The inputs and the coefficients are two loops:
+        in one, GCC turns the three selects back into branches and vectorises neither */
+    for (int i = 0; i < numSamples; i++){
+        const SampleType tap0 = x0[i];
+        const SampleType tap1 = x1[i];
+        const SampleType tap2 = x2[i];
+        const bool useNext = 1 - fractions[i] < (SampleType)0.5;
+
+        newest[i] = useNext ? tap2 : tap1;
+        previous[i] = useNext ? tap1 : tap0;
+    }
+
+    for (int i = 0; i < numSamples; i++){
+        SampleType delay = 1 - fractions[i];
+        delay += (delay < (SampleType)0.5) ? (SampleType)1 : (SampleType)0;
+
+        coefficients[i] = (1 - delay) / (1 + delay);
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void interpolateSinc(const SampleType* const* taps, int numTaps, const SampleType* __restrict table, int numPhases,
+                               int* __restrict rows, SampleType* __restrict fractions, SampleType* __restrict destination, int numSamples)
+{
+    /** reuse the index and fraction arrays for the table row and the position between rows */
+    for (int i = 0; i < numSamples; i++){
+        const SampleType position = fractions[i] * numPhases;
+        const int row = (int)position < numPhases - 1 ? (int)position : numPhases - 1;
+        rows[i] = row * numTaps;
+        fractions[i] = position - row;
+    }
+
+    for (int i = 0; i < numSamples; i++){
+        destination[i] = 0;
+    }
+
+    for (int k = 0; k < numTaps; k++){
+        const SampleType* tap = taps[k];
+
+        for (int i = 0; i < numSamples; i++){
+            const SampleType lower = table[rows[i] + k];
+            const SampleType upper = table[rows[i] + numTaps + k];
+            destination[i] += (lower + fractions[i] * (upper - lower)) * tap[i];
+        }
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void mixRamp(SampleType* output, const SampleType* delayed, const float* wetAmounts, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        output[i] = output[i] * (SampleType)(1 - wetAmounts[i]) + delayed[i] * (SampleType)wetAmounts[i];
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void mixConstant(SampleType* output, const SampleType* delayed, SampleType dry, SampleType wet, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        output[i] = output[i] * dry + delayed[i] * wet;
+    }
+}
+
+template <typename SampleType>
+KP_KERNEL void writeWithFeedback(SampleType* __restrict buffer, int mask, int stride, int writeHead, const SampleType* __restrict input, const SampleType* __restrict delayed,
+                                 SampleType& feedbackState, const float* feedbackAmounts, int numSamples)
+{
+    SampleType state = feedbackState;
+
+    for (int i = 0; i < numSamples; i++){
+        buffer[((writeHead + i) & mask) * stride] = input[i] + state;
+        state = delayed[i] * (SampleType)feedbackAmounts[i];
+    }
+
+    feedbackState = state;
+}
+
+//==============================================================================
+KP_KERNEL void lfoWavetable(const float* __restrict table, int tableSize, const float* phases, float* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        const float position = phases[i] * tableSize;
+        int index = (int)position;
+        const float fraction = position - index;
+
+        /** phases of exactly 1 are allowed by the accumulator */
+        if (index >= tableSize){
+            index -= tableSize;
+        }
+
+        output[i] = table[index] + fraction * (table[index + 1] - table[index]);
+    }
+}
+
+/** fold a phase (0 to 1) onto -0.25..0.25 so that sin(2 pi phase) == sin(2 pi folded) */
+KP_KERNEL inline float foldPhase(float phase)
+{
+    float folded = phase;
+    if (folded > 0.75f){
+        folded -= 1.0f;
+    }
+    else if (folded > 0.25f){
+        folded = 0.5f - folded;
+    }
+    return folded;
+}
+
+/** odd Taylor polynomial for sin(x) on -pi/2..pi/2, worst error about 4e-6 */
+KP_KERNEL inline float polySine(float folded)
+{
+    const float x = juce::MathConstants<float>::twoPi * folded;
+    const float x2 = x * x;
+    return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
+KP_KERNEL void lfoPolynomial(int waveform, const float* phases, float* output, int numSamples)
+{
+    switch (waveform){
+        case LFO::kTriangle:
+            for (int i = 0; i < numSamples; i++){
+                output[i] = 4.0f * foldPhase(phases[i]);
+            }
+            break;
+
+        case LFO::kSoftSquare:
+            for (int i = 0; i < numSamples; i++){
+                const float square = 8.0f * foldPhase(phases[i]);
+                output[i] = square < -1.0f ? -1.0f : (1.0f < square ? 1.0f : square);
+            }
+            break;
+
+        default:
+            for (int i = 0; i < numSamples; i++){
+                output[i] = polySine(foldPhase(phases[i]));
+            }
+            break;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+const DspKernels::SampleKernels<SampleType> sampleKernels =
+{
+    &readLinear<SampleType>,
+    &readLinearAndAdd<SampleType>,
+    &splitPositions<SampleType>,
+    &gatherTap<SampleType>,
+    &interpolateHermite<SampleType>,
+    &interpolateLagrange3<SampleType>,
+    &interpolateLagrange5<SampleType>,
+    &thiranCoefficients<SampleType>,
+    &interpolateSinc<SampleType>,
+    &mixRamp<SampleType>,
+    &mixConstant<SampleType>,
+    &writeWithFeedback<SampleType>
+};
+
+const DspKernels::LFOKernels lfoKernels =
+{
+    &lfoWavetable,
+    &lfoPolynomial
+};
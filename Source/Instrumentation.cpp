@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    Instrumentation.cpp
+    Created: 17 Oct 2026 11:14:26pm
+
+  ==============================================================================
+*/
+
+#include "Instrumentation.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+namespace
+{
+    int getHighestBit(juce::uint64 value)
+    {
+        const auto high = (juce::uint32)(value >> 32);
+        return high != 0 ? 32 + juce::findHighestSetBit(high) : juce::findHighestSetBit((juce::uint32)value);
+    }
+}
+
+//==============================================================================
+Instrumentation::Instrumentation()
+    : mFifo(kNumRecords)
+{
+    mPendingParameterChanges = 0;
+    mPendingDenormalFlushes = 0;
+
+    mNumBlocks = 0;
+    mNumSamples = 0;
+    mProcessTicks = 0;
+    mParameterChanges = 0;
+    mDenormalFlushes = 0;
+    mDroppedRecords = 0;
+    mWorstCycles = 0;
+
+    for (auto& count : mCycleHistogram){
+        count = 0;
+    }
+    for (auto& count : mBlockSizeHistogram){
+        count = 0;
+    }
+
+    mIsRecordingBlocks = false;
+}
+
+Instrumentation::BlockStart Instrumentation::startBlock() const
+{
+    BlockStart start;
+    start.ticks = juce::Time::getHighResolutionTicks();
+    start.cycles = readCycles(start.ticks);
+    return start;
+}
+
+void Instrumentation::endBlock(const BlockStart& start, int numSamples)
+{
+    BlockRecord record;
+    const juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+    record.cycles = readCycles(endTicks) - start.cycles;
+    const juce::int64 ticks = endTicks - start.ticks;
+
+    record.seconds = juce::Time::highResolutionTicksToSeconds(ticks);
+    record.numSamples = numSamples;
+    record.parameterChanges = mPendingParameterChanges;
+    record.denormalFlushes = mPendingDenormalFlushes;
+
+    mPendingParameterChanges = 0;
+    mPendingDenormalFlushes = 0;
+
+    add(mNumBlocks, (juce::int64)1);
+    add(mNumSamples, (juce::int64)numSamples);
+    add(mProcessTicks, ticks);
+    add(mParameterChanges, (juce::int64)record.parameterChanges);
+    add(mDenormalFlushes, (juce::int64)record.denormalFlushes);
+    add(mCycleHistogram[getCycleBucket(record.cycles)], (juce::int64)1);
+    add(mBlockSizeHistogram[juce::jmin(kNumBlockSizeBuckets - 1, getHighestBit((juce::uint64)juce::jmax(1, numSamples)))], (juce::int64)1);
+
+    if (record.cycles > mWorstCycles.load(std::memory_order_relaxed)){
+        mWorstCycles.store(record.cycles, std::memory_order_relaxed);
+    }
+
+    if (! mIsRecordingBlocks.load(std::memory_order_relaxed)){
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0){
+        add(mDroppedRecords, (juce::int64)1);
+        return;
+    }
+
+    mRecords[size1 > 0 ? start1 : start2] = record;
+    mFifo.finishedWrite(1);
+}
+
+//==============================================================================
+void Instrumentation::setRecordingBlocks(bool shouldRecord)
+{
+    if (shouldRecord && ! mIsRecordingBlocks){
+        mFifo.finishedRead(mFifo.getNumReady());
+    }
+
+    mIsRecordingBlocks = shouldRecord;
+}
+
+int Instrumentation::readRecords(BlockRecord* destination, int maxNumRecords)
+{
+    int start1, size1, start2, size2;
+    mFifo.prepareToRead(maxNumRecords, start1, size1, start2, size2);
+
+    std::copy(mRecords + start1, mRecords + start1 + size1, destination);
+    std::copy(mRecords + start2, mRecords + start2 + size2, destination + size1);
+
+    mFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+Instrumentation::Summary Instrumentation::getSummary() const
+{
+    Summary summary;
+    summary.numBlocks = mNumBlocks;
+    summary.numSamples = mNumSamples;
+    summary.processSeconds = juce::Time::highResolutionTicksToSeconds(mProcessTicks);
+    summary.worstCycles = mWorstCycles;
+    summary.parameterChanges = mParameterChanges;
+    summary.denormalFlushes = mDenormalFlushes;
+    summary.droppedRecords = mDroppedRecords;
+
+    juce::int64 histogram[kNumCycleBuckets];
+    juce::int64 numCounted = 0;
+
+    for (int bucket = 0; bucket < kNumCycleBuckets; bucket++){
+        histogram[bucket] = mCycleHistogram[bucket];
+        numCounted += histogram[bucket];
+    }
+
+    /** percentiles are reported as the top of the bucket they fall in, within a quarter octave */
+    juce::int64 cumulative = 0;
+
+    for (int bucket = 0; bucket < kNumCycleBuckets && numCounted > 0; bucket++){
+        const bool belowMedian = (cumulative * 2 < numCounted);
+        const bool belowP99 = (cumulative * 100 < numCounted * 99);
+        cumulative += histogram[bucket];
+
+        if (belowMedian && cumulative * 2 >= numCounted){
+            summary.medianCycles = getCycleBucketLimit(bucket);
+        }
+        if (belowP99 && cumulative * 100 >= numCounted * 99){
+            summary.p99Cycles = getCycleBucketLimit(bucket);
+        }
+    }
+
+    /** the worst block is known exactly, so no percentile is reported above it */
+    summary.medianCycles = juce::jmin(summary.medianCycles, summary.worstCycles);
+    summary.p99Cycles = juce::jmin(summary.p99Cycles, summary.worstCycles);
+
+    for (const auto& count : mBlockSizeHistogram){
+        summary.blockSizeCounts.push_back(count);
+    }
+
+    return summary;
+}
+
+juce::var Instrumentation::Summary::toVar() const
+{
+    auto* blockSizes = new juce::DynamicObject();
+
+    for (int bucket = 0; bucket < (int)blockSizeCounts.size(); bucket++){
+        if (blockSizeCounts[(size_t)bucket] > 0){
+            blockSizes->setProperty(juce::Identifier(juce::String(1 << bucket)), blockSizeCounts[(size_t)bucket]);
+        }
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("version", kFileVersion);
+    root->setProperty("cycleSource", getCycleSource());
+    root->setProperty("numBlocks", numBlocks);
+    root->setProperty("numSamples", numSamples);
+    root->setProperty("processSeconds", processSeconds);
+    root->setProperty("worstCycles", (juce::int64)worstCycles);
+    root->setProperty("medianCycles", (juce::int64)medianCycles);
+    root->setProperty("p99Cycles", (juce::int64)p99Cycles);
+    root->setProperty("parameterChanges", parameterChanges);
+    root->setProperty("denormalFlushes", denormalFlushes);
+    root->setProperty("droppedRecords", droppedRecords);
+    root->setProperty("blockSizes", juce::var(blockSizes));
+
+    return juce::var(root);
+}
+
+juce::String Instrumentation::toJSON() const
+{
+    return juce::JSON::toString(getSummary().toVar());
+}
+
+juce::String Instrumentation::getCycleSource()
+{
+   #if JUCE_INTEL
+    return "tsc";
+   #else
+    return "ticks";
+   #endif
+}
+
+//==============================================================================
+juce::uint64 Instrumentation::readCycles(juce::int64 ticks)
+{
+   #if JUCE_INTEL
+    juce::ignoreUnused(ticks);
+    return __rdtsc();
+   #else
+    /** the clock was just read, a second read would only add its cost to every block */
+    return (juce::uint64)ticks;
+   #endif
+}
+
+int Instrumentation::getCycleBucket(juce::uint64 cycles)
+{
+    /** 0 to 3 get a bucket each, above that the octave and the next two bits pick one of four */
+    if (cycles < 4){
+        return (int)cycles;
+    }
+
+    const int octave = getHighestBit(cycles);
+    const int quarter = (int)((cycles >> (octave - 2)) & 3);
+
+    return juce::jmin(kNumCycleBuckets - 1, 4 * (octave - 1) + quarter);
+}
+
+juce::uint64 Instrumentation::getCycleBucketLimit(int bucket)
+{
+    if (bucket < 4){
+        return (juce::uint64)bucket;
+    }
+
+    const int octave = bucket / 4 + 1;
+    const int quarter = bucket % 4;
+
+    /** the last cycle count that lands in the bucket */
+    return ((juce::uint64)(5 + quarter) << (octave - 2)) - 1;
+}
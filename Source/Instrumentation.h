@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    Instrumentation.h
+    Created: 17 Oct 2026 11:14:26pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    What each processBlock call costs, measured on the audio thread.
+
+    Every block adds its cycle count to a log-spaced histogram, for the worst case
+    and the 99th percentile, and its size to a histogram of block sizes. It also
+    counts the parameter changes the block picked up and the feedback values it
+    flushed out of the subnormal range. While a reader is attached, each block is
+    also written to a ring buffer as a BlockRecord, for a live meter.
+
+    The audio thread is the only writer. Every counter is a plain atomic load and
+    store, with no read-modify-write and no lock, so recording a block is wait-free.
+    The ring buffer is a single-producer, single-consumer juce::AbstractFifo. When it
+    is full the block is counted as dropped instead of waiting.
+
+    Cycles come from the time-stamp counter on Intel and from the high-resolution
+    tick counter elsewhere, see getCycleSource().
+*/
+class Instrumentation
+{
+public:
+
+    /** one processBlock call */
+    struct BlockRecord
+    {
+        juce::uint64 cycles = 0;
+        double seconds = 0;
+        int numSamples = 0;
+        int parameterChanges = 0;
+        int denormalFlushes = 0;
+    };
+
+    /** counts since construction. The counters are read one by one while the audio thread
+        may be writing, so a summary can be a block out between fields */
+    struct Summary
+    {
+        juce::int64 numBlocks = 0;
+        juce::int64 numSamples = 0;
+        double processSeconds = 0;
+
+        juce::uint64 worstCycles = 0;
+        juce::uint64 medianCycles = 0;
+        juce::uint64 p99Cycles = 0;
+
+        juce::int64 parameterChanges = 0;
+        juce::int64 denormalFlushes = 0;
+        juce::int64 droppedRecords = 0;
+
+        /** blocks per power-of-two size, blockSizeCounts[k] counts sizes 2^k up to 2^(k+1) - 1 */
+        std::vector<juce::int64> blockSizeCounts;
+
+        /** as a versioned JSON object, with the cycle source and the block size histogram */
+        juce::var toVar() const;
+    };
+
+    static constexpr int kNumRecords = 1024;
+
+    /** four buckets per octave of cycles, up to 2^40 */
+    static constexpr int kNumCycleBuckets = 160;
+
+    /** block sizes 1 to 16384 and longer */
+    static constexpr int kNumBlockSizeBuckets = 15;
+
+    Instrumentation();
+
+    //==============================================================================
+    /** taken at the start of a block, handed back to endBlock */
+    struct BlockStart
+    {
+        juce::uint64 cycles = 0;
+        juce::int64 ticks = 0;
+    };
+
+    /** audio thread only */
+    BlockStart startBlock() const;
+    void addParameterChanges(int numChanges)        { mPendingParameterChanges += numChanges; }
+    void addDenormalFlushes(int numFlushes)         { mPendingDenormalFlushes += numFlushes; }
+    void endBlock(const BlockStart& start, int numSamples);
+
+    //==============================================================================
+    /** blocks are only written to the ring buffer while this is on. Turning it on from the
+        reader's thread skips whatever is left from earlier, so the reader starts fresh */
+    void setRecordingBlocks(bool shouldRecord);
+
+    /** copy up to maxNumRecords of the oldest unread blocks, returns how many were copied.
+        Call from one thread only, the thread that turned recording on */
+    int readRecords(BlockRecord* destination, int maxNumRecords);
+
+    /** safe from any thread */
+    Summary getSummary() const;
+    juce::String toJSON() const;
+
+    /** "tsc" or "ticks", the unit of the cycle counts */
+    static juce::String getCycleSource();
+
+private:
+
+    static constexpr int kFileVersion = 1;
+
+    /** the cycle counter, or elsewhere than Intel the ticks just read */
+    static juce::uint64 readCycles(juce::int64 ticks);
+    static int getCycleBucket(juce::uint64 cycles);
+    static juce::uint64 getCycleBucketLimit(int bucket);
+
+    /** single-writer increment, a load and a store rather than a locked add */
+    template <typename Type>
+    static void add(std::atomic<Type>& counter, Type amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /** counts of the block in progress, only touched by the audio thread */
+    int mPendingParameterChanges;
+    int mPendingDenormalFlushes;
+
+    std::atomic<juce::int64> mNumBlocks;
+    std::atomic<juce::int64> mNumSamples;
+    std::atomic<juce::int64> mProcessTicks;
+    std::atomic<juce::int64> mParameterChanges;
+    std::atomic<juce::int64> mDenormalFlushes;
+    std::atomic<juce::int64> mDroppedRecords;
+    std::atomic<juce::uint64> mWorstCycles;
+
+    std::atomic<juce::int64> mCycleHistogram[kNumCycleBuckets];
+    std::atomic<juce::int64> mBlockSizeHistogram[kNumBlockSizeBuckets];
+
+    /** Ring Buffer Data */
+    std::atomic<bool> mIsRecordingBlocks;
+    juce::AbstractFifo mFifo;
+    BlockRecord mRecords[kNumRecords];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Instrumentation)
+};
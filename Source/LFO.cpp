@@ -0,0 +1,315 @@
+/*
+  ==============================================================================
+
+    LFO.cpp
+    Created: 17 Oct 2026 9:12:04am
+
+  ==============================================================================
+*/
+
+#include "LFO.h"
+#include "DspKernels.h"
+
+namespace
+{
+    constexpr int kTableSize = 2048;
+    constexpr int kTableHarmonics = 64;
+    constexpr juce::uint32 kRandomSeed = 0x12345678;
+
+    /** the naive shapes, aligned with the sine so 0 phase is a rising zero crossing */
+    inline float naiveShape(LFO::Waveform waveform, float phase)
+    {
+        float shape;
+        DspKernels::getLFOKernels(DspKernels::kGeneric).polynomial(waveform, &phase, &shape, 1);
+        return shape;
+    }
+
+    /** one table per periodic waveform, built once by keeping the first harmonics of the naive shape */
+    struct Wavetables
+    {
+        Wavetables()
+        {
+            for (int w = 0; w < LFO::kSmoothedRandom; w++){
+                std::vector<double> naive (kTableSize);
+                for (int i = 0; i < kTableSize; i++){
+                    naive[i] = (w == LFO::kSine) ? std::sin(juce::MathConstants<double>::twoPi * i / kTableSize)
+                                                 : naiveShape((LFO::Waveform)w, (float)i / kTableSize);
+                }
+
+                /** the shapes are odd and quarter-wave symmetric, so only sine terms are needed */
+                std::vector<double> bandLimited (kTableSize, 0.0);
+                for (int h = 1; h <= kTableHarmonics; h++){
+                    double coefficient = 0;
+                    for (int i = 0; i < kTableSize; i++){
+                        coefficient += naive[i] * std::sin(juce::MathConstants<double>::twoPi * h * i / kTableSize);
+                    }
+                    coefficient *= 2.0 / kTableSize;
+
+                    for (int i = 0; i < kTableSize; i++){
+                        bandLimited[i] += coefficient * std::sin(juce::MathConstants<double>::twoPi * h * i / kTableSize);
+                    }
+                }
+
+                /** normalise the peak back to 1 after removing the upper harmonics */
+                double peak = 0;
+                for (auto v : bandLimited){
+                    peak = juce::jmax(peak, std::abs(v));
+                }
+
+                for (int i = 0; i < kTableSize; i++){
+                    tables[w][i] = (float)(bandLimited[i] / peak);
+                }
+                tables[w][kTableSize] = tables[w][0];
+            }
+        }
+
+        float tables[LFO::kSmoothedRandom][kTableSize + 1];
+    };
+
+    const Wavetables& getWavetables()
+    {
+        static const Wavetables wavetables;
+        return wavetables;
+    }
+}
+
+//==============================================================================
+LFO::LFO()
+{
+    mBackend = kWavetable;
+    mWaveform = kSine;
+
+    /** build the tables and pick the instruction set now rather than on the audio thread */
+    getWavetables();
+    DspKernels::getIsa();
+
+    reset();
+}
+
+void LFO::setBackend(Backend newBackend)
+{
+    mBackend = newBackend;
+}
+
+LFO::Backend LFO::getBackend() const
+{
+    return mBackend;
+}
+
+void LFO::setWaveform(Waveform newWaveform)
+{
+    mWaveform = newWaveform;
+}
+
+LFO::Waveform LFO::getWaveform() const
+{
+    return mWaveform;
+}
+
+void LFO::reset()
+{
+    mRandomState = kRandomSeed;
+    mRandomFrom = 0;
+    mRandomTo = nextRandomValue();
+    mLastPhase = 0;
+}
+
+juce::StringArray LFO::getWaveformNames()
+{
+    return { "Sine", "Triangle", "Soft Square", "Smoothed Random" };
+}
+
+//==============================================================================
+void LFO::process(const float* phases, float* output, int numSamples)
+{
+    if (numSamples <= 0){
+        return;
+    }
+
+    if (mWaveform == kSmoothedRandom){
+        processSmoothedRandom(phases, output, numSamples);
+        return;
+    }
+
+    /** the quadrature and std::sin backends only produce a sine, the other shapes come from the polynomial path */
+    switch (mBackend){
+        case kWavetable:
+            processWavetable(phases, output, numSamples);
+            break;
+
+        case kQuadrature:
+            if (mWaveform == kSine){
+                processQuadrature(phases, output, numSamples);
+            } else {
+                processPolynomial(phases, output, numSamples);
+            }
+            break;
+
+        case kStdSine:
+            if (mWaveform == kSine){
+                processStdSine(phases, output, numSamples);
+            } else {
+                processPolynomial(phases, output, numSamples);
+            }
+            break;
+
+        case kPolynomial:
+        default:
+            processPolynomial(phases, output, numSamples);
+            break;
+    }
+
+    mLastPhase = phases[numSamples - 1];
+}
+
+void LFO::processWavetable(const float* phases, float* output, int numSamples)
+{
+    DspKernels::getLFO().wavetable(getWavetables().tables[mWaveform], kTableSize, phases, output, numSamples);
+}
+
+void LFO::processQuadrature(const float* phases, float* output, int numSamples)
+{
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+
+    /** resync to the exact phase once per block so rounding errors cannot accumulate */
+    double sine = std::sin(twoPi * phases[0]);
+    double cosine = std::cos(twoPi * phases[0]);
+    float previousPhase = phases[0];
+
+    output[0] = (float)sine;
+
+    /** while the rate and phase offset hold still the phase takes the same step or two, apart by the
+        rounding of the float phases, so the rotation of each step is worked out once and kept for the
+        rest of the block. Ramps bring new steps, which replace the oldest */
+    constexpr int kNumSteps = 4;
+    float steps[kNumSteps];
+    double cosSteps[kNumSteps];
+    double sinSteps[kNumSteps];
+    int numSteps = 0;
+    int oldestStep = 0;
+
+    for (int i = 1; i < numSamples; i++){
+        /** the increment follows rate smoothing and phase offset changes, unwrapped at the 1 -> 0 step.
+            The output may be the phases, so the previous phase is kept before it is overwritten */
+        float increment = phases[i] - previousPhase;
+        if (increment < -0.5f){
+            increment += 1.0f;
+        }
+        previousPhase = phases[i];
+
+        int step = 0;
+        while (step < numSteps && steps[step] != increment){
+            step++;
+        }
+
+        if (step == numSteps){
+            if (numSteps < kNumSteps){
+                numSteps++;
+            } else {
+                step = oldestStep;
+                oldestStep = (oldestStep + 1) % kNumSteps;
+            }
+
+            steps[step] = increment;
+            cosSteps[step] = std::cos(twoPi * increment);
+            sinSteps[step] = std::sin(twoPi * increment);
+        }
+
+        /** an exact rotation in double precision, it stays on the unit circle to far below float rounding */
+        const double newSine = sine * cosSteps[step] + cosine * sinSteps[step];
+        cosine = cosine * cosSteps[step] - sine * sinSteps[step];
+        sine = newSine;
+
+        output[i] = (float)sine;
+    }
+}
+
+void LFO::processPolynomial(const float* phases, float* output, int numSamples)
+{
+    DspKernels::getLFO().polynomial(mWaveform, phases, output, numSamples);
+}
+
+void LFO::processStdSine(const float* phases, float* output, int numSamples)
+{
+    for (int i = 0; i < numSamples; i++){
+        output[i] = sin(juce::MathConstants<double>::twoPi * phases[i]);
+    }
+}
+
+void LFO::processSmoothedRandom(const float* phases, float* output, int numSamples)
+{
+    /** a new random target is drawn on every cycle, and a smoothstep glides towards it */
+    for (int i = 0; i < numSamples; i++){
+        const float phase = phases[i];
+
+        if (phase < mLastPhase){
+            mRandomFrom = mRandomTo;
+            mRandomTo = nextRandomValue();
+        }
+        mLastPhase = phase;
+
+        const float smoothed = phase * phase * (3.0f - 2.0f * phase);
+        output[i] = mRandomFrom + smoothed * (mRandomTo - mRandomFrom);
+    }
+}
+
+float LFO::nextRandomValue()
+{
+    /** xorshift32, cheap and deterministic so renders are repeatable */
+    mRandomState ^= mRandomState << 13;
+    mRandomState ^= mRandomState >> 17;
+    mRandomState ^= mRandomState << 5;
+
+    return (mRandomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+//==============================================================================
+juce::String LFO::createBackendReport(int numSamples)
+{
+    const char* backendNames[] = { "Wavetable", "Quadrature", "Polynomial", "std::sin" };
+
+    /** a 20 Hz sweep at 44.1 kHz, rendered in 512-sample blocks like the processor does */
+    const int blockSize = 512;
+    std::vector<float> phases (numSamples);
+    std::vector<float> output (numSamples);
+
+    float phase = 0;
+    for (int i = 0; i < numSamples; i++){
+        phases[i] = phase;
+        phase += 20.0f / 44100.0f;
+        if (phase > 1){
+            phase -= 1;
+        }
+    }
+
+    juce::String report;
+    report << "Backend       max |error|    ns/sample\n";
+
+    for (int b = 0; b < kNumBackends; b++){
+        LFO lfo;
+        lfo.setBackend((Backend)b);
+
+        /** warm up once so table construction and cold caches are not timed */
+        lfo.process(phases.data(), output.data(), juce::jmin(blockSize, numSamples));
+        lfo.reset();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        for (int i = 0; i < numSamples; i += blockSize){
+            lfo.process(phases.data() + i, output.data() + i, juce::jmin(blockSize, numSamples - i));
+        }
+        const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+        double maxError = 0;
+        for (int i = 0; i < numSamples; i++){
+            maxError = juce::jmax(maxError, std::abs(output[i] - std::sin(juce::MathConstants<double>::twoPi * phases[i])));
+        }
+
+        const double nsPerSample = 1.0e9 * juce::Time::highResolutionTicksToSeconds(elapsed) / numSamples;
+
+        report << juce::String(backendNames[b]).paddedRight(' ', 14)
+               << juce::String(maxError, 9).paddedRight(' ', 15)
+               << juce::String(nsPerSample, 2) << "\n";
+    }
+
+    return report;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    LFO.h
+    Created: 17 Oct 2026 9:12:04am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Block-based LFO used by the chorus/flanger.
+
+    The processor keeps its own phase accumulator, so the LFO turns an array of
+    phases (0 to 1) into an array of outputs (-1 to 1). Several backends trade
+    accuracy against cost, see createBackendReport() and the README for numbers.
+*/
+class LFO
+{
+public:
+
+    enum Backend
+    {
+        kWavetable = 0,     // band-limited table, linear interpolation
+        kQuadrature,        // coupled-form recursive oscillator, resynced every block
+        kPolynomial,        // odd polynomial on the folded phase
+        kStdSine,           // std::sin in double precision, same as the reference path
+        kNumBackends
+    };
+
+    enum Waveform
+    {
+        kSine = 0,
+        kTriangle,
+        kSoftSquare,
+        kSmoothedRandom,
+        kNumWaveforms
+    };
+
+    LFO();
+
+    void setBackend(Backend newBackend);
+    Backend getBackend() const;
+
+    void setWaveform(Waveform newWaveform);
+    Waveform getWaveform() const;
+
+    /** restart the smoothed random sequence, call together with resetting the phase */
+    void reset();
+
+    /** render one output per phase, output may point to the same array as phases */
+    void process(const float* phases, float* output, int numSamples);
+
+    /** render each backend against std::sin and return a table of worst-case error and cost */
+    static juce::String createBackendReport(int numSamples = 1 << 16);
+
+    static juce::StringArray getWaveformNames();
+
+private:
+
+    void processWavetable(const float* phases, float* output, int numSamples);
+    void processQuadrature(const float* phases, float* output, int numSamples);
+    void processPolynomial(const float* phases, float* output, int numSamples);
+    void processStdSine(const float* phases, float* output, int numSamples);
+    void processSmoothedRandom(const float* phases, float* output, int numSamples);
+
+    float nextRandomValue();
+
+    Backend mBackend;
+    Waveform mWaveform;
+
+    /** Smoothed Random Data */
+    juce::uint32 mRandomState;
+    float mRandomFrom;
+    float mRandomTo;
+    float mLastPhase;
+
+    JUCE_LEAK_DETECTOR (LFO)
+};
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    ModulationTrace.cpp
+    Created: 17 Oct 2026 11:58:41pm
+
+  ==============================================================================
+*/
+
+#include "ModulationTrace.h"
+
+ModulationTrace::ModulationTrace()
+    : mFifo(kNumPoints)
+{
+    mIsActive = false;
+}
+
+void ModulationTrace::push(const Point& point)
+{
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 + size2 == 0){
+        return;
+    }
+
+    mPoints[size1 > 0 ? start1 : start2] = point;
+    mFifo.finishedWrite(1);
+}
+
+void ModulationTrace::setActive(bool shouldBeActive)
+{
+    if (shouldBeActive && ! mIsActive){
+        mFifo.finishedRead(mFifo.getNumReady());
+    }
+
+    mIsActive = shouldBeActive;
+}
+
+int ModulationTrace::read(Point* destination, int maxNumPoints)
+{
+    int start1, size1, start2, size2;
+    mFifo.prepareToRead(maxNumPoints, start1, size1, start2, size2);
+
+    std::copy(mPoints + start1, mPoints + start1 + size1, destination);
+    std::copy(mPoints + start2, mPoints + start2 + size2, destination + size1);
+
+    mFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
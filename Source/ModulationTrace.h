@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    ModulationTrace.h
+    Created: 17 Oct 2026 11:58:41pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Delay times the audio thread hands to the editor's LFO display.
+
+    While a reader is attached, the processor writes a Point every few
+    milliseconds of audio into a single-producer, single-consumer
+    juce::AbstractFifo. Writing is wait-free. When the reader falls behind, points
+    are dropped rather than waited for. While nothing is attached,
+    isActive() is false and the processor skips the trace entirely.
+*/
+class ModulationTrace
+{
+public:
+
+    /** the first and last channel, the two ends of the phase offset spread */
+    static constexpr int kNumTracedChannels = 2;
+
+    static constexpr int kNumPoints = 512;
+
+    /** points per second of audio, whatever the sample rate and block size */
+    static constexpr double kPointsPerSecond = 120.0;
+
+    struct Point
+    {
+        float delayMs[kNumTracedChannels] = {};
+    };
+
+    ModulationTrace();
+
+    /** audio thread */
+    bool isActive() const           { return mIsActive.load(std::memory_order_relaxed); }
+    void push(const Point& point);
+
+    /** turning the trace on from the reader's thread skips whatever is left from earlier */
+    void setActive(bool shouldBeActive);
+
+    /** copy up to maxNumPoints of the oldest unread points, returns how many were copied.
+        Call from one thread only, the thread that turned the trace on */
+    int read(Point* destination, int maxNumPoints);
+
+private:
+
+    std::atomic<bool> mIsActive;
+    juce::AbstractFifo mFifo;
+    Point mPoints[kNumPoints];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModulationTrace)
+};
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    ModulationVisualiser.cpp
+    Created: 18 Oct 2026 12:06:33am
+
+  ==============================================================================
+*/
+
+#include "ModulationVisualiser.h"
+#include "PluginProcessor.h"
+
+ModulationVisualiser::ModulationVisualiser(ModulationTrace& trace)
+    : mTrace(trace)
+{
+    mReadBuffer.allocate(ModulationTrace::kNumPoints, true);
+    mHistory.allocate(kHistoryLength, true);
+    mHistoryStart = 0;
+    mHistorySize = 0;
+
+    /** nothing behind the plot shows through */
+    setOpaque(true);
+
+    mTrace.setActive(true);
+    startTimerHz(kRefreshRateHz);
+}
+
+ModulationVisualiser::~ModulationVisualiser()
+{
+    stopTimer();
+    mTrace.setActive(false);
+}
+
+void ModulationVisualiser::timerCallback()
+{
+    const int numRead = mTrace.read(mReadBuffer, ModulationTrace::kNumPoints);
+
+    if (numRead == 0){
+        return;
+    }
+
+    /** append to the ring, overwriting the oldest points once it is full */
+    for (int i = 0; i < numRead; i++){
+        if (mHistorySize < kHistoryLength){
+            mHistory[(mHistoryStart + mHistorySize) % kHistoryLength] = mReadBuffer[i];
+            mHistorySize++;
+        } else {
+            mHistory[mHistoryStart] = mReadBuffer[i];
+            mHistoryStart = (mHistoryStart + 1) % kHistoryLength;
+        }
+    }
+
+    repaint();
+}
+
+void ModulationVisualiser::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId).darker(0.3f));
+
+    const auto bounds = getLocalBounds().toFloat().reduced(2.f);
+
+    /** the whole chorus range, so a flanger sweep sits low and short */
+    const float maxDelayMs = 1000.f * MAX_DELAY_TIME;
+
+    const juce::Colour colours[ModulationTrace::kNumTracedChannels] = { juce::Colours::orange, juce::Colours::skyblue };
+
+    for (int channel = ModulationTrace::kNumTracedChannels - 1; channel >= 0; channel--){
+        juce::Path path;
+
+        for (int i = 0; i < mHistorySize; i++){
+            const auto& point = mHistory[(mHistoryStart + i) % kHistoryLength];
+            const float x = bounds.getX() + bounds.getWidth() * i / (float)(kHistoryLength - 1);
+            const float y = bounds.getBottom() - bounds.getHeight() * juce::jlimit(0.f, 1.f, point.delayMs[channel] / maxDelayMs);
+
+            if (i == 0){
+                path.startNewSubPath(x, y);
+            } else {
+                path.lineTo(x, y);
+            }
+        }
+
+        g.setColour(colours[channel]);
+        g.strokePath(path, juce::PathStrokeType(1.5f));
+    }
+
+    g.setColour(juce::Colours::white.withAlpha(0.7f));
+    g.setFont(12.0f);
+    g.drawText("Delay " + juce::String(maxDelayMs, 0) + " ms", getLocalBounds().reduced(4), juce::Justification::topLeft);
+}
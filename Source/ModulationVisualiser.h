@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ModulationVisualiser.h
+    Created: 18 Oct 2026 12:06:33am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ModulationTrace.h"
+
+//==============================================================================
+/**
+    A scrolling plot of the delay time of the first and last channel, the LFO
+    as the delay line hears it.
+
+    Points come from the processor's ModulationTrace. The display attaches to the
+    trace while it exists. It polls at a capped rate and only repaints its own
+    bounds, and only when new points have arrived. A stopped transport or an
+    idle plugin costs one empty read per tick.
+*/
+class ModulationVisualiser : public juce::Component,
+                             private juce::Timer
+{
+public:
+
+    static constexpr int kRefreshRateHz = 30;
+
+    /** about two seconds of points */
+    static constexpr int kHistoryLength = 256;
+
+    explicit ModulationVisualiser(ModulationTrace& trace);
+    ~ModulationVisualiser() override;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+
+    void timerCallback() override;
+
+    ModulationTrace& mTrace;
+
+    /** points read this tick, then the history as a ring, mHistoryStart is the oldest */
+    juce::HeapBlock<ModulationTrace::Point> mReadBuffer;
+    juce::HeapBlock<ModulationTrace::Point> mHistory;
+    int mHistoryStart;
+    int mHistorySize;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ModulationVisualiser)
+};
@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+    Oversampler.cpp
+    Created: 17 Oct 2026 9:58:31pm
+
+  ==============================================================================
+*/
+
+#include "Oversampler.h"
+
+namespace
+{
+    /** 63 taps for the first stage, flat to about 0.4 of the base rate. Later stages get 31 */
+    constexpr int kFirstStageCoefficients = 16;
+    constexpr int kLaterStageCoefficients = 8;
+
+    /** Kaiser window shape, about 80 dB of image rejection */
+    constexpr double kKaiserBeta = 8.0;
+
+    double besselI0(double x)
+    {
+        double sum = 1;
+        double term = 1;
+
+        for (int k = 1; k < 32; k++){
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    /** the nonzero half-band taps right of the centre, at odd distances 1, 3, 5 ... from it.
+        Normalised so the filter has exactly unity gain at DC */
+    template <typename SampleType>
+    void designHalfBand(SampleType* coefficients, int numCoefficients)
+    {
+        const double halfLength = 2.0 * numCoefficients;
+        double values[32];
+        double sum = 0;
+
+        for (int j = 0; j < numCoefficients; j++){
+            const double m = 2 * j + 1;
+            const double sinc = std::sin(M_PI * m / 2.0) / (M_PI * m / 2.0);
+            const double ratio = m / halfLength;
+            const double window = besselI0(kKaiserBeta * std::sqrt(1.0 - ratio * ratio)) / besselI0(kKaiserBeta);
+
+            values[j] = 0.5 * sinc * window;
+            sum += values[j];
+        }
+
+        /** the centre tap is 0.5 and each side tap appears twice */
+        for (int j = 0; j < numCoefficients; j++){
+            coefficients[j] = (SampleType)(values[j] * 0.25 / sum);
+        }
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+BasicOversampler<SampleType>::BasicOversampler()
+{
+    mNumChannels = 0;
+    mMaxNumSamples = 0;
+    mBranchCapacity = 0;
+    mFactorIndex = 0;
+
+    for (int s = 0; s < kMaxFactorIndex; s++){
+        auto& stage = mStages[s];
+        stage.numCoefficients = (s == 0) ? kFirstStageCoefficients : kLaterStageCoefficients;
+        designHalfBand(stage.coefficients, stage.numCoefficients);
+
+        /** a stage delays by 2 * numCoefficients - 1 samples at its input rate, 1 << s times the base rate */
+        const int stageFactor = 1 << s;
+        stage.alignment = (stageFactor - (2 * stage.numCoefficients - 1) % stageFactor) % stageFactor;
+        jassert(stage.alignment <= 1);
+    }
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::prepare(int numChannels, int maxNumSamples)
+{
+    mNumChannels = juce::jmax(1, numChannels);
+    mMaxNumSamples = juce::jmax(1, maxNumSamples);
+
+    /** the buffers keep their memory when they shrink, so preparing again for the same or a
+        smaller format does not allocate */
+    for (int s = 0; s < kMaxFactorIndex; s++){
+        auto& stage = mStages[s];
+        const int stageInputSize = mMaxNumSamples << s;
+        const int history = 2 * stage.numCoefficients;
+
+        stage.upInput.setSize(mNumChannels, history + stageInputSize, false, false, true);
+        stage.output.setSize(mNumChannels, 2 * stageInputSize, false, false, true);
+        stage.downEven.setSize(mNumChannels, history + stageInputSize, false, false, true);
+        stage.downOdd.setSize(mNumChannels, history + stageInputSize, false, false, true);
+    }
+
+    if (mMaxNumSamples > mBranchCapacity){
+        mBranch.allocate((size_t)(mMaxNumSamples << (kMaxFactorIndex - 1)), true);
+        mBranchCapacity = mMaxNumSamples;
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::releaseMemory()
+{
+    for (auto& stage : mStages){
+        stage.upInput.setSize(0, 0);
+        stage.output.setSize(0, 0);
+        stage.downEven.setSize(0, 0);
+        stage.downOdd.setSize(0, 0);
+    }
+
+    mBranch.free();
+    mBranchCapacity = 0;
+    mMaxNumSamples = 0;
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::reset()
+{
+    for (auto& stage : mStages){
+        stage.upInput.clear();
+        stage.output.clear();
+        stage.downEven.clear();
+        stage.downOdd.clear();
+    }
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::setFactorIndex(int newFactorIndex)
+{
+    newFactorIndex = juce::jlimit(0, (int)kMaxFactorIndex, newFactorIndex);
+
+    if (newFactorIndex != mFactorIndex){
+        mFactorIndex = newFactorIndex;
+        reset();
+    }
+}
+
+template <typename SampleType>
+double BasicOversampler<SampleType>::getLatencyInSamples() const
+{
+    /** the up and down filters of a stage each delay by half their length at the higher rate,
+        together 2 * numCoefficients - 1 samples at the stage's lower rate */
+    double latency = 0;
+
+    for (int s = 0; s < mFactorIndex; s++){
+        latency += (2 * mStages[s].numCoefficients - 1 + mStages[s].alignment) / (double)(1 << s);
+    }
+    return latency;
+}
+
+template <typename SampleType>
+SampleType* const* BasicOversampler<SampleType>::upsample(const SampleType* const* input, int startSample, int numSamples)
+{
+    jassert(mFactorIndex > 0 && numSamples <= mMaxNumSamples);
+
+    for (int channel = 0; channel < mNumChannels; channel++){
+        const SampleType* stageInput = input[channel] + startSample;
+
+        for (int s = 0; s < mFactorIndex; s++){
+            SampleType* stageOutput = mStages[s].output.getWritePointer(channel);
+            upsampleStage(mStages[s], channel, stageInput, stageOutput, numSamples << s);
+            stageInput = stageOutput;
+        }
+    }
+
+    return mStages[mFactorIndex - 1].output.getArrayOfWritePointers();
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::downsample(SampleType* const* output, int startSample, int numSamples)
+{
+    jassert(mFactorIndex > 0 && numSamples <= mMaxNumSamples);
+
+    for (int channel = 0; channel < mNumChannels; channel++){
+        for (int s = mFactorIndex - 1; s >= 0; s--){
+            SampleType* stageOutput = (s == 0) ? output[channel] + startSample : mStages[s - 1].output.getWritePointer(channel);
+            downsampleStage(mStages[s], channel, mStages[s].output.getReadPointer(channel), stageOutput, numSamples << s);
+        }
+    }
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::upsampleStage(Stage& stage, int channel, const SampleType* input, SampleType* output, int numSamples)
+{
+    const int numCoefficients = stage.numCoefficients;
+    const int history = 2 * numCoefficients;
+    SampleType* buffer = stage.upInput.getWritePointer(channel);
+    SampleType* branch = mBranch.get();
+
+    juce::FloatVectorOperations::copy(buffer + history, input, numSamples);
+
+    /** even outputs come from the FIR branch, its taps reach back 2 * numCoefficients - 1 inputs,
+        and the alignment reaches one further into the history */
+    juce::FloatVectorOperations::clear(branch, numSamples);
+    const int centreOffset = 1 + numCoefficients - stage.alignment;
+
+    for (int j = 0; j < numCoefficients; j++){
+        const SampleType coefficient = (SampleType)2 * stage.coefficients[j];
+        const SampleType* newer = buffer + centreOffset + j;
+        const SampleType* older = buffer + centreOffset - 1 - j;
+
+        for (int i = 0; i < numSamples; i++){
+            branch[i] += coefficient * (newer[i] + older[i]);
+        }
+    }
+
+    /** odd outputs are the centre tap alone, the input delayed to line up with the branch */
+    const SampleType* centre = buffer + centreOffset;
+
+    for (int i = 0; i < numSamples; i++){
+        output[2 * i] = branch[i];
+        output[2 * i + 1] = centre[i];
+    }
+
+    /** keep the last inputs as the history of the next block */
+    memmove(buffer, buffer + numSamples, (size_t)history * sizeof(SampleType));
+}
+
+template <typename SampleType>
+void BasicOversampler<SampleType>::downsampleStage(Stage& stage, int channel, const SampleType* input, SampleType* output, int numSamples)
+{
+    const int numCoefficients = stage.numCoefficients;
+    const int history = 2 * numCoefficients;
+    SampleType* even = stage.downEven.getWritePointer(channel);
+    SampleType* odd = stage.downOdd.getWritePointer(channel);
+
+    /** numSamples is the output length, the input is twice as long */
+    for (int i = 0; i < numSamples; i++){
+        even[history + i] = input[2 * i];
+        odd[history + i] = input[2 * i + 1];
+    }
+
+    /** the centre tap lands on the odd samples, the branch on the even ones */
+    const SampleType* centre = odd + history - numCoefficients;
+
+    for (int i = 0; i < numSamples; i++){
+        output[i] = (SampleType)0.5 * centre[i];
+    }
+
+    for (int j = 0; j < numCoefficients; j++){
+        const SampleType coefficient = stage.coefficients[j];
+        const SampleType* newer = even + 1 + numCoefficients + j;
+        const SampleType* older = even + numCoefficients - j;
+
+        for (int i = 0; i < numSamples; i++){
+            output[i] += coefficient * (newer[i] + older[i]);
+        }
+    }
+
+    memmove(even, even + numSamples, (size_t)history * sizeof(SampleType));
+    memmove(odd, odd + numSamples, (size_t)history * sizeof(SampleType));
+}
+
+template <typename SampleType>
+juce::StringArray BasicOversampler<SampleType>::getFactorNames()
+{
+    return { "1x", "2x", "4x", "8x" };
+}
+
+template class BasicOversampler<float>;
+template class BasicOversampler<double>;
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    Oversampler.h
+    Created: 17 Oct 2026 9:58:31pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    2x, 4x or 8x oversampling built from a cascade of 2x half-band stages.
+
+    Each stage is a linear-phase FIR half-band filter run in polyphase form. Every
+    other coefficient of a half-band filter is zero and the centre one is 0.5, so
+    upsampling needs one symmetric FIR branch plus a plain delay, and downsampling
+    needs the same branch on the even samples plus the delayed odd samples. The
+    branch is a sum of coefficient times a pair of samples over the whole block,
+    which vectorises. The first stage has the sharpest filter, later stages only
+    have to reject images far above the audio band and use half the taps.
+
+    All buffers are sized for 8x in prepare(), so the factor can change at any time
+    without allocating. The filters run in the sample type of the signal, with
+    coefficients rounded from the same double-precision design.
+*/
+template <typename SampleType>
+class BasicOversampler
+{
+public:
+
+    static constexpr int kMaxFactorIndex = 3;
+    static constexpr int kMaxFactor = 1 << kMaxFactorIndex;
+
+    BasicOversampler();
+
+    /** allocate for numChannels and blocks of up to maxNumSamples at the base rate,
+        reusing the memory of an earlier prepare when it is large enough */
+    void prepare(int numChannels, int maxNumSamples);
+
+    /** hand the buffers back, prepare allocates them again */
+    void releaseMemory();
+
+    /** clear the filter histories */
+    void reset();
+
+    /** 0 is 1x, 1 is 2x, 2 is 4x and 3 is 8x. A change of factor clears the filter histories */
+    void setFactorIndex(int newFactorIndex);
+    int getFactorIndex() const  { return mFactorIndex; }
+    int getFactor() const       { return 1 << mFactorIndex; }
+
+    /** delay of the up and down filters together, in samples at the base rate. Always a whole
+        number, so the latency reported to the host is exact */
+    double getLatencyInSamples() const;
+
+    /** upsample numSamples of every channel, returns the channels at the oversampled rate,
+        getFactor() * numSamples long. Process them in place, then call downsample() */
+    SampleType* const* upsample(const SampleType* const* input, int startSample, int numSamples);
+
+    /** downsample the processed channels back into output, numSamples at the base rate */
+    void downsample(SampleType* const* output, int startSample, int numSamples);
+
+    static juce::StringArray getFactorNames();
+
+private:
+
+    /** nonzero coefficients on each side of the centre tap */
+    static constexpr int kMaxCoefficients = 16;
+
+    struct Stage
+    {
+        int numCoefficients = 0;
+        SampleType coefficients[kMaxCoefficients] = {};
+
+        /** samples of delay added to the stage's input, at its input rate, so that its latency at the
+            base rate is a whole number of samples. At most 1, the upsampler history has one to spare */
+        int alignment = 0;
+
+        /** upsampler input with its history in front */
+        juce::AudioBuffer<SampleType> upInput;
+
+        /** oversampled output of the upsampler, processed in place, then the downsampler's input */
+        juce::AudioBuffer<SampleType> output;
+
+        /** even and odd downsampler input samples, each with its history in front */
+        juce::AudioBuffer<SampleType> downEven;
+        juce::AudioBuffer<SampleType> downOdd;
+    };
+
+    void upsampleStage(Stage& stage, int channel, const SampleType* input, SampleType* output, int numSamples);
+    void downsampleStage(Stage& stage, int channel, const SampleType* input, SampleType* output, int numSamples);
+
+    Stage mStages[kMaxFactorIndex];
+
+    /** even outputs of an upsampler stage before they are interleaved */
+    juce::HeapBlock<SampleType> mBranch;
+
+    int mNumChannels;
+    int mMaxNumSamples;
+    int mBranchCapacity;
+    int mFactorIndex;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BasicOversampler)
+};
+
+/** the plugin's own precision, and where the factors and shared constants are read from */
+using Oversampler = BasicOversampler<float>;
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    ParameterAttachments.cpp
+    Created: 17 Oct 2026 11:52:08pm
+
+  ==============================================================================
+*/
+
+#include "ParameterAttachments.h"
+
+//==============================================================================
+ParameterAttachments::Attachment::Attachment(ParameterAttachments& o, juce::RangedAudioParameter& p)
+    : owner(o), parameter(p)
+{
+    parameter.addListener(this);
+}
+
+ParameterAttachments::Attachment::~Attachment()
+{
+    parameter.removeListener(this);
+}
+
+void ParameterAttachments::Attachment::parameterValueChanged(int parameterIndex, float newValue)
+{
+    /** only flags, the value itself is read again on the message thread */
+    needsUpdate.store(true, std::memory_order_release);
+    owner.mAnyNeedsUpdate.store(true, std::memory_order_release);
+}
+
+void ParameterAttachments::Attachment::updateComponent()
+{
+    const float plainValue = parameter.convertFrom0to1(parameter.getValue());
+
+    /** setValue and setSelectedItemIndex repaint their own component only, and only if the value moved */
+    if (slider != nullptr){
+        slider->setValue(plainValue, juce::dontSendNotification);
+    }
+
+    if (comboBox != nullptr){
+        comboBox->setSelectedItemIndex(juce::roundToInt(plainValue - parameter.getNormalisableRange().start), juce::dontSendNotification);
+    }
+}
+
+void ParameterAttachments::Attachment::setPlainValue(float plainValue)
+{
+    const float newValue = parameter.convertTo0to1(plainValue);
+
+    if (newValue != parameter.getValue()){
+        parameter.setValueNotifyingHost(newValue);
+    }
+}
+
+//==============================================================================
+ParameterAttachments::ParameterAttachments(juce::AudioProcessor& processor)
+    : mProcessor(processor)
+{
+    mAnyNeedsUpdate = false;
+    startTimerHz(kRefreshRateHz);
+}
+
+ParameterAttachments::~ParameterAttachments()
+{
+    stopTimer();
+}
+
+void ParameterAttachments::attach(juce::Slider& slider, const juce::String& parameterID)
+{
+    auto* parameter = findParameter(parameterID);
+    if (parameter == nullptr){
+        return;
+    }
+
+    mAttachments.push_back(std::make_unique<Attachment>(*this, *parameter));
+    auto* attachment = mAttachments.back().get();
+    attachment->slider = &slider;
+
+    const auto& range = parameter->getNormalisableRange();
+    slider.setRange(range.start, range.end);
+    attachment->updateComponent();
+
+    slider.onValueChange = [attachment] { attachment->setPlainValue((float)attachment->slider->getValue()); };
+
+    slider.onDragStart = [attachment] {
+        attachment->isDragging = true;
+        attachment->parameter.beginChangeGesture();
+    };
+
+    slider.onDragEnd = [attachment] {
+        attachment->parameter.endChangeGesture();
+        attachment->isDragging = false;
+
+        /** catch up with anything the host sent during the drag */
+        attachment->updateComponent();
+    };
+}
+
+void ParameterAttachments::attach(juce::ComboBox& comboBox, const juce::String& parameterID)
+{
+    auto* parameter = findParameter(parameterID);
+    if (parameter == nullptr){
+        return;
+    }
+
+    mAttachments.push_back(std::make_unique<Attachment>(*this, *parameter));
+    auto* attachment = mAttachments.back().get();
+    attachment->comboBox = &comboBox;
+    attachment->updateComponent();
+
+    comboBox.onChange = [attachment] {
+        const float plainValue = attachment->parameter.getNormalisableRange().start + attachment->comboBox->getSelectedItemIndex();
+
+        attachment->parameter.beginChangeGesture();
+        attachment->setPlainValue(plainValue);
+        attachment->parameter.endChangeGesture();
+    };
+}
+
+void ParameterAttachments::timerCallback()
+{
+    if (! mAnyNeedsUpdate.exchange(false, std::memory_order_acquire)){
+        return;
+    }
+
+    for (auto& attachment : mAttachments){
+        if (attachment->isDragging){
+            continue;
+        }
+
+        if (attachment->needsUpdate.exchange(false, std::memory_order_acquire)){
+            attachment->updateComponent();
+        }
+    }
+}
+
+juce::RangedAudioParameter* ParameterAttachments::findParameter(const juce::String& parameterID) const
+{
+    for (auto* parameter : mProcessor.getParameters()){
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)){
+            if (ranged->paramID == parameterID){
+                return ranged;
+            }
+        }
+    }
+
+    jassertfalse;
+    return nullptr;
+}
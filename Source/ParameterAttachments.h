@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    ParameterAttachments.h
+    Created: 17 Oct 2026 11:52:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Keeps the editor's sliders and combo boxes in step with the processor's
+    parameters, in both directions.
+
+    Host automation can set a parameter from any thread, the audio thread included.
+    The listener callback only sets two atomic flags, one on the parameter's
+    attachment and one shared by all of them, so it never locks or allocates. A
+    timer on the message thread checks the shared flag at a capped rate and
+    updates only the components whose parameter changed since the last tick. Any
+    number of changes between ticks collapse into one update with the latest value,
+    and a tick with nothing to do costs one atomic exchange.
+
+    The updates do not send notifications, so they never echo back into the
+    parameter. Going the other way, a component only sets its parameter when the
+    value actually differs, and drags and combo box choices are wrapped in change
+    gestures for the host.
+*/
+class ParameterAttachments : private juce::Timer
+{
+public:
+
+    /** the most UI updates per second, whatever the automation rate */
+    static constexpr int kRefreshRateHz = 30;
+
+    explicit ParameterAttachments(juce::AudioProcessor& processor);
+    ~ParameterAttachments() override;
+
+    /** parameterID must name a parameter of the processor. The slider takes the
+        parameter's range and current value */
+    void attach(juce::Slider& slider, const juce::String& parameterID);
+
+    /** the combo box's item indices are the parameter's plain values, counted from the
+        start of its range. Add the items before attaching */
+    void attach(juce::ComboBox& comboBox, const juce::String& parameterID);
+
+private:
+
+    struct Attachment : public juce::AudioProcessorParameter::Listener
+    {
+        Attachment(ParameterAttachments& owner, juce::RangedAudioParameter& parameter);
+        ~Attachment() override;
+
+        /** may be called on any thread */
+        void parameterValueChanged(int parameterIndex, float newValue) override;
+        void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override {}
+
+        /** message thread, copy the parameter into the component */
+        void updateComponent();
+
+        /** message thread, copy a plain value from the component into the parameter */
+        void setPlainValue(float plainValue);
+
+        ParameterAttachments& owner;
+        juce::RangedAudioParameter& parameter;
+
+        juce::Slider* slider = nullptr;
+        juce::ComboBox* comboBox = nullptr;
+
+        /** true while the user drags the slider, host updates wait until the drag ends */
+        bool isDragging = false;
+
+        std::atomic<bool> needsUpdate { false };
+    };
+
+    void timerCallback() override;
+
+    /** nullptr, and an assertion, if the processor has no parameter with that ID */
+    juce::RangedAudioParameter* findParameter(const juce::String& parameterID) const;
+
+    juce::AudioProcessor& mProcessor;
+    std::vector<std::unique_ptr<Attachment>> mAttachments;
+
+    /** set by any attachment's listener, so an idle tick does not visit every attachment */
+    std::atomic<bool> mAnyNeedsUpdate;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterAttachments)
+};
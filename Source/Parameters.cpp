@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    Parameters.cpp
+    Created: 17 Oct 2026 7:12:05pm
+
+  ==============================================================================
+*/
+
+#include "Parameters.h"
+
+namespace
+{
+    /** dry/wet and feedback only need to hide zipper noise. Depth, rate and phase offset
+        ramp slower, close to the ~0.2 s the old one-pole smoothers took at 44.1 kHz, so
+        sweeping them still sounds like a gradual change of the modulation */
+    constexpr double kRampTimesMs[ParameterSmoothers::kNumSmoothers] = { 20.0, 50.0, 200.0, 200.0, 20.0 };
+}
+
+//==============================================================================
+int ParameterSnapshot::countChangesFrom(const ParameterSnapshot& other) const
+{
+    return (int)(dryWet != other.dryWet) + (int)(depth != other.depth) + (int)(rate != other.rate)
+         + (int)(phaseOffset != other.phaseOffset) + (int)(feedback != other.feedback)
+         + (int)(type != other.type) + (int)(waveform != other.waveform) + (int)(interpolation != other.interpolation)
+         + (int)(oversampling != other.oversampling) + (int)(offlineOversampling != other.offlineOversampling)
+         + (int)(voices != other.voices) + (int)(morph != other.morph) + (int)(morphTarget != other.morphTarget)
+         + (int)(tempoSync != other.tempoSync) + (int)(noteValue != other.noteValue)
+         + (int)(minDelayTime != other.minDelayTime) + (int)(maxDelayTime != other.maxDelayTime);
+}
+
+//==============================================================================
+ParameterSmoothers::ParameterSmoothers()
+{
+}
+
+void ParameterSmoothers::prepare(double sampleRate, const ParameterSnapshot& snapshot)
+{
+    for (int i = 0; i < kNumSmoothers; i++){
+        mSmoothers[i].reset(sampleRate, kRampTimesMs[i] / 1000.0);
+    }
+
+    reset(snapshot);
+}
+
+void ParameterSmoothers::reset(const ParameterSnapshot& snapshot)
+{
+    for (int i = 0; i < kNumSmoothers; i++){
+        mSmoothers[i].setCurrentAndTargetValue(getValue(snapshot, (Index)i));
+    }
+}
+
+void ParameterSmoothers::setTargets(const ParameterSnapshot& snapshot)
+{
+    for (int i = 0; i < kNumSmoothers; i++){
+        mSmoothers[i].setTargetValue(getValue(snapshot, (Index)i));
+    }
+}
+
+bool ParameterSmoothers::fillRamp(Index index, float* destination, int numSamples)
+{
+    auto& smoother = mSmoothers[index];
+
+    if (! smoother.isSmoothing()){
+        juce::FloatVectorOperations::fill(destination, smoother.getTargetValue(), numSamples);
+        return false;
+    }
+
+    for (int i = 0; i < numSamples; i++){
+        destination[i] = smoother.getNextValue();
+    }
+    return true;
+}
+
+double ParameterSmoothers::getRampTimeMs(Index index)
+{
+    return kRampTimesMs[index];
+}
+
+float ParameterSmoothers::getValue(const ParameterSnapshot& snapshot, Index index)
+{
+    switch (index){
+        case kDryWet:       return snapshot.dryWet;
+        case kDepth:        return snapshot.depth;
+        case kRate:         return snapshot.rate;
+        case kPhaseOffset:  return snapshot.phaseOffset;
+        case kFeedback:     return snapshot.feedback;
+        default:            break;
+    }
+
+    jassertfalse;
+    return 0;
+}
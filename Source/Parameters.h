@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    Parameters.h
+    Created: 17 Oct 2026 7:12:05pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TempoSync.h"
+
+//==============================================================================
+/**
+    Plain values of every parameter, read once per block.
+
+    Each AudioParameter read is an atomic load, which the compiler cannot hoist out
+    of a sample loop. Taking one snapshot up front gives the DSP ordinary floats and
+    guarantees the whole block sees the same set of values.
+*/
+struct ParameterSnapshot
+{
+    float dryWet = 0.5f;
+    float depth = 0.5f;
+    float rate = 10.f;
+    float phaseOffset = 0.f;
+    float feedback = 0.5f;
+
+    int type = 0;
+    int waveform = 0;
+    int interpolation = 0;
+
+    /** oversampling factor indices for live playback and for offline renders */
+    int oversampling = 0;
+    int offlineOversampling = 0;
+
+    /** delay taps per channel, each with its own LFO phase, depth and pan */
+    int voices = 1;
+
+    /** how far the DSP moves towards the morph target, a preset bank index */
+    float morph = 0.f;
+    int morphTarget = 0;
+
+    /** the LFO phase follows the host's timeline at a note value, instead of free-running at rate */
+    int tempoSync = 0;
+    int noteValue = TempoSync::kDefaultNoteValue;
+
+    /** the delay range the LFO sweeps in seconds, set by a morph between presets of different Types.
+        Left at 0 the Type's own range is used, see ChorusFlangerEngine::getDelayRange(). Not a parameter */
+    float minDelayTime = 0.f;
+    float maxDelayTime = 0.f;
+
+    /** how many values differ from other, for the instrumentation's parameter change count */
+    int countChangesFrom(const ParameterSnapshot& other) const;
+};
+
+/** MIDI controller numbers that move the continuous parameters, on any channel */
+namespace MidiControllers
+{
+    constexpr int kDepth = 1;           // mod wheel
+    constexpr int kRate = 12;           // effect control 1
+    constexpr int kFeedback = 13;       // effect control 2
+    constexpr int kPhaseOffset = 14;
+    constexpr int kDryWet = 93;         // chorus send level
+
+    constexpr int kAll[] = { kDepth, kRate, kFeedback, kPhaseOffset, kDryWet };
+}
+
+//==============================================================================
+/**
+    Linear ramps for the continuous parameters.
+
+    New targets are taken once per block from a ParameterSnapshot. The ramps then
+    advance sample by sample in straight segments, so a change lands at the same
+    sample whatever the block size. Ramp times are given in milliseconds, so the
+    smoothing sounds the same at every sample rate.
+*/
+class ParameterSmoothers
+{
+public:
+
+    enum Index
+    {
+        kDryWet = 0,
+        kDepth,
+        kRate,
+        kPhaseOffset,
+        kFeedback,
+        kNumSmoothers
+    };
+
+    ParameterSmoothers();
+
+    /** set the ramp lengths for a sample rate and jump straight to the snapshot values */
+    void prepare(double sampleRate, const ParameterSnapshot& snapshot);
+
+    /** jump straight to the snapshot values, without a ramp */
+    void reset(const ParameterSnapshot& snapshot);
+
+    /** start ramping towards the snapshot values from wherever each ramp is now */
+    void setTargets(const ParameterSnapshot& snapshot);
+
+    float getNextValue(Index index)     { return mSmoothers[index].getNextValue(); }
+    float getTargetValue(Index index) const  { return mSmoothers[index].getTargetValue(); }
+    bool isSmoothing(Index index) const { return mSmoothers[index].isSmoothing(); }
+
+    /** write the next numSamples values of one ramp into destination, returns false if they are all the target value */
+    bool fillRamp(Index index, float* destination, int numSamples);
+
+    /** ramp time of each smoother in milliseconds */
+    static double getRampTimeMs(Index index);
+
+    /** the value one smoother takes from a snapshot */
+    static float getValue(const ParameterSnapshot& snapshot, Index index);
+
+private:
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> mSmoothers[kNumSmoothers];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterSmoothers)
+};
@@ -11,115 +11,188 @@
 
 //==============================================================================
 KPChorusFlangerAudioProcessorEditor::KPChorusFlangerAudioProcessorEditor (KPChorusFlangerAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      mParameterAttachments (p),
+      mModulationVisualiser (p.getModulationTrace())
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (600,445);
-    
-    auto& params = processor.getParameters();
-    
-    
-    
-    juce::AudioParameterFloat* dryWetParameter = (juce::AudioParameterFloat*)params.getUnchecked(0);
+    setSize (600,635);
     
+    /** the attachments set each control's range and value, follow host automation and write the
+        user's changes back, see ParameterAttachments */
     mDryWetSlider.setBounds(10,0, 180,180);
     mDryWetSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
     mDryWetSlider.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxBelow, true, 65, 20);
-    mDryWetSlider.setRange(dryWetParameter->range.start, dryWetParameter->range.end);
-    mDryWetSlider.setValue(*dryWetParameter);
+    mParameterAttachments.attach(mDryWetSlider, "drywet");
     addAndMakeVisible(mDryWetSlider);
     
-    mDryWetSlider.onValueChange = [this, dryWetParameter] { *dryWetParameter  = mDryWetSlider.getValue();};
-    mDryWetSlider.onDragStart = [dryWetParameter] {dryWetParameter->beginChangeGesture();};
-    mDryWetSlider.onDragEnd = [dryWetParameter] {dryWetParameter->endChangeGesture();};
-    
     
     
-
-    juce::AudioParameterFloat* depthParameter = (juce::AudioParameterFloat*)params.getUnchecked(1);
     
     mDepthSlider.setBounds(210,0, 180,180);
     mDepthSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
     mDepthSlider.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxBelow, true, 65, 20);
-    mDepthSlider.setRange(depthParameter->range.start, depthParameter->range.end);
-    mDepthSlider.setValue(*depthParameter);
+    mParameterAttachments.attach(mDepthSlider, "depth");
     addAndMakeVisible(mDepthSlider);
     
-    mDepthSlider.onValueChange = [this, depthParameter] { *depthParameter  = mDepthSlider.getValue();};
-    mDepthSlider.onDragStart = [depthParameter] {depthParameter->beginChangeGesture();};
-    mDepthSlider.onDragEnd = [depthParameter] {depthParameter->endChangeGesture();};
     
     
     
-    
-    juce::AudioParameterFloat* rateParameter = (juce::AudioParameterFloat*)params.getUnchecked(2);
-    
     mRateSlider.setBounds(410,0, 180,180);
     mRateSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
     mRateSlider.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxBelow, true, 65, 20);
-    mRateSlider.setRange(rateParameter->range.start, rateParameter->range.end);
-    mRateSlider.setValue(*rateParameter);
+    mParameterAttachments.attach(mRateSlider, "rate");
     addAndMakeVisible(mRateSlider);
     
-    mRateSlider.onValueChange = [this, rateParameter] { *rateParameter  = mRateSlider.getValue();};
-    mRateSlider.onDragStart = [rateParameter] {rateParameter->beginChangeGesture();};
-    mRateSlider.onDragEnd = [rateParameter] {rateParameter->endChangeGesture();};
-    
     
     
-    juce::AudioParameterFloat* phaseParameter = (juce::AudioParameterFloat*)params.getUnchecked(3);
     
     mPhaseOffsetSlider.setBounds(10,220, 180,180);
     mPhaseOffsetSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
     mPhaseOffsetSlider.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxBelow, true, 65, 20);
-    mPhaseOffsetSlider.setRange(phaseParameter->range.start, phaseParameter->range.end);
-    mPhaseOffsetSlider.setValue(*phaseParameter);
+    mParameterAttachments.attach(mPhaseOffsetSlider, "phaseoffset");
     addAndMakeVisible(mPhaseOffsetSlider);
     
-    mPhaseOffsetSlider.onValueChange = [this, phaseParameter] { *phaseParameter  = mPhaseOffsetSlider.getValue();};
-    mPhaseOffsetSlider.onDragStart = [phaseParameter] {phaseParameter->beginChangeGesture();};
-    mPhaseOffsetSlider.onDragEnd = [phaseParameter] {phaseParameter->endChangeGesture();};
     
     
     
-    
-    juce::AudioParameterFloat* feedbackParameter = (juce::AudioParameterFloat*)params.getUnchecked(4);
-    
     mFeedbackSlider.setBounds(410, 220, 180,180);
     mFeedbackSlider.setSliderStyle(juce::Slider::SliderStyle::RotaryVerticalDrag);
     mFeedbackSlider.setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxBelow, true, 65, 20);
-    mFeedbackSlider.setRange(feedbackParameter->range.start, feedbackParameter->range.end);
-    mFeedbackSlider.setValue(*feedbackParameter);
+    mParameterAttachments.attach(mFeedbackSlider, "feedback");
     addAndMakeVisible(mFeedbackSlider);
     
-    mFeedbackSlider.onValueChange = [this, feedbackParameter] { *feedbackParameter  = mFeedbackSlider.getValue();};
-    mFeedbackSlider.onDragStart = [feedbackParameter] {feedbackParameter->beginChangeGesture();};
-    mFeedbackSlider.onDragEnd = [feedbackParameter] {feedbackParameter->endChangeGesture();};
-    
     
     
     
-    juce::AudioParameterInt* typeParameter = (juce::AudioParameterInt*)params.getUnchecked(5);
-
     mType.setBounds(240, 280, 120, 40);
     mType.addItem("Chorus",1);
     mType.addItem("Flanger",2);
+    mParameterAttachments.attach(mType, "type");
     addAndMakeVisible(mType);
     
-    mType.onChange = [this, typeParameter] {
-        typeParameter->beginChangeGesture();
-        *typeParameter = mType.getSelectedItemIndex();
-        typeParameter->endChangeGesture();
-    };
     
-    mType.setSelectedItemIndex(*typeParameter);
     
     
+    mWaveform.setBounds(240, 340, 120, 40);
+    mWaveform.addItemList(LFO::getWaveformNames(), 1);
+    mParameterAttachments.attach(mWaveform, "waveform");
+    addAndMakeVisible(mWaveform);
+    
+    
+    
+    
+    mInterpolation.setBounds(240, 400, 120, 40);
+    mInterpolation.addItemList(DelayLineReader::getModeNames(), 1);
+    mParameterAttachments.attach(mInterpolation, "interpolation");
+    addAndMakeVisible(mInterpolation);
+    
+    
+    
+    
+    /** live and offline oversampling side by side, the offline factor is used while the host bounces */
+    mOversampling.setBounds(160, 455, 120, 40);
+    mOfflineOversampling.setBounds(320, 455, 120, 40);
+    
+    for (int i = 0; i < Oversampler::getFactorNames().size(); i++){
+        mOversampling.addItem("Live " + Oversampler::getFactorNames()[i], i + 1);
+        mOfflineOversampling.addItem("Bounce " + Oversampler::getFactorNames()[i], i + 1);
+    }
+    
+    mParameterAttachments.attach(mOversampling, "oversampling");
+    mParameterAttachments.attach(mOfflineOversampling, "offlineoversampling");
+    addAndMakeVisible(mOversampling);
+    addAndMakeVisible(mOfflineOversampling);
+    
+    
+    
+    
+    /** item IDs are the voice counts, item indices count from the parameter's minimum of 1 */
+    mVoices.setBounds(240, 220, 120, 40);
+    for (int voices = 1; voices <= DelayLineReader::kMaxVoices; voices++){
+        mVoices.addItem(juce::String(voices) + (voices == 1 ? " Voice" : " Voices"), voices);
+    }
+    mParameterAttachments.attach(mVoices, "voices");
+    addAndMakeVisible(mVoices);
+    
+    
+    
+    
+    /** a free rate in Hz, or a note value locked to the host's timeline */
+    mTempoSync.setBounds(160, 505, 120, 40);
+    mTempoSync.addItem("Free Rate", 1);
+    mTempoSync.addItem("Tempo Sync", 2);
+    mParameterAttachments.attach(mTempoSync, "temposync");
+    addAndMakeVisible(mTempoSync);
+    
+    mNoteValue.setBounds(320, 505, 120, 40);
+    mNoteValue.addItemList(TempoSync::getNoteValueNames(), 1);
+    mParameterAttachments.attach(mNoteValue, "notevalue");
+    addAndMakeVisible(mNoteValue);
+    
+    
+    
+    
+    /** the delay time of the first and last channel, along the bottom */
+    mModulationVisualiser.setBounds(10, 555, 580, 70);
+    addAndMakeVisible(mModulationVisualiser);
+    
+    
+    
+    
+    /** the meter sits in the free corner left of the oversampling boxes */
+    mMeterBounds = juce::Rectangle<int>(10, 458, 140, 40);
+    mMeterLoadText = "CPU --";
+    mBlockRecords.allocate(Instrumentation::kNumRecords, true);
+    
+    audioProcessor.getInstrumentation().setRecordingBlocks(true);
+    startTimerHz(10);
 }
 
 KPChorusFlangerAudioProcessorEditor::~KPChorusFlangerAudioProcessorEditor()
 {
+    stopTimer();
+    audioProcessor.getInstrumentation().setRecordingBlocks(false);
+}
+
+void KPChorusFlangerAudioProcessorEditor::timerCallback()
+{
+    auto& instrumentation = audioProcessor.getInstrumentation();
+    const double sampleRate = audioProcessor.getSampleRate();
+    
+    double seconds = 0;
+    double peakLoad = 0;
+    juce::int64 numSamples = 0;
+    int numRecords = 0;
+    
+    /** a full ring buffer is read in more than one go */
+    while (const int numRead = instrumentation.readRecords(mBlockRecords, Instrumentation::kNumRecords)){
+        for (int i = 0; i < numRead; i++){
+            const auto& record = mBlockRecords[i];
+            seconds += record.seconds;
+            numSamples += record.numSamples;
+            
+            if (record.numSamples > 0 && sampleRate > 0){
+                peakLoad = juce::jmax(peakLoad, record.seconds * sampleRate / record.numSamples);
+            }
+        }
+        numRecords += numRead;
+    }
+    
+    /** no blocks since the last tick, the host is stopped or skipping the plugin */
+    if (numRecords == 0 || numSamples == 0 || sampleRate <= 0){
+        mMeterLoadText = "CPU --";
+    } else {
+        const double load = seconds * sampleRate / (double)numSamples;
+        mMeterLoadText = "CPU " + juce::String(100.0 * load, 1) + "%  peak " + juce::String(100.0 * peakLoad, 1) + "%";
+    }
+    
+    const auto summary = instrumentation.getSummary();
+    mMeterCyclesText = "p99 " + juce::String((juce::int64)summary.p99Cycles) + " " + Instrumentation::getCycleSource()
+                     + "/block";
+    
+    repaint(mMeterBounds);
 }
 
 //==============================================================================
@@ -141,6 +214,12 @@ void KPChorusFlangerAudioProcessorEditor::paint (juce::Graphics& g)
     g.drawSingleLineText("Rate", 500,200,juce::Justification::centred);
     g.drawSingleLineText("Phase Offset", 100,420,juce::Justification::centred);
     g.drawSingleLineText("Feedback", 500,420,juce::Justification::centred);
+    
+    g.setColour (juce::Colours::white.withAlpha(0.7f));
+    g.setFont (12.0f);
+    auto meterBounds = mMeterBounds;
+    g.drawText(mMeterLoadText, meterBounds.removeFromTop(20), juce::Justification::centredLeft);
+    g.drawText(mMeterCyclesText, meterBounds, juce::Justification::centredLeft);
 }
 
 void KPChorusFlangerAudioProcessorEditor::resized()
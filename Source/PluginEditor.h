@@ -10,11 +10,14 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "ParameterAttachments.h"
+#include "ModulationVisualiser.h"
 
 //==============================================================================
 /**
 */
-class KPChorusFlangerAudioProcessorEditor  : public juce::AudioProcessorEditor
+class KPChorusFlangerAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                             private juce::Timer
 {
 public:
     KPChorusFlangerAudioProcessorEditor (KPChorusFlangerAudioProcessor&);
@@ -25,6 +28,10 @@ public:
     void resized() override;
 
 private:
+    /** drain the processor's block records into the CPU meter */
+    void timerCallback() override;
+    
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     KPChorusFlangerAudioProcessor& audioProcessor;
@@ -48,6 +55,26 @@ private:
     juce::Slider mFeedbackSlider;
     
     juce::ComboBox mType;
+    juce::ComboBox mVoices;
+    juce::ComboBox mWaveform;
+    juce::ComboBox mInterpolation;
+    juce::ComboBox mOversampling;
+    juce::ComboBox mOfflineOversampling;
+    juce::ComboBox mTempoSync;
+    juce::ComboBox mNoteValue;
+    
+    /** declared after the controls, so they are detached before the controls go */
+    ParameterAttachments mParameterAttachments;
+    
+    ModulationVisualiser mModulationVisualiser;
+    
+    
+    /** CPU Meter Data, the share of each block's duration spent in processBlock since the last
+        timer tick, on average and for the slowest block, and the instrumentation's p99 */
+    juce::HeapBlock<Instrumentation::BlockRecord> mBlockRecords;
+    juce::Rectangle<int> mMeterBounds;
+    juce::String mMeterLoadText;
+    juce::String mMeterCyclesText;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KPChorusFlangerAudioProcessorEditor)
 };
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "StateFormat.h"
 
 //==============================================================================
 KPChorusFlangerAudioProcessor::KPChorusFlangerAudioProcessor()
@@ -61,40 +62,86 @@ KPChorusFlangerAudioProcessor::KPChorusFlangerAudioProcessor()
                                                               1,
                                                               0));
     
-    mPhaseOffsetSmoothed = 0;
-    mRateSmoothed = 0;
-    mDepthSmoothed = 0;
+    addParameter(mWaveformParameter = new juce::AudioParameterInt("waveform",
+                                                                  "Waveform",
+                                                                  0,
+                                                                  LFO::kNumWaveforms - 1,
+                                                                  LFO::kSine));
+    
+    addParameter(mInterpolationParameter = new juce::AudioParameterInt("interpolation",
+                                                                       "Interpolation",
+                                                                       0,
+                                                                       DelayLineReader::kNumModes - 1,
+                                                                       DelayLineReader::kLinear));
+    
+    addParameter(mOversamplingParameter = new juce::AudioParameterInt("oversampling",
+                                                                      "Oversampling",
+                                                                      0,
+                                                                      Oversampler::kMaxFactorIndex,
+                                                                      0));
+    
+    addParameter(mOfflineOversamplingParameter = new juce::AudioParameterInt("offlineoversampling",
+                                                                             "Offline Oversampling",
+                                                                             0,
+                                                                             Oversampler::kMaxFactorIndex,
+                                                                             0));
+    
+    addParameter(mVoicesParameter = new juce::AudioParameterInt("voices",
+                                                                "Voices",
+                                                                1,
+                                                                DelayLineReader::kMaxVoices,
+                                                                1));
+    
+    addParameter(mMorphParameter = new juce::AudioParameterFloat("morph",
+                                                                 "Morph",
+                                                                 0.f,
+                                                                 1.f,
+                                                                 0.f));
+    
+    addParameter(mMorphTargetParameter = new juce::AudioParameterInt("morphtarget",
+                                                                     "Morph Target",
+                                                                     0,
+                                                                     PresetBank::kMaxPresets - 1,
+                                                                     0));
+    
+    addParameter(mTempoSyncParameter = new juce::AudioParameterInt("temposync",
+                                                                   "Tempo Sync",
+                                                                   0,
+                                                                   1,
+                                                                   0));
+    
+    addParameter(mNoteValueParameter = new juce::AudioParameterInt("notevalue",
+                                                                   "Note Value",
+                                                                   0,
+                                                                   TempoSync::getNumNoteValues() - 1,
+                                                                   TempoSync::kDefaultNoteValue));
     
     /** initialize our data to default values */
-    mCircularBufferLeft = nullptr;
-    mCircularBufferRight = nullptr;
-    mCircularBufferWriteHead = 0;
-    mCircularBufferLength = 0;
     mDelayTimeInSamplesLeft = 0;
     mDelayTimeInSamplesRight = 0;
     mDelayReadHeadLeft = 0;
     mDelayReadHeadRight = 0;
     
-    mFeedbackLeft = 0;
-    mFeedbackRight = 0;
-    
     mDryWet = 0.5;
     
-    mLFOPhase = 0;
+    mReleaseMemoryOnStop = false;
+    mEngineLatency = 0;
+    mMovedControllers = 0;
     
+    /** the plugin can be prepared again at any rate up to kMaxSupportedSampleRate and switched to any
+        oversampling factor without allocating */
+    mEngine.setMemoryReservation(kMaxSupportedSampleRate, Oversampler::kMaxFactorIndex);
+    mEngine.setInstrumentation(&mInstrumentation);
+    mEngine.setModulationTrace(&mModulationTrace);
+    
+    /** the user bank is read from disk on first use, hosts create processors just to scan them */
+    mCurrentProgram = 0;
+    mUserBankLoaded = false;
     
 }
 
 KPChorusFlangerAudioProcessor::~KPChorusFlangerAudioProcessor()
 {
-    if (mCircularBufferLeft !=nullptr){
-        delete [] mCircularBufferLeft;
-        mCircularBufferLeft = nullptr;
-    }
-    if (mCircularBufferRight !=nullptr){
-        delete [] mCircularBufferRight;
-        mCircularBufferRight = nullptr;
-    }
 }
 
 //==============================================================================
@@ -132,31 +179,85 @@ bool KPChorusFlangerAudioProcessor::isMidiEffect() const
 
 double KPChorusFlangerAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    const auto snapshot = getParameterSnapshot();
+    
+    if (snapshot.morph > 0){
+        const int target = juce::jmin(snapshot.morphTarget, mPresetBank.getNumPresets() - 1);
+        return mEngine.getTailLengthSeconds(PresetBank::morph(snapshot, mPresetBank.getPreset(target), snapshot.morph));
+    }
+    
+    return mEngine.getTailLengthSeconds(snapshot);
+}
+
+void KPChorusFlangerAudioProcessor::loadUserBankIfNeeded()
+{
+    if (! mUserBankLoaded.exchange(true)){
+        mPresetBank.loadUserBank(PresetBank::getDefaultUserBankFile());
+    }
 }
 
 int KPChorusFlangerAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    loadUserBankIfNeeded();
+    return mPresetBank.getNumPresets();
 }
 
 int KPChorusFlangerAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return mCurrentProgram;
 }
 
 void KPChorusFlangerAudioProcessor::setCurrentProgram (int index)
 {
+    loadUserBankIfNeeded();
+    
+    if (index < 0 || index >= mPresetBank.getNumPresets()){
+        return;
+    }
+    
+    /** a preset recalls the sound. The oversampling would change the latency mid-show, and the
+        morph is a performance control, so those stay as they are */
+    const auto current = getParameterSnapshot();
+    auto preset = mPresetBank.getPreset(index);
+    
+    preset.oversampling = current.oversampling;
+    preset.offlineOversampling = current.offlineOversampling;
+    preset.morph = current.morph;
+    preset.morphTarget = current.morphTarget;
+    
+    mCurrentProgram = index;
+    setParameters(preset);
 }
 
 const juce::String KPChorusFlangerAudioProcessor::getProgramName (int index)
 {
-    return {};
+    loadUserBankIfNeeded();
+    return mPresetBank.getName(index);
 }
 
 void KPChorusFlangerAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    /** saving without loading first would replace the user's bank with an empty one */
+    loadUserBankIfNeeded();
+    
+    if (mPresetBank.renamePreset(index, newName)){
+        mPresetBank.saveUserBank(PresetBank::getDefaultUserBankFile());
+    }
+}
+
+int KPChorusFlangerAudioProcessor::saveUserPreset (const juce::String& name)
+{
+    loadUserBankIfNeeded();
+    
+    const int index = mPresetBank.setUserPreset(name, getParameterSnapshot());
+    
+    if (index >= 0){
+        mPresetBank.saveUserBank(PresetBank::getDefaultUserBankFile());
+        mCurrentProgram = index;
+        updateHostDisplay();
+    }
+    
+    return index;
 }
 
 //==============================================================================
@@ -168,236 +269,366 @@ void KPChorusFlangerAudioProcessor::prepareToPlay (double sampleRate, int sample
     
     /** initialize our data for the current sample rate, and reset things such as phase and writeheads */
     
-    /** initialize the phase */
-    mLFOPhase = 0;
+    /** the morph target can be a user preset, and the audio thread never touches the disk */
+    loadUserBankIfNeeded();
+    
+    /** every output channel gets its own delay line channel and LFO, mono input is widened to the output width */
+    const int numChannels = juce::jlimit(1, (int)DelayLine::kMaxChannels, getTotalNumOutputChannels());
     
-    /** calcualte the circular buffer length */
-    mCircularBufferLength = sampleRate * MAX_DELAY_TIME;
+    /** the ramps start at the current parameter values. The host sets the precision before
+        preparing, only that precision needs memory */
+    mEngine.setParameters(getProcessingSnapshot(getParameterSnapshot()));
+    mEngine.prepare(sampleRate, samplesPerBlock, numChannels, isUsingDoublePrecision());
+    
+    /** a host may still pass fewer channels than the layout, the engine gets spare ones in their place */
+    const bool useDouble = isUsingDoublePrecision();
+    mSpareFloatChannels.setSize(useDouble ? 0 : numChannels, useDouble ? 0 : samplesPerBlock, false, false, true);
+    mSpareDoubleChannels.setSize(useDouble ? numChannels : 0, useDouble ? samplesPerBlock : 0, false, false, true);
+    
+    /** prepareToPlay is never called on the audio thread, the host can be told straight away */
+    mEngineLatency = mEngine.getLatencySamples();
+    setLatencySamples(mEngineLatency);
+    
+}
 
-    /** initialize the left buffer */
-    if (mCircularBufferLeft != nullptr ) {
-       delete [] mCircularBufferLeft;
-       mCircularBufferLeft = nullptr;
-    }
-    if (mCircularBufferLeft ==nullptr){
-        mCircularBufferLeft = new float [(int)mCircularBufferLength];
+void KPChorusFlangerAudioProcessor::reset()
+{
+    /** return every piece of processing state to where a newly constructed processor starts */
+    updateEngineParameters(getParameterSnapshot());
+    mEngine.reset();
+    updateLatency();
+}
+
+void KPChorusFlangerAudioProcessor::advanceModulation (juce::int64 numSamples)
+{
+    /** a synced LFO runs ahead from where the play head is now */
+    updateEngineParameters(getParameterSnapshot());
+    mEngine.updateTimeline(getPlayHead());
+    mEngine.advanceModulation(numSamples);
+}
+
+int KPChorusFlangerAudioProcessor::updateEngineParameters (const ParameterSnapshot& parameters)
+{
+    const auto snapshot = getProcessingSnapshot(parameters);
+    const int numChanges = snapshot.countChangesFrom(mEngine.getParameters());
+    
+    /** most blocks, and nearly every block of a small buffer, change nothing and have nothing to hand on */
+    if (numChanges > 0){
+        mEngine.setParameters(snapshot);
     }
-    /** clear any junk data in new buffer */
-    juce::zeromem(mCircularBufferLeft,mCircularBufferLength * sizeof(float));
     
+    return numChanges;
+}
+
+void KPChorusFlangerAudioProcessor::setUseReferenceProcessing (bool shouldUseReference)
+{
+    mEngine.setUseReferenceProcessing(shouldUseReference);
+    updateLatency();
+}
+
+void KPChorusFlangerAudioProcessor::updateLatency()
+{
+    const int latency = mEngine.getLatencySamples();
     
-    /** initialize the right buffer */
-    if (mCircularBufferRight != nullptr ) {
-       delete [] mCircularBufferRight;
-       mCircularBufferRight = nullptr;
-    }
-    if (mCircularBufferRight ==nullptr){
-        mCircularBufferRight = new float [(int)mCircularBufferLength];
+    /** nearly every block sees the same latency, a plain load keeps a locked exchange out of them */
+    if (mEngineLatency.load(std::memory_order_relaxed) != latency){
+        mEngineLatency.store(latency, std::memory_order_relaxed);
+        triggerAsyncUpdate();
     }
-    /** clear any junk data in new buffer */
-    juce::zeromem(mCircularBufferRight,mCircularBufferLength * sizeof(float));
+}
 
-    /** initialize the write head */
-    mCircularBufferWriteHead = 0;
+void KPChorusFlangerAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(mEngineLatency);
     
+    /** the parameters already hold the controllers' values, the host and the listeners only hear of them here */
+    const auto moved = mMovedControllers.exchange(0);
     
+    for (int controller : MidiControllers::kAll){
+        const auto target = getControllerTarget(controller);
+        
+        if ((moved & target.flag) != 0){
+            target.parameter->setValueNotifyingHost(target.parameter->getValue());
+        }
+    }
+}
 
-    
+bool KPChorusFlangerAudioProcessor::isUsingReferenceProcessing() const
+{
+    return mEngine.isUsingReferenceProcessing();
+}
+
+void KPChorusFlangerAudioProcessor::setLFOBackend (LFO::Backend newBackend)
+{
+    mEngine.setLFOBackend(newBackend);
+}
+
+LFO::Backend KPChorusFlangerAudioProcessor::getLFOBackend() const
+{
+    return mEngine.getLFOBackend();
 }
 
 void KPChorusFlangerAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    
+    /** hosts call this between every stop and start, so the memory is only handed back when asked
+        for and the next prepareToPlay normally reuses it */
+    if (mReleaseMemoryOnStop){
+        mEngine.releaseMemory();
+        mSpareFloatChannels.setSize(0, 0);
+        mSpareDoubleChannels.setSize(0, 0);
+    }
+}
+
+void KPChorusFlangerAudioProcessor::setReleaseMemoryOnStop (bool shouldRelease)
+{
+    mReleaseMemoryOnStop = shouldRelease;
+}
+
+bool KPChorusFlangerAudioProcessor::isReleasingMemoryOnStop() const
+{
+    return mReleaseMemoryOnStop;
 }
 
 //#ifndef JucePlugin_PreferredChannelConfigurations
 bool KPChorusFlangerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
-    //#if JucePlugin_IsMidiEffect
-    //  juce::ignoreUnused (layouts);
-    //  return true;
-    //#else
-      // This is the place where you check if the layout is supported.
-      // In this template code we only support mono or stereo.
-      // Some plugin hosts, such as certain GarageBand versions, will only
-      // load plugins that support stereo bus layouts.
-      /*if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-       && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-          return false;
-      */
-      if (layouts.getMainInputChannelSet() == juce::AudioChannelSet::stereo() &&
-          layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo()) {
-          return true;
-      } else {
-          return false;
-      }
-      
-      // This checks if the input layout matches the output layout
-     /*#if ! JucePlugin_IsSynth
-      if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-          return false;
-     //#endif
-
-      return true;
-    //#endif */
-  }
+    const auto& inputSet = layouts.getMainInputChannelSet();
+    const auto& outputSet = layouts.getMainOutputChannelSet();
+    
+    if (outputSet.isDisabled() || outputSet.size() > DelayLine::kMaxChannels){
+        return false;
+    }
+    
+    /** any matching layout, from mono up to immersive beds, is processed channel for channel */
+    if (inputSet == outputSet){
+        return true;
+    }
+    
+    /** mono in, stereo out: both outputs start from the mono input and the phase offset widens them */
+    return inputSet == juce::AudioChannelSet::mono() && outputSet == juce::AudioChannelSet::stereo();
+}
   //#endif
 
 void KPChorusFlangerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const auto blockStart = mInstrumentation.startBlock();
+    processBlockTemplate(buffer, midiMessages);
+    mInstrumentation.endBlock(blockStart, buffer.getNumSamples());
+}
+
+void KPChorusFlangerAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const auto blockStart = mInstrumentation.startBlock();
+    processBlockTemplate(buffer, midiMessages);
+    mInstrumentation.endBlock(blockStart, buffer.getNumSamples());
+}
+
+bool KPChorusFlangerAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+void KPChorusFlangerAudioProcessor::processBlockTemplate (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
     
+    const int numSamples = buffer.getNumSamples();
     
-
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
+    /** the engine runs the channels it was prepared for. Some hosts pass a buffer with fewer, those
+        run in spare channels instead, which only fit a block up to the prepared size */
+    const int numBufferChannels = buffer.getNumChannels();
+    const int numEngineChannels = mEngine.getNumChannels();
+    auto& spareChannels = getSpareChannels((SampleType*)nullptr);
     
-    /** obtain the left and right audio data pointer */
-    float* leftchannel = buffer.getWritePointer(0);
-    float* rightchannel = buffer.getWritePointer(1);
+    const bool hasChannels = numBufferChannels >= numEngineChannels
+                             || (numBufferChannels > 0 && numSamples <= spareChannels.getNumSamples()
+                                 && numEngineChannels <= spareChannels.getNumChannels());
+    jassert(hasChannels);
     
+    /** obtain the channel data pointers */
+    SampleType* channels[DelayLine::kMaxChannels] = {};
     
-    /** iterate through all the samples in the buffer */
-    for (int i =0; i < buffer.getNumSamples(); i++){
-        
-        /** write into Circular buffer */
-        mCircularBufferLeft[mCircularBufferWriteHead] = leftchannel[i] + mFeedbackLeft;
-        mCircularBufferRight[mCircularBufferWriteHead] = rightchannel[i] + mFeedbackRight;
-        
-        
-        
-        /** generate left channel LFO output */
-        float lfoOutLeft = sin(2*M_PI * mLFOPhase);
-        
-        /** calculate the right channel LFO phase */
-        
-        mPhaseOffsetSmoothed = mPhaseOffsetSmoothed - 0.0001 * (mPhaseOffsetSmoothed - *mPhaseOffsetParameter);
-        float lfoPhaseRight = mLFOPhase + mPhaseOffsetSmoothed;
-        if (lfoPhaseRight >1){
-            lfoPhaseRight -= 1;
-        }
-        /** generate right channel LFO output */
-        float lfoOutRight = sin(2*M_PI * lfoPhaseRight);
-        
-        /** moving LFO phase forward */
-        mRateSmoothed = mRateSmoothed - 0.0001 * (mRateSmoothed - *mRateParameter);
-        mLFOPhase += mRateSmoothed / getSampleRate();
-        if (mLFOPhase >1){
-            mLFOPhase -= 1;
-        }
-        
-        /** calculate the LFO depth */
-        mDepthSmoothed = mDepthSmoothed - 0.0001 * (mDepthSmoothed - *mDepthParameter);
-        lfoOutLeft *= mDepthSmoothed;
-        lfoOutRight *= mDepthSmoothed;
-        float lfoOutMappedLeft = 0;
-        float lfoOutMappedRight = 0;
-        
-        /** map our LFO output to our desired delay times */
-        
-        
-        // **Chorus Effect **//
-        if (mTypeParameter == 0){
-            lfoOutMappedLeft = juce::jmap(lfoOutLeft, -1.f, 1.f, 0.005f, 0.03f);
-            lfoOutMappedRight = juce::jmap(lfoOutRight, -1.f, 1.f, 0.005f, 0.03f);
+    if (hasChannels){
+        for (int channel = 0; channel < numEngineChannels; channel++){
+            channels[channel] = channel < numBufferChannels ? buffer.getWritePointer(channel)
+                                                            : spareChannels.getWritePointer(channel);
         }
         
-        // **Flanger Effect **//
-        else{
-            lfoOutMappedLeft = juce::jmap(lfoOutLeft, -1.f, 1.f, 0.001f, 0.005f);
-            lfoOutMappedRight = juce::jmap(lfoOutRight, -1.f, 1.f, 0.001f, 0.005f);
+        /** a mono input feeding a wider output is copied to every output channel, the per-channel LFO
+            phases then make the copies different. Any other extra outputs, and spare channels in
+            place of inputs the host left out, are cleared */
+        for (auto i = juce::jmin(totalNumInputChannels, numBufferChannels); i < numEngineChannels; ++i){
+            if (totalNumInputChannels == 1){
+                juce::FloatVectorOperations::copy(channels[i], channels[0], numSamples);
+            } else {
+                juce::FloatVectorOperations::clear(channels[i], numSamples);
+            }
         }
-        
-        /** calculate the delay lengths in samples */
-        float delayTimeInSampleLeft = getSampleRate() * lfoOutMappedLeft;
-        float delayTimeInSampleRight = getSampleRate() * lfoOutMappedRight;
-        
-        
-
-
-        
-        //mTimeSmoothed no use now, as the LFO is smoothed waveform
-        //mTimeSmoothed = mTimeSmoothed - 0.0001 * (mTimeSmoothed - lfoOutMapped);
-        
-        /** calculate the left read head position */
-        float delayReadHeadLeft = mCircularBufferWriteHead - delayTimeInSampleLeft;
-        if (delayReadHeadLeft < 0){
-            delayReadHeadLeft += mCircularBufferLength;
+    }
+    
+    /** one parameter read per block, the ramps towards the new values run inside the block. A new
+        oversampling factor waits in the engine until the next prepare, reset or idle block */
+    auto parameters = getParameterSnapshot();
+    mInstrumentation.addParameterChanges(updateEngineParameters(parameters));
+    
+    /** a synced LFO takes its position from the host's timeline */
+    mEngine.updateTimeline(getPlayHead());
+    
+    /** an idle block still applies its controller events, it only skips the audio. A block without
+        room for all its channels stays dry, the LFO and ramps move on as through an idle one */
+    if (hasChannels){
+        mEngine.startBlock(channels, juce::jmin(totalNumInputChannels, numEngineChannels), numSamples);
+    }
+    
+    /** a skipped stretch only moves the modulation on, between the events as much as in a processed block */
+    auto processSegment = [&] (int startSample, int numThisTime)
+    {
+        if (hasChannels){
+            mEngine.processSegment(channels, startSample, numThisTime);
+        } else {
+            mEngine.advanceModulation(numThisTime);
         }
+    };
+    
+    /** an idle block may have switched the oversampling factor */
+    updateLatency();
+    
+    /** split the block at controller events, so each ramp starts at the sample its event arrived */
+    int position = 0;
+    juce::uint32 movedControllers = 0;
+    
+    for (const auto metadata : midiMessages){
+        const auto message = metadata.getMessage();
         
-        /** calculate the right read head position */
-        float delayReadHeadRight = mCircularBufferWriteHead - delayTimeInSampleRight;
-        if (delayReadHeadRight < 0){
-            delayReadHeadRight += mCircularBufferLength;
+        if (! message.isController()){
+            continue;
         }
         
+        const auto target = getControllerTarget(message.getControllerNumber());
         
-        /** calculate linear interpolation points for left channel */
-        int readHeadLeft_x = (int)delayReadHeadLeft;
-        int readHeadLeft_x1 = readHeadLeft_x + 1;
-        float readHeadFloatLeft = delayReadHeadLeft - readHeadLeft_x;
-        
-        if (readHeadLeft_x1 >= mCircularBufferLength){
-            readHeadLeft_x1 -= mCircularBufferLength;
+        if (target.parameter == nullptr){
+            continue;
         }
         
+        const int eventPosition = juce::jlimit(position, numSamples, metadata.samplePosition);
         
-        /** calculate linear interpolation points for right channel */
-        int readHeadRight_x = (int)delayReadHeadRight;
-        int readHeadRight_x1 = readHeadRight_x + 1;
-        float readHeadFloatRight = delayReadHeadRight - readHeadRight_x;
-        
-        if (readHeadRight_x1 >= mCircularBufferLength){
-            readHeadRight_x1 -= mCircularBufferLength;
+        /** every event takes effect at its own sample, so the output does not depend on how the host splits the audio */
+        if (eventPosition > position){
+            processSegment(position, eventPosition - position);
+            position = eventPosition;
         }
         
-        /** generate left and right output samples*/
-        float delay_sample_left = KPChorusFlangerAudioProcessor::lin_interp(mCircularBufferLeft[readHeadLeft_x], mCircularBufferLeft[readHeadLeft_x1], readHeadFloatLeft);
-        float delay_sample_right = KPChorusFlangerAudioProcessor::lin_interp(mCircularBufferRight[readHeadRight_x], mCircularBufferRight[readHeadRight_x1], readHeadFloatRight);
-        
-        /** write into feedback buffer*/
-        mFeedbackLeft = delay_sample_left * *mFeedbackParameter;
-        mFeedbackRight = delay_sample_right * *mFeedbackParameter;
-        
+        /** the parameter itself moves, so the editor and the next block follow the controller. Only its
+            own field of the block's snapshot is read back for the ramp, and the host is told from the
+            message thread, as a listener may not be safe to call from here */
+        static_cast<juce::AudioProcessorParameter*>(target.parameter)->setValue(message.getControllerValue() / 127.f);
+        parameters.*target.value = target.parameter->get();
+        movedControllers |= target.flag;
+        mInstrumentation.addParameterChanges(updateEngineParameters(parameters));
+    }
     
-        
-        mCircularBufferWriteHead++;
-
-        if (mCircularBufferWriteHead >= mCircularBufferLength){
-            mCircularBufferWriteHead = 0;
-        }
-        
-        float dryAmount =1 - *mDryWetParameter;
-        float wetAmount = *mDryWetParameter;
-        
-        buffer.setSample(0, i, buffer.getSample(0, i) * dryAmount + delay_sample_left * wetAmount);
-        buffer.setSample(1, i, buffer.getSample(1, i) * dryAmount + delay_sample_right * wetAmount);
+    if (movedControllers != 0){
+        mMovedControllers.fetch_or(movedControllers, std::memory_order_relaxed);
+        triggerAsyncUpdate();
     }
+    
+    /** the input, widened copies included, is all zeros in a skipped block, which is already the right output */
+    processSegment(position, numSamples - position);
+    
+    mEngine.finishBlock();
+}
+
+juce::int64 KPChorusFlangerAudioProcessor::getNumBlocks() const
+{
+    return mEngine.getNumBlocks();
+}
+
+juce::int64 KPChorusFlangerAudioProcessor::getNumSkippedBlocks() const
+{
+    return mEngine.getNumSkippedBlocks();
+}
+
+bool KPChorusFlangerAudioProcessor::isIdle() const
+{
+    return mEngine.isIdle();
+}
 
+ParameterSnapshot KPChorusFlangerAudioProcessor::getParameterSnapshot() const
+{
+    ParameterSnapshot snapshot;
+    
+    snapshot.dryWet = mDryWetParameter->get();
+    snapshot.depth = mDepthParameter->get();
+    snapshot.rate = mRateParameter->get();
+    snapshot.phaseOffset = mPhaseOffsetParameter->get();
+    snapshot.feedback = mFeedbackParameter->get();
+    snapshot.type = mTypeParameter->get();
+    snapshot.waveform = mWaveformParameter->get();
+    snapshot.interpolation = mInterpolationParameter->get();
+    snapshot.oversampling = mOversamplingParameter->get();
+    snapshot.offlineOversampling = mOfflineOversamplingParameter->get();
+    snapshot.voices = mVoicesParameter->get();
+    snapshot.morph = mMorphParameter->get();
+    snapshot.morphTarget = mMorphTargetParameter->get();
+    snapshot.tempoSync = mTempoSyncParameter->get();
+    snapshot.noteValue = mNoteValueParameter->get();
+    
+    return snapshot;
+}
+
+ParameterSnapshot KPChorusFlangerAudioProcessor::getProcessingSnapshot (ParameterSnapshot snapshot)
+{
+    /** offline renders use their own oversampling setting */
+    if (isNonRealtime()){
+        snapshot.oversampling = snapshot.offlineOversampling;
+    }
+    
+    if (snapshot.morph <= 0){
+        return snapshot;
+    }
     
+    /** a target past the end of the bank is the last preset. While the bank is being changed the
+        last target read stands in, so the audio thread never waits */
+    const int target = juce::jmin(snapshot.morphTarget, mPresetBank.getNumPresets() - 1);
+    mPresetBank.tryGetPreset(target, mMorphTarget);
+    
+    return PresetBank::morph(snapshot, mMorphTarget, snapshot.morph);
+}
 
-    // This is the place where you'd normally do the guts of your plugin's
-    // audio processing...
-    // Make sure to reset the state if your inner loop is processing
-    // the samples and the outer loop is handling the channels.
-    // Alternatively, you can process the samples with the channels
-    // interleaved by keeping the same state.
-    //for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    //{
-    //    auto* channelData = buffer.getWritePointer (channel);
+void KPChorusFlangerAudioProcessor::setParameters(const ParameterSnapshot& snapshot)
+{
+    *mDryWetParameter = snapshot.dryWet;
+    *mDepthParameter = snapshot.depth;
+    *mRateParameter = snapshot.rate;
+    *mPhaseOffsetParameter = snapshot.phaseOffset;
+    *mFeedbackParameter = snapshot.feedback;
+    *mTypeParameter = snapshot.type;
+    *mWaveformParameter = snapshot.waveform;
+    *mInterpolationParameter = snapshot.interpolation;
+    *mOversamplingParameter = snapshot.oversampling;
+    *mOfflineOversamplingParameter = snapshot.offlineOversampling;
+    *mVoicesParameter = snapshot.voices;
+    *mMorphParameter = snapshot.morph;
+    *mMorphTargetParameter = snapshot.morphTarget;
+    *mTempoSyncParameter = snapshot.tempoSync;
+    *mNoteValueParameter = snapshot.noteValue;
+}
 
-        // ..do something to the data...
-    //}
+KPChorusFlangerAudioProcessor::ControllerTarget KPChorusFlangerAudioProcessor::getControllerTarget (int controllerNumber) const
+{
+    switch (controllerNumber){
+        case MidiControllers::kDepth:       return { mDepthParameter, &ParameterSnapshot::depth, 1 << 0 };
+        case MidiControllers::kRate:        return { mRateParameter, &ParameterSnapshot::rate, 1 << 1 };
+        case MidiControllers::kFeedback:    return { mFeedbackParameter, &ParameterSnapshot::feedback, 1 << 2 };
+        case MidiControllers::kPhaseOffset: return { mPhaseOffsetParameter, &ParameterSnapshot::phaseOffset, 1 << 3 };
+        case MidiControllers::kDryWet:      return { mDryWetParameter, &ParameterSnapshot::dryWet, 1 << 4 };
+        default:                            return { nullptr, nullptr, 0 };
+    }
 }
 
 //==============================================================================
@@ -417,36 +648,20 @@ void KPChorusFlangerAudioProcessor::getStateInformation (juce::MemoryBlock& dest
     // You should use this method to store your parameters in the memory block.
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
-    std::unique_ptr<juce::XmlElement> xml(new juce::XmlElement("FlangerChorus"));
-    
-    xml->setAttribute("DryWet", *mDryWetParameter);
-    xml->setAttribute("Depth", *mDepthParameter);
-    xml->setAttribute("Rate", *mRateParameter);
-    xml->setAttribute("Phaseoffset", *mPhaseOffsetParameter);
-    xml->setAttribute("Feedback", *mFeedbackParameter);
-    xml->setAttribute("Type", *mTypeParameter);
-    
-    copyXmlToBinary(*xml, destData);
-    
+    StateFormat::write(getParameterSnapshot(), destData);
 }
 
 void KPChorusFlangerAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    
-    if (xml.get() != nullptr && xml->hasTagName("FlangerChorus")){
-        *mDryWetParameter = xml->getDoubleAttribute("DryWet");
-        *mDepthParameter = xml->getDoubleAttribute("Depth");
-        *mRateParameter = xml->getDoubleAttribute("Rate");
-        *mPhaseOffsetParameter = xml->getDoubleAttribute("Phaseoffset");
-        *mFeedbackParameter = xml->getDoubleAttribute("Feedback");
-        *mTypeParameter = xml->getIntAttribute("Type");
-        
-    }
     
+    /** fields an older binary state lacks get their defaults, sessions saved as XML are migrated on load */
+    ParameterSnapshot snapshot;
     
+    if (StateFormat::read(data, sizeInBytes, snapshot) || StateFormat::readXml(data, sizeInBytes, snapshot)){
+        setParameters(snapshot);
+    }
 }
 
 //==============================================================================
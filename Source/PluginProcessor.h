@@ -9,12 +9,16 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ChorusFlangerEngine.h"
+#include "Instrumentation.h"
+#include "ModulationTrace.h"
+#include "PresetBank.h"
 
-#define MAX_DELAY_TIME 2
 //==============================================================================
 /**
 */
-class KPChorusFlangerAudioProcessor  : public juce::AudioProcessor
+class KPChorusFlangerAudioProcessor  : public juce::AudioProcessor,
+                                       private juce::AsyncUpdater
                             #if JucePlugin_Enable_ARA
                              , public juce::AudioProcessorARAExtension
                             #endif
@@ -27,12 +31,18 @@ public:
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void reset() override;
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    
+    /** the delay line, interpolation, filters and feedback run in the precision the host asks
+        for, the modulation stays single precision in both */
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -59,12 +69,94 @@ public:
     
     
     float lin_interp(float inSampleX, float inSampleY, float inFloatPhase);
+    
+    /** select the original sample-by-sample loop instead of the staged block pipeline.
+        The block pipeline performs the same arithmetic in the same order, and the engine keeps
+        the compiler from fusing multiply-adds, so with the LFO::kStdSine backend and the Sine
+        waveform the two paths stay within kBlockPathTolerance of the output peak, and are
+        bit-identical with GCC and Clang. The benchmark's reference command checks this */
+    void setUseReferenceProcessing(bool shouldUseReference);
+    bool isUsingReferenceProcessing() const;
+    
+    static constexpr float kBlockPathTolerance = 1.0e-5f;
+    
+    /** choose the LFO implementation used by the block pipeline, see LFO::createBackendReport() */
+    void setLFOBackend(LFO::Backend newBackend);
+    LFO::Backend getLFOBackend() const;
+    
+    /** run the LFO, smoothers and write head forward by numSamples without writing audio, as if that
+        many samples had been processed in blocks of the prepared size. Used by offline renders that
+        start part-way into a file, so the modulation matches a render from the beginning */
+    void advanceModulation(juce::int64 numSamples);
+    
+    /** by default releaseResources() keeps the delay memory so the next prepareToPlay does not
+        allocate. Set this to hand it back to the system on every stop instead */
+    void setReleaseMemoryOnStop(bool shouldRelease);
+    bool isReleasingMemoryOnStop() const;
+    
+    /** the delay line is reserved for at least this rate, so preparing at any rate up to it reuses the memory */
+    static constexpr double kMaxSupportedSampleRate = 192000.0;
+    
+    /** blocks processed since construction, and how many of them were skipped because the input
+        had been digital silence for longer than the tail. Safe to read from any thread */
+    juce::int64 getNumBlocks() const;
+    juce::int64 getNumSkippedBlocks() const;
+    
+    /** true while the input is silent and the tail has decayed, so blocks are skipped */
+    bool isIdle() const;
+    
+    /** cost, block sizes and parameter changes of every processBlock call, for the editor's
+        CPU meter and for offline reports */
+    Instrumentation& getInstrumentation()               { return mInstrumentation; }
+    const Instrumentation& getInstrumentation() const   { return mInstrumentation; }
+    
+    /** the delay times the block pipeline sweeps, for the editor's LFO display */
+    ModulationTrace& getModulationTrace()               { return mModulationTrace; }
+    
+    /** the factory and user presets, which are also the host's programs and the morph targets */
+    PresetBank& getPresetBank()                         { return mPresetBank; }
+    
+    /** store the current parameters as a user preset and save the user bank, returns its index or -1 */
+    int saveUserPreset(const juce::String& name);
 
 private:
     
-    float mPhaseOffsetSmoothed;
-    float mRateSmoothed;
-    float mDepthSmoothed;
+    /** both processBlock overloads, everything from the parameter snapshot to the mix */
+    template <typename SampleType>
+    void processBlockTemplate(juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midiMessages);
+    
+    /** what a MIDI controller number moves, see MidiControllers: the parameter, or nullptr, the snapshot
+        field it sets and its bit in mMovedControllers */
+    struct ControllerTarget
+    {
+        juce::AudioParameterFloat* parameter;
+        float ParameterSnapshot::* value;
+        juce::uint32 flag;
+    };
+    
+    ControllerTarget getControllerTarget(int controllerNumber) const;
+    
+    /** read every parameter once, the only place the audio thread touches the parameter atomics */
+    ParameterSnapshot getParameterSnapshot() const;
+    
+    /** set every parameter from a snapshot, notifying the host of each */
+    void setParameters(const ParameterSnapshot& snapshot);
+    
+    /** a parameter snapshot, morphed towards the morph target preset, with the oversampling
+        setting of the current render mode, for the engine */
+    ParameterSnapshot getProcessingSnapshot(ParameterSnapshot snapshot);
+    
+    /** read the user bank the first time a preset is asked for, on the message thread */
+    void loadUserBankIfNeeded();
+    
+    /** hand the engine the processing snapshot of parameters. Returns how many values changed, for the instrumentation */
+    int updateEngineParameters(const ParameterSnapshot& parameters);
+    
+    /** note the latency of the engine's oversampling. The audio thread may not call setLatencySamples,
+        a change reaches the host from handleAsyncUpdate() on the message thread, as do the
+        parameters MIDI controllers have moved */
+    void updateLatency();
+    void handleAsyncUpdate() override;
     
     /** parameter Declarations */
     juce::AudioParameterFloat* mDryWetParameter;
@@ -74,17 +166,47 @@ private:
     juce::AudioParameterFloat* mFeedbackParameter;
     
     juce::AudioParameterInt* mTypeParameter;
+    juce::AudioParameterInt* mWaveformParameter;
+    juce::AudioParameterInt* mInterpolationParameter;
+    juce::AudioParameterInt* mOversamplingParameter;
+    juce::AudioParameterInt* mOfflineOversamplingParameter;
+    juce::AudioParameterInt* mVoicesParameter;
+    
+    juce::AudioParameterFloat* mMorphParameter;
+    juce::AudioParameterInt* mMorphTargetParameter;
+    
+    juce::AudioParameterInt* mTempoSyncParameter;
+    juce::AudioParameterInt* mNoteValueParameter;
+    
     
+    /** the delay line, LFOs, feedback and oversampling, everything that makes the sound */
+    ChorusFlangerEngine mEngine;
+    bool mReleaseMemoryOnStop;
     
-    /** Circular Buffer Data */
-    float* mCircularBufferLeft;
-    float* mCircularBufferRight;
+    /** stand-ins for channels a host leaves out of a buffer, sized by prepareToPlay in the prepared
+        precision only. The engine processes them and their output is dropped */
+    juce::AudioBuffer<float> mSpareFloatChannels;
+    juce::AudioBuffer<double> mSpareDoubleChannels;
     
-    int mCircularBufferLength;
-    int mCircularBufferWriteHead;
+    juce::AudioBuffer<float>& getSpareChannels(float*)      { return mSpareFloatChannels; }
+    juce::AudioBuffer<double>& getSpareChannels(double*)    { return mSpareDoubleChannels; }
     
-    float mFeedbackLeft;
-    float mFeedbackRight;
+    /** Latency Data, the engine's latency as last noted, for the message thread to report */
+    std::atomic<int> mEngineLatency;
+    
+    /** MIDI Data, the ControllerTarget flags of the parameters moved since the host was last told */
+    std::atomic<juce::uint32> mMovedControllers;
+    
+    Instrumentation mInstrumentation;
+    
+    /** LFO Display Data, filled by the engine while the editor is reading it */
+    ModulationTrace mModulationTrace;
+    
+    /** Preset Data, the last morph target the audio thread read from the bank */
+    PresetBank mPresetBank;
+    std::atomic<int> mCurrentProgram;
+    std::atomic<bool> mUserBankLoaded;
+    ParameterSnapshot mMorphTarget;
     
     float mDelayTimeInSamplesLeft;
     float mDelayTimeInSamplesRight;
@@ -92,12 +214,6 @@ private:
     float mDelayReadHeadRight;
     
     
-    /**LFO Data */
-    float mLFOPhase;
-
-
-    
-    
     float mDryWet;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (KPChorusFlangerAudioProcessor)
@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 18 Oct 2026 1:02:47am
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+#include "StateFormat.h"
+#include "LFO.h"
+#include "ChorusFlangerEngine.h"
+
+namespace
+{
+    /** "KPCB" read as a little-endian uint32 */
+    constexpr juce::uint32 kMagic = 0x4243504b;
+    constexpr int kVersion = 1;
+    constexpr int kHeaderSize = 8;
+
+    /** names are stored with a one byte length */
+    constexpr int kMaxNameBytes = 255;
+
+    struct FactoryPreset
+    {
+        const char* name;
+        float dryWet, depth, rate, phaseOffset, feedback;
+        int type, waveform, voices;
+    };
+
+    /** type 0 is Chorus and 1 is Flanger */
+    const FactoryPreset kFactoryPresets[] =
+    {
+        { "Default",        0.5f, 0.5f, 10.f, 0.f,   0.5f,  0, LFO::kSine,           1 },
+        { "Subtle Chorus",  0.3f, 0.3f, 0.8f, 0.25f, 0.f,   0, LFO::kSine,           1 },
+        { "Wide Chorus",    0.5f, 0.6f, 0.5f, 0.5f,  0.2f,  0, LFO::kSine,           3 },
+        { "Ensemble",       0.5f, 0.5f, 0.6f, 0.5f,  0.1f,  0, LFO::kSmoothedRandom, 6 },
+        { "Vibrato",        1.f,  0.4f, 5.5f, 0.f,   0.f,   0, LFO::kSine,           1 },
+        { "Slow Flanger",   0.5f, 0.8f, 0.2f, 0.25f, 0.7f,  1, LFO::kTriangle,       1 },
+        { "Jet Flanger",    0.5f, 1.f,  0.1f, 0.f,   0.95f, 1, LFO::kSine,           1 },
+        { "Metallic",       0.6f, 0.3f, 2.f,  0.f,   0.9f,  1, LFO::kSoftSquare,     1 },
+    };
+
+    constexpr int kNumFactoryPresets = (int)juce::numElementsInArray(kFactoryPresets);
+
+    bool isValidName(const juce::String& name)
+    {
+        return name.isNotEmpty() && (int)name.getNumBytesAsUTF8() <= kMaxNameBytes;
+    }
+}
+
+//==============================================================================
+PresetBank::PresetBank()
+{
+    static_assert(kNumFactoryPresets < kMaxPresets, "no room for user presets");
+
+    for (int i = 0; i < kNumFactoryPresets; i++){
+        const auto& factory = kFactoryPresets[i];
+        auto& preset = mPresets[i];
+
+        preset.dryWet = factory.dryWet;
+        preset.depth = factory.depth;
+        preset.rate = factory.rate;
+        preset.phaseOffset = factory.phaseOffset;
+        preset.feedback = factory.feedback;
+        preset.type = factory.type;
+        preset.waveform = factory.waveform;
+        preset.voices = factory.voices;
+
+        mNames.add(factory.name);
+    }
+
+    mNumPresets = kNumFactoryPresets;
+    rebuildNameIndex();
+}
+
+int PresetBank::getNumFactoryPresets() const
+{
+    return kNumFactoryPresets;
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    return mNames[index];
+}
+
+int PresetBank::findPreset(const juce::String& name) const
+{
+    return mIndexByName.contains(name) ? mIndexByName[name] : -1;
+}
+
+ParameterSnapshot PresetBank::getPreset(int index) const
+{
+    const juce::SpinLock::ScopedLockType lock (mLock);
+
+    if (index < 0 || index >= getNumPresets()){
+        return {};
+    }
+
+    return mPresets[index];
+}
+
+bool PresetBank::tryGetPreset(int index, ParameterSnapshot& preset) const
+{
+    const juce::SpinLock::ScopedTryLockType lock (mLock);
+
+    if (! lock.isLocked() || index < 0 || index >= getNumPresets()){
+        return false;
+    }
+
+    preset = mPresets[index];
+    return true;
+}
+
+//==============================================================================
+int PresetBank::setUserPreset(const juce::String& name, const ParameterSnapshot& snapshot)
+{
+    if (! isValidName(name)){
+        return -1;
+    }
+
+    int index = findPreset(name);
+
+    if (index >= 0 && isFactoryPreset(index)){
+        return -1;
+    }
+
+    if (index < 0){
+        index = getNumPresets();
+
+        if (index >= kMaxPresets){
+            return -1;
+        }
+
+        mNames.add(name);
+        mIndexByName.set(name, index);
+    }
+
+    const juce::SpinLock::ScopedLockType lock (mLock);
+    mPresets[index] = snapshot;
+    mNumPresets.store(juce::jmax(getNumPresets(), index + 1), std::memory_order_release);
+
+    return index;
+}
+
+bool PresetBank::renamePreset(int index, const juce::String& newName)
+{
+    if (isFactoryPreset(index) || index >= getNumPresets() || ! isValidName(newName) || findPreset(newName) >= 0){
+        return false;
+    }
+
+    mNames.set(index, newName);
+    rebuildNameIndex();
+    return true;
+}
+
+bool PresetBank::loadUserBank(const juce::File& file)
+{
+    const juce::MemoryMappedFile mappedFile (file, juce::MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr){
+        return false;
+    }
+
+    return readUserBank(mappedFile.getData(), mappedFile.getSize());
+}
+
+bool PresetBank::saveUserBank(const juce::File& file) const
+{
+    juce::MemoryBlock data;
+    writeUserBank(data);
+
+    return file.getParentDirectory().createDirectory().wasOk() && file.replaceWithData(data.getData(), data.getSize());
+}
+
+bool PresetBank::readUserBank(const void* data, size_t sizeInBytes)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data);
+
+    if (bytes == nullptr || sizeInBytes < (size_t)kHeaderSize || juce::ByteOrder::littleEndianInt(bytes) != kMagic){
+        return false;
+    }
+
+    const int numStored = juce::ByteOrder::littleEndianShort(bytes + 6);
+    size_t position = kHeaderSize;
+
+    /** decoded next to the bank first, so the audio thread only ever waits out the final copy */
+    ParameterSnapshot userPresets[kMaxPresets - kNumFactoryPresets];
+    juce::StringArray userNames;
+
+    for (int i = 0; i < numStored && userNames.size() < kMaxPresets - kNumFactoryPresets; i++){
+        if (position + 1 > sizeInBytes){
+            break;
+        }
+
+        const int nameLength = bytes[position];
+        position += 1;
+
+        if (position + (size_t)nameLength + 2 > sizeInBytes){
+            break;
+        }
+
+        const auto name = juce::String::fromUTF8(reinterpret_cast<const char*>(bytes + position), nameLength);
+        position += (size_t)nameLength;
+
+        const int stateSize = juce::ByteOrder::littleEndianShort(bytes + position);
+        position += 2;
+
+        if (position + (size_t)stateSize > sizeInBytes){
+            break;
+        }
+
+        /** presets that cannot be read, or whose names clash, are left out rather than failing the bank */
+        ParameterSnapshot snapshot;
+        const bool nameIsFree = mIndexByName.contains(name) ? ! isFactoryPreset(mIndexByName[name]) : true;
+
+        if (StateFormat::read(bytes + position, stateSize, snapshot) && isValidName(name) && nameIsFree && ! userNames.contains(name)){
+            userPresets[userNames.size()] = snapshot;
+            userNames.add(name);
+        }
+
+        position += (size_t)stateSize;
+    }
+
+    {
+        const juce::SpinLock::ScopedLockType lock (mLock);
+        std::copy(userPresets, userPresets + userNames.size(), mPresets + kNumFactoryPresets);
+        mNumPresets.store(kNumFactoryPresets + userNames.size(), std::memory_order_release);
+    }
+
+    mNames.removeRange(kNumFactoryPresets, mNames.size() - kNumFactoryPresets);
+    mNames.addArray(userNames);
+    rebuildNameIndex();
+
+    return true;
+}
+
+void PresetBank::writeUserBank(juce::MemoryBlock& destData) const
+{
+    const int numPresets = getNumPresets();
+
+    juce::MemoryOutputStream stream (destData, false);
+    stream.writeInt((int)kMagic);
+    stream.writeShort((short)kVersion);
+    stream.writeShort((short)(numPresets - kNumFactoryPresets));
+
+    juce::MemoryBlock state;
+
+    for (int i = kNumFactoryPresets; i < numPresets; i++){
+        const auto& name = mNames[i];
+        const auto nameLength = name.getNumBytesAsUTF8();
+
+        StateFormat::write(getPreset(i), state);
+
+        stream.writeByte((char)nameLength);
+        stream.write(name.toRawUTF8(), nameLength);
+        stream.writeShort((short)state.getSize());
+        stream.write(state.getData(), state.getSize());
+    }
+}
+
+juce::File PresetBank::getDefaultUserBankFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("KPChorusFlanger")
+               .getChildFile("UserPresets.kpcbank");
+}
+
+//==============================================================================
+ParameterSnapshot PresetBank::morph(const ParameterSnapshot& from, const ParameterSnapshot& to, float amount)
+{
+    amount = juce::jlimit(0.f, 1.f, amount);
+
+    /** exact at both ends, so a full morph sounds the same as recalling the preset */
+    auto interpolate = [amount] (float a, float b) { return (1.f - amount) * a + amount * b; };
+
+    auto result = from;
+    result.dryWet = interpolate(from.dryWet, to.dryWet);
+    result.depth = interpolate(from.depth, to.depth);
+    result.rate = interpolate(from.rate, to.rate);
+    result.phaseOffset = interpolate(from.phaseOffset, to.phaseOffset);
+    result.feedback = interpolate(from.feedback, to.feedback);
+
+    /** the Type still switches halfway, but the delay range moves from one Type's to the other's
+        with the amount, so a morph sweeps the delay instead of jumping it */
+    if (from.type != to.type){
+        float fromMin, fromMax, toMin, toMax;
+        ChorusFlangerEngine::getDelayRange(from, fromMin, fromMax);
+        ChorusFlangerEngine::getDelayRange(to, toMin, toMax);
+
+        result.minDelayTime = interpolate(fromMin, toMin);
+        result.maxDelayTime = interpolate(fromMax, toMax);
+    }
+
+    /** the engine smooths these over, see ChorusFlangerEngine::setParameters() */
+    if (amount >= 0.5f){
+        result.type = to.type;
+        result.waveform = to.waveform;
+        result.interpolation = to.interpolation;
+        result.voices = to.voices;
+        result.tempoSync = to.tempoSync;
+        result.noteValue = to.noteValue;
+    }
+
+    return result;
+}
+
+void PresetBank::rebuildNameIndex()
+{
+    mIndexByName.clear();
+
+    for (int i = 0; i < mNames.size(); i++){
+        mIndexByName.set(mNames[i], i);
+    }
+}
@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 18 Oct 2026 1:02:47am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Parameters.h"
+
+//==============================================================================
+/**
+    The factory presets, then the user's own, as host programs and morph targets.
+
+    Factory presets are compiled in. User presets live in a bank file that is
+    memory-mapped and decoded once when it is loaded:
+
+        "KPCB"              magic
+        uint16              format version
+        uint16              number of presets
+        per preset:
+            uint8           name length in bytes
+            name            UTF-8, not terminated
+            uint16          state size in bytes
+            state           a StateFormat binary state
+
+    Every preset is decoded into a ParameterSnapshot in a fixed array, so recalling
+    one is a copy of a few plain values, whatever the size of the bank, and never
+    allocates. Names are looked up through a hash map.
+
+    The audio thread reads presets with tryGetPreset(), which never waits. Loading,
+    saving and renaming happen on the message thread and hold the lock only for
+    the copy into the array.
+*/
+class PresetBank
+{
+public:
+
+    static constexpr int kMaxPresets = 128;
+
+    PresetBank();
+
+    int getNumPresets() const                   { return mNumPresets.load(std::memory_order_acquire); }
+    int getNumFactoryPresets() const;
+    bool isFactoryPreset(int index) const       { return index < getNumFactoryPresets(); }
+
+    /** message thread */
+    juce::String getName(int index) const;
+
+    /** the index of the preset called name, or -1 */
+    int findPreset(const juce::String& name) const;
+
+    /** a copy of one preset, the defaults for an index out of range. Not for the audio thread */
+    ParameterSnapshot getPreset(int index) const;
+
+    /** audio thread, returns false without waiting while the message thread is changing the bank */
+    bool tryGetPreset(int index, ParameterSnapshot& preset) const;
+
+    //==============================================================================
+    /** store snapshot as a user preset, replacing a user preset of the same name.
+        Returns its index, or -1 if the name belongs to a factory preset or the bank is full */
+    int setUserPreset(const juce::String& name, const ParameterSnapshot& snapshot);
+
+    /** user presets only, returns false for a factory preset or a name already taken */
+    bool renamePreset(int index, const juce::String& newName);
+
+    /** replace the user presets with those in a bank file, returns false if it cannot be read */
+    bool loadUserBank(const juce::File& file);
+    bool saveUserBank(const juce::File& file) const;
+
+    /** the same, from and to memory */
+    bool readUserBank(const void* data, size_t sizeInBytes);
+    void writeUserBank(juce::MemoryBlock& destData) const;
+
+    /** where the plugin keeps the user's presets */
+    static juce::File getDefaultUserBankFile();
+
+    //==============================================================================
+    /** from moved amount of the way towards to. Continuous values are interpolated,
+        the Type, Waveform, Interpolation, Voices and tempo sync of to take over halfway. The engine
+        fades the Type and dips the wet signal around the others, so the switch does not click. The
+        oversampling settings stay those of from, so the latency never changes */
+    static ParameterSnapshot morph(const ParameterSnapshot& from, const ParameterSnapshot& to, float amount);
+
+private:
+
+    void rebuildNameIndex();
+
+    juce::SpinLock mLock;
+    ParameterSnapshot mPresets[kMaxPresets];
+    std::atomic<int> mNumPresets;
+
+    /** message thread only */
+    juce::StringArray mNames;
+    juce::HashMap<juce::String, int> mIndexByName;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBank)
+};
@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+    StateFormat.cpp
+    Created: 18 Oct 2026 12:31:05am
+
+  ==============================================================================
+*/
+
+#include "StateFormat.h"
+#include "LFO.h"
+#include "DelayLineReader.h"
+
+namespace
+{
+    /** "KPCF" read as a little-endian uint32 */
+    constexpr juce::uint32 kMagic = 0x4643504b;
+
+    constexpr int kHeaderSize = 8;
+    constexpr int kFieldHeaderSize = 2;
+    constexpr int kValueSize = (int)sizeof(float);
+
+    constexpr int kNumFields = StateFormat::kNoteValue;
+
+    float getField(const ParameterSnapshot& snapshot, int fieldID)
+    {
+        switch (fieldID){
+            case StateFormat::kDryWet:              return snapshot.dryWet;
+            case StateFormat::kDepth:               return snapshot.depth;
+            case StateFormat::kRate:                return snapshot.rate;
+            case StateFormat::kPhaseOffset:         return snapshot.phaseOffset;
+            case StateFormat::kFeedback:            return snapshot.feedback;
+            case StateFormat::kType:                return (float)snapshot.type;
+            case StateFormat::kWaveform:            return (float)snapshot.waveform;
+            case StateFormat::kInterpolation:       return (float)snapshot.interpolation;
+            case StateFormat::kOversampling:        return (float)snapshot.oversampling;
+            case StateFormat::kOfflineOversampling: return (float)snapshot.offlineOversampling;
+            case StateFormat::kVoices:              return (float)snapshot.voices;
+            case StateFormat::kMorph:               return snapshot.morph;
+            case StateFormat::kMorphTarget:         return (float)snapshot.morphTarget;
+            case StateFormat::kTempoSync:           return (float)snapshot.tempoSync;
+            case StateFormat::kNoteValue:           return (float)snapshot.noteValue;
+            default:                                break;
+        }
+
+        jassertfalse;
+        return 0.f;
+    }
+
+    /** false for an ID this version does not know */
+    bool setField(ParameterSnapshot& snapshot, int fieldID, float value)
+    {
+        switch (fieldID){
+            case StateFormat::kDryWet:              snapshot.dryWet = value; return true;
+            case StateFormat::kDepth:               snapshot.depth = value; return true;
+            case StateFormat::kRate:                snapshot.rate = value; return true;
+            case StateFormat::kPhaseOffset:         snapshot.phaseOffset = value; return true;
+            case StateFormat::kFeedback:            snapshot.feedback = value; return true;
+            case StateFormat::kType:                snapshot.type = juce::roundToInt(value); return true;
+            case StateFormat::kWaveform:            snapshot.waveform = juce::roundToInt(value); return true;
+            case StateFormat::kInterpolation:       snapshot.interpolation = juce::roundToInt(value); return true;
+            case StateFormat::kOversampling:        snapshot.oversampling = juce::roundToInt(value); return true;
+            case StateFormat::kOfflineOversampling: snapshot.offlineOversampling = juce::roundToInt(value); return true;
+            case StateFormat::kVoices:              snapshot.voices = juce::roundToInt(value); return true;
+            case StateFormat::kMorph:               snapshot.morph = value; return true;
+            case StateFormat::kMorphTarget:         snapshot.morphTarget = juce::roundToInt(value); return true;
+            case StateFormat::kTempoSync:           snapshot.tempoSync = juce::roundToInt(value); return true;
+            case StateFormat::kNoteValue:           snapshot.noteValue = juce::roundToInt(value); return true;
+            default:                                return false;
+        }
+    }
+
+    void writeUInt16(juce::uint8* destination, int value)
+    {
+        destination[0] = (juce::uint8)(value & 0xff);
+        destination[1] = (juce::uint8)((value >> 8) & 0xff);
+    }
+
+    void writeUInt32(juce::uint8* destination, juce::uint32 value)
+    {
+        for (int i = 0; i < 4; i++){
+            destination[i] = (juce::uint8)((value >> (8 * i)) & 0xff);
+        }
+    }
+}
+
+//==============================================================================
+void StateFormat::write(const ParameterSnapshot& snapshot, juce::MemoryBlock& destData)
+{
+    destData.setSize((size_t)(kHeaderSize + kNumFields * (kFieldHeaderSize + kValueSize)), false);
+    auto* bytes = static_cast<juce::uint8*>(destData.getData());
+
+    writeUInt32(bytes, kMagic);
+    writeUInt16(bytes + 4, kVersion);
+    writeUInt16(bytes + 6, kNumFields);
+    bytes += kHeaderSize;
+
+    for (int fieldID = kDryWet; fieldID <= kNumFields; fieldID++){
+        const float value = getField(snapshot, fieldID);
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        bytes[0] = (juce::uint8)fieldID;
+        bytes[1] = (juce::uint8)kValueSize;
+        writeUInt32(bytes + kFieldHeaderSize, bits);
+        bytes += kFieldHeaderSize + kValueSize;
+    }
+}
+
+bool StateFormat::read(const void* data, int sizeInBytes, ParameterSnapshot& snapshot)
+{
+    const auto* bytes = static_cast<const juce::uint8*>(data);
+
+    if (bytes == nullptr || sizeInBytes < kHeaderSize || juce::ByteOrder::littleEndianInt(bytes) != kMagic){
+        return false;
+    }
+
+    const int numFields = juce::ByteOrder::littleEndianShort(bytes + 6);
+    int position = kHeaderSize;
+
+    /** a truncated state keeps every field that arrived whole */
+    for (int i = 0; i < numFields && position + kFieldHeaderSize <= sizeInBytes; i++){
+        const int fieldID = bytes[position];
+        const int payloadSize = bytes[position + 1];
+        position += kFieldHeaderSize;
+
+        if (position + payloadSize > sizeInBytes){
+            break;
+        }
+
+        if (payloadSize == kValueSize){
+            const juce::uint32 bits = juce::ByteOrder::littleEndianInt(bytes + position);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            if (std::isfinite(value)){
+                setField(snapshot, fieldID, value);
+            }
+        }
+
+        position += payloadSize;
+    }
+
+    return true;
+}
+
+//==============================================================================
+void StateFormat::writeXml(const ParameterSnapshot& snapshot, juce::MemoryBlock& destData)
+{
+    juce::XmlElement xml ("FlangerChorus");
+
+    xml.setAttribute("DryWet", snapshot.dryWet);
+    xml.setAttribute("Depth", snapshot.depth);
+    xml.setAttribute("Rate", snapshot.rate);
+    xml.setAttribute("Phaseoffset", snapshot.phaseOffset);
+    xml.setAttribute("Feedback", snapshot.feedback);
+    xml.setAttribute("Type", snapshot.type);
+    xml.setAttribute("Waveform", snapshot.waveform);
+    xml.setAttribute("Interpolation", snapshot.interpolation);
+    xml.setAttribute("Oversampling", snapshot.oversampling);
+    xml.setAttribute("OfflineOversampling", snapshot.offlineOversampling);
+    xml.setAttribute("Voices", snapshot.voices);
+
+    juce::AudioProcessor::copyXmlToBinary(xml, destData);
+}
+
+bool StateFormat::readXml(const void* data, int sizeInBytes, ParameterSnapshot& snapshot)
+{
+    std::unique_ptr<juce::XmlElement> xml (juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+    if (xml.get() == nullptr || ! xml->hasTagName("FlangerChorus")){
+        return false;
+    }
+
+    snapshot.dryWet = (float)xml->getDoubleAttribute("DryWet");
+    snapshot.depth = (float)xml->getDoubleAttribute("Depth");
+    snapshot.rate = (float)xml->getDoubleAttribute("Rate");
+    snapshot.phaseOffset = (float)xml->getDoubleAttribute("Phaseoffset");
+    snapshot.feedback = (float)xml->getDoubleAttribute("Feedback");
+    snapshot.type = xml->getIntAttribute("Type");
+    snapshot.waveform = xml->getIntAttribute("Waveform", LFO::kSine);
+    snapshot.interpolation = xml->getIntAttribute("Interpolation", DelayLineReader::kLinear);
+    snapshot.oversampling = xml->getIntAttribute("Oversampling", 0);
+    snapshot.offlineOversampling = xml->getIntAttribute("OfflineOversampling", 0);
+    snapshot.voices = xml->getIntAttribute("Voices", 1);
+
+    return true;
+}
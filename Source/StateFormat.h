@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    StateFormat.h
+    Created: 18 Oct 2026 12:31:05am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Parameters.h"
+
+//==============================================================================
+/**
+    The binary format getStateInformation writes, and the XML it replaced.
+
+    A state is an 8 byte header followed by tagged fields, all little-endian:
+
+        "KPCF"              magic
+        uint16              format version
+        uint16              number of fields
+        per field:
+            uint8           field ID, one of FieldID
+            uint8           payload size in bytes
+            payload         a float32 plain value for every field so far
+
+    A reader skips any field ID it does not know and any payload of a size it
+    does not expect, so a state from a newer version still loads its known
+    fields. Fields missing from an older state keep the values the caller put in
+    the snapshot. Field IDs are never reused. A change that an older reader could
+    not safely skip needs a new magic, not a new version.
+
+    Reading works straight from the host's memory into a ParameterSnapshot and
+    does not allocate.
+*/
+namespace StateFormat
+{
+    /** the version written, raise it whenever fields are added */
+    constexpr int kVersion = 3;
+
+    enum FieldID
+    {
+        kDryWet = 1,
+        kDepth,
+        kRate,
+        kPhaseOffset,
+        kFeedback,
+        kType,
+        kWaveform,
+        kInterpolation,
+        kOversampling,
+        kOfflineOversampling,
+        kVoices,
+
+        /** version 2 */
+        kMorph,
+        kMorphTarget,
+
+        /** version 3 */
+        kTempoSync,
+        kNoteValue
+    };
+
+    /** replace destData with the binary state of snapshot */
+    void write(const ParameterSnapshot& snapshot, juce::MemoryBlock& destData);
+
+    /** true if data holds a binary state. Known fields are copied into snapshot,
+        anything else in it is left alone */
+    bool read(const void* data, int sizeInBytes, ParameterSnapshot& snapshot);
+
+    /** the FlangerChorus XML element saved before the binary format, kept so old
+        sessions still load. Attributes missing from the XML get the defaults that
+        version used */
+    void writeXml(const ParameterSnapshot& snapshot, juce::MemoryBlock& destData);
+    bool readXml(const void* data, int sizeInBytes, ParameterSnapshot& snapshot);
+}
@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    TempoSync.cpp
+    Created: 18 Oct 2026 1:41:19am
+
+  ==============================================================================
+*/
+
+#include "TempoSync.h"
+
+namespace
+{
+    struct NoteValue
+    {
+        const char* name;
+        double quarterNotes;
+    };
+
+    /** T is a triplet, D a dotted note */
+    const NoteValue kNoteValues[] =
+    {
+        { "8/1",    32.0 },
+        { "4/1",    16.0 },
+        { "2/1",    8.0 },
+        { "1/1",    4.0 },
+        { "1/2",    2.0 },
+        { "1/2 T",  4.0 / 3.0 },
+        { "1/4 D",  1.5 },
+        { "1/4",    1.0 },
+        { "1/4 T",  2.0 / 3.0 },
+        { "1/8 D",  0.75 },
+        { "1/8",    0.5 },
+        { "1/8 T",  1.0 / 3.0 },
+        { "1/16",   0.25 },
+        { "1/16 T", 1.0 / 6.0 },
+        { "1/32",   0.125 },
+    };
+}
+
+//==============================================================================
+int TempoSync::getNumNoteValues()
+{
+    return (int)juce::numElementsInArray(kNoteValues);
+}
+
+juce::StringArray TempoSync::getNoteValueNames()
+{
+    juce::StringArray names;
+
+    for (const auto& noteValue : kNoteValues){
+        names.add(noteValue.name);
+    }
+
+    return names;
+}
+
+double TempoSync::getQuarterNotes(int noteValue)
+{
+    return kNoteValues[juce::jlimit(0, getNumNoteValues() - 1, noteValue)].quarterNotes;
+}
+
+TempoSync::TempoSync()
+{
+    mSampleRate = 44100;
+    reset();
+}
+
+void TempoSync::prepare(double sampleRate)
+{
+    /** the same timeline position, counted at the new rate */
+    mPosition = (juce::int64)std::llround((double)mPosition * sampleRate / mSampleRate);
+    mSampleRate = sampleRate;
+}
+
+void TempoSync::reset()
+{
+    mBpm = kDefaultBpm;
+    mPosition = 0;
+}
+
+void TempoSync::update(juce::AudioPlayHead* playHead)
+{
+    if (playHead == nullptr){
+        return;
+    }
+
+    const auto position = playHead->getPosition();
+
+    if (! position){
+        return;
+    }
+
+    if (const auto bpm = position->getBpm()){
+        if (*bpm > 0){
+            mBpm = *bpm;
+        }
+    }
+
+    /** rounding to the grid recovers the exact sample count the host's PPQ was worked out from */
+    if (const auto ppq = position->getPpqPosition()){
+        mPosition = (juce::int64)std::llround(*ppq * 60.0 / mBpm * mSampleRate);
+    }
+}
+
+void TempoSync::fillPhases(int noteValue, float* phases, int numSamples)
+{
+    const double samplesPerCycle = getSamplesPerCycle(noteValue);
+
+    for (int i = 0; i < numSamples; i++){
+        phases[i] = (float)getPhase(mPosition + i, samplesPerCycle);
+    }
+
+    mPosition += numSamples;
+}
+
+double TempoSync::getPhase(int noteValue) const
+{
+    return getPhase(mPosition, getSamplesPerCycle(noteValue));
+}
+
+double TempoSync::getPhase(juce::int64 position, double samplesPerCycle)
+{
+    /** a count-in before the start of the timeline has negative positions */
+    const double phase = std::fmod((double)position, samplesPerCycle) / samplesPerCycle;
+    return phase < 0 ? phase + 1.0 : phase;
+}
+
+double TempoSync::getSamplesPerCycle(int noteValue) const
+{
+    return getQuarterNotes(noteValue) * 60.0 / mBpm * mSampleRate;
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    TempoSync.h
+    Created: 18 Oct 2026 1:41:19am
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    LFO phase as a function of the host's timeline, for note-value rates.
+
+    At the start of each block the play head's PPQ position is rounded to a
+    sample count on the current tempo's grid. The phase of sample n is then
+    (n mod samples per cycle) / samples per cycle, worked out from n alone. The
+    same timeline position gives the same phase bit for bit, whether a render
+    starts at the beginning, in the middle, or is split into regions rendered in
+    parallel.
+
+    Without a play head, or while the host gives no PPQ or tempo, the position
+    counts on from the last block at the last known tempo.
+*/
+class TempoSync
+{
+public:
+
+    /** 4/4 note values, from eight whole notes down to a thirty-second */
+    static int getNumNoteValues();
+    static juce::StringArray getNoteValueNames();
+
+    /** the length of one LFO cycle in quarter notes */
+    static double getQuarterNotes(int noteValue);
+
+    /** one cycle per beat */
+    static constexpr int kDefaultNoteValue = 7;
+
+    /** the tempo assumed until the host reports one */
+    static constexpr double kDefaultBpm = 120.0;
+
+    TempoSync();
+
+    /** the rate positions are counted at, the processing rate including any oversampling.
+        The current position is kept, rescaled to the new rate */
+    void prepare(double sampleRate);
+
+    /** back to the start of the timeline at the default tempo */
+    void reset();
+
+    /** read the play head at the start of a block, playHead may be nullptr */
+    void update(juce::AudioPlayHead* playHead);
+
+    /** phases from the current position on, then move the position past them */
+    void fillPhases(int noteValue, float* phases, int numSamples);
+
+    /** the phase at the current position */
+    double getPhase(int noteValue) const;
+
+    void advance(int numSamples)        { mPosition += numSamples; }
+
+    juce::int64 getPosition() const     { return mPosition; }
+    double getBpm() const               { return mBpm; }
+
+private:
+
+    double getSamplesPerCycle(int noteValue) const;
+    static double getPhase(juce::int64 position, double samplesPerCycle);
+
+    double mSampleRate;
+    double mBpm;
+
+    /** samples since the start of the timeline, on the current tempo's grid */
+    juce::int64 mPosition;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TempoSync)
+};
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    AllocationChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include "AllocationCounter.h"
+
+namespace
+{
+    void allocations(const juce::ArgumentList&)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr int kBlockSize = 512;
+        constexpr int kNumBlocks = 200;
+
+        KPChorusFlangerAudioProcessor processor;
+        processor.setPlayConfigDetails(2, 2, kSampleRate, kBlockSize);
+
+        /** only the first prepare may allocate, everything after it reuses that memory */
+        processor.prepareToPlay(kSampleRate, kBlockSize);
+
+        juce::AudioBuffer<float> buffer (2, kBlockSize);
+        juce::MidiBuffer midi;
+        midi.addEvent(juce::MidiMessage::controllerEvent(1, 1, 100), kBlockSize / 2);
+        juce::Random random (1);
+
+        auto setParameter = [&processor] (const juce::String& parameterID, float value)
+        {
+            for (auto* parameter : processor.getParameters()){
+                if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)){
+                    if (ranged->paramID == parameterID){
+                        ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+                    }
+                }
+            }
+        };
+
+        auto processBlocks = [&] (int numBlocks)
+        {
+            for (int block = 0; block < numBlocks; block++){
+                for (int channel = 0; channel < buffer.getNumChannels(); channel++){
+                    for (int i = 0; i < kBlockSize; i++){
+                        buffer.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+                    }
+                }
+                processor.processBlock(buffer, midi);
+            }
+        };
+
+        auto prepareAt = [&processor] (double sampleRate, int blockSize)
+        {
+            processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+            processor.prepareToPlay(sampleRate, blockSize);
+        };
+
+        struct Step
+        {
+            const char* name;
+            std::function<void()> run;
+        };
+
+        const Step steps[] =
+        {
+            { "processBlock", [&] { processBlocks(kNumBlocks); } },
+            { "prepareToPlay, same format", [&] { for (int i = 0; i < 10; i++){ prepareAt(kSampleRate, kBlockSize); } } },
+            { "prepareToPlay, 44.1 kHz and back", [&] { prepareAt(44100, kBlockSize); processBlocks(10); prepareAt(kSampleRate, kBlockSize); } },
+            { "prepareToPlay, smaller block and back", [&] { prepareAt(kSampleRate, 64); prepareAt(kSampleRate, kBlockSize); } },
+            { "prepareToPlay, offline and back", [&] { processor.setNonRealtime(true); prepareAt(kSampleRate, kBlockSize);
+                                                       processor.setNonRealtime(false); prepareAt(kSampleRate, kBlockSize); } },
+            { "releaseResources, then prepareToPlay", [&] { processor.releaseResources(); prepareAt(kSampleRate, kBlockSize); } },
+            { "reset", [&] { processor.reset(); } },
+            { "oversampling changes", [&] { for (int factor : { 3, 1, 2, 0 }){ setParameter("oversampling", (float)factor); processBlocks(10); } } },
+            { "voice and interpolation changes", [&] { for (int mode = 0; mode < DelayLineReader::kNumModes; mode++){
+                                                           setParameter("interpolation", (float)mode);
+                                                           setParameter("voices", (float)(1 + mode));
+                                                           processBlocks(10); } } },
+            { "preset recall and morph", [&] { for (int program : { 5, 1, 6, 0 }){ processor.setCurrentProgram(program); processBlocks(10); }
+                                               setParameter("morphtarget", 6.f);
+                                               for (float amount : { 0.25f, 0.75f, 0.f }){ setParameter("morph", amount); processBlocks(10); } } },
+        };
+
+        std::cout << (AllocationCounter::isCountingMalloc() ? "Counting malloc and operator new" : "Counting operator new only")
+                  << std::endl;
+
+        int numFailures = 0;
+
+        for (const auto& step : steps){
+            AllocationCounter counter;
+            step.run();
+            const auto numAllocations = counter.getNumAllocations();
+
+            std::cout << juce::String(step.name).paddedRight(' ', 40) << numAllocations << " allocations" << std::endl;
+
+            if (numAllocations > 0){
+                numFailures++;
+            }
+        }
+
+        if (numFailures > 0){
+            juce::ConsoleApplication::fail(juce::String(numFailures) + " steps allocated");
+        }
+    }
+}
+
+void BenchmarkCommands::addAllocationChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "allocations",
+                     "allocations",
+                     "Checks that processing, repeated prepareToPlay calls and preset recall do not allocate.",
+                     "Prepares once, then counts heap allocations during processBlock, prepareToPlay\n"
+                     "at the same and at smaller formats, releaseResources, reset, parameter\n"
+                     "changes, preset recall and morphing. Fails if any step allocates.",
+                     allocations });
+}
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.cpp
+    Created: 17 Oct 2026 11:12:08pm
+
+  ==============================================================================
+*/
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <new>
+
+namespace
+{
+    /** counts from the start of the program, a counter takes the difference */
+    std::atomic<juce::int64> gNumAllocations { 0 };
+    std::atomic<juce::int64> gNumBytes { 0 };
+
+    void countAllocation(size_t size)
+    {
+        gNumAllocations.fetch_add(1, std::memory_order_relaxed);
+        gNumBytes.fetch_add((juce::int64)size, std::memory_order_relaxed);
+    }
+}
+
+#if JUCE_LINUX
+
+/** glibc's own entry points, wrapping them lets the replacements below avoid dlsym */
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+
+    void* malloc(size_t size)
+    {
+        countAllocation(size);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t numElements, size_t elementSize)
+    {
+        countAllocation(numElements * elementSize);
+        return __libc_calloc(numElements, elementSize);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        countAllocation(size);
+        return __libc_realloc(pointer, size);
+    }
+
+    void* memalign(size_t alignment, size_t size)
+    {
+        countAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size)
+    {
+        countAllocation(size);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size)
+    {
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0){
+            return EINVAL;
+        }
+
+        countAllocation(size);
+        void* result = __libc_memalign(alignment, size);
+
+        if (result == nullptr){
+            return ENOMEM;
+        }
+
+        *pointer = result;
+        return 0;
+    }
+}
+
+#else
+
+/** operator new is all that can be replaced portably, the default new[] and nothrow versions call it */
+void* operator new (size_t size)
+{
+    countAllocation(size);
+
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)){
+        return pointer;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete (void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete (void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#endif
+
+//==============================================================================
+AllocationCounter::AllocationCounter()
+{
+    mStart = gNumAllocations.load();
+    mStartBytes = gNumBytes.load();
+}
+
+juce::int64 AllocationCounter::getNumAllocations() const
+{
+    return gNumAllocations.load() - mStart;
+}
+
+juce::int64 AllocationCounter::getNumBytes() const
+{
+    return gNumBytes.load() - mStartBytes;
+}
+
+bool AllocationCounter::isCountingMalloc()
+{
+   #if JUCE_LINUX
+    return true;
+   #else
+    return false;
+   #endif
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    AllocationCounter.h
+    Created: 17 Oct 2026 11:12:08pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Counts the heap allocations made on any thread while it is alive.
+
+    On Linux malloc and its relatives are wrapped, so allocations through
+    juce::HeapBlock and AudioBuffer are seen as well as operator new. Elsewhere
+    only operator new is replaced, and memory taken straight from malloc is
+    not counted.
+*/
+class AllocationCounter
+{
+public:
+
+    AllocationCounter();
+
+    juce::int64 getNumAllocations() const;
+
+    /** bytes those allocations asked for, memory freed since is not taken off */
+    juce::int64 getNumBytes() const;
+
+    /** true where malloc itself is counted, not only operator new */
+    static bool isCountingMalloc();
+
+private:
+
+    juce::int64 mStart;
+    juce::int64 mStartBytes;
+
+    JUCE_DECLARE_NON_COPYABLE (AllocationCounter)
+};
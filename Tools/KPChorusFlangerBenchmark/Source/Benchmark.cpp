@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    Benchmark.cpp
+    Created: 17 Oct 2026 6:02:44pm
+
+  ==============================================================================
+*/
+
+#include "Benchmark.h"
+
+namespace
+{
+    const int kBlockSizes[] = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    const int kQuickBlockSizes[] = { 16, 512, 4096 };
+
+    const double kSampleRates[] = { 44100, 48000, 96000, 192000 };
+    const double kQuickSampleRates[] = { 48000, 192000 };
+
+    juce::RangedAudioParameter* findParameter(juce::AudioProcessor& processor, const juce::String& parameterID)
+    {
+        for (auto* parameter : processor.getParameters()){
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)){
+                if (ranged->paramID == parameterID){
+                    return ranged;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    double median(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+
+        const size_t middle = values.size() / 2;
+        return (values.size() % 2 == 1) ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+    }
+}
+
+//==============================================================================
+juce::String BenchmarkCase::getName() const
+{
+    return type + "/" + settingsName + "/" + juce::String((int)sampleRate) + "/" + juce::String(blockSize);
+}
+
+double BenchmarkResult::getMetric(const juce::String& metric) const
+{
+    if (metric == "cycles")         return cyclesPerSample;
+    if (metric == "instructions")   return instructionsPerSample;
+    return nsPerSample;
+}
+
+//==============================================================================
+Benchmark::Benchmark(int numFrames, int numRuns)
+    : mNumFrames(juce::jmax(1, numFrames)),
+      mNumRuns(juce::jmax(1, numRuns)),
+      mSource(kNumChannels, mNumFrames),
+      mWork(kNumChannels, mNumFrames),
+      mDoubleWork(kNumChannels, mNumFrames)
+{
+    /** a fixed seed, so every run of the benchmark processes the same input */
+    juce::Random random (0x4b50);
+
+    for (int channel = 0; channel < kNumChannels; channel++){
+        float* data = mSource.getWritePointer(channel);
+        for (int i = 0; i < mNumFrames; i++){
+            data[i] = random.nextFloat() * 2.f - 1.f;
+        }
+    }
+}
+
+std::vector<BenchmarkCase> Benchmark::createCases(bool quick)
+{
+    const std::vector<int> blockSizes = quick ? std::vector<int>(std::begin(kQuickBlockSizes), std::end(kQuickBlockSizes))
+                                              : std::vector<int>(std::begin(kBlockSizes), std::end(kBlockSizes));
+
+    const std::vector<double> sampleRates = quick ? std::vector<double>(std::begin(kQuickSampleRates), std::end(kQuickSampleRates))
+                                                  : std::vector<double>(std::begin(kSampleRates), std::end(kSampleRates));
+
+    /** extreme is the most expensive corner: longest feedback tail, fastest and widest sweep */
+    const std::pair<juce::String, std::map<juce::String, float>> settings[] = {
+        { "default", {} },
+        { "extreme", { { "feedback", 0.98f }, { "rate", 20.f }, { "depth", 1.f } } }
+    };
+
+    std::vector<BenchmarkCase> cases;
+
+    for (int type = 0; type < 2; type++){
+        for (const auto& setting : settings){
+            for (double sampleRate : sampleRates){
+                for (int blockSize : blockSizes){
+                    BenchmarkCase benchmarkCase;
+                    benchmarkCase.type = (type == 0) ? "chorus" : "flanger";
+                    benchmarkCase.settingsName = setting.first;
+                    benchmarkCase.sampleRate = sampleRate;
+                    benchmarkCase.blockSize = blockSize;
+                    benchmarkCase.parameterValues = setting.second;
+                    benchmarkCase.parameterValues["type"] = (float)type;
+                    cases.push_back(benchmarkCase);
+                }
+            }
+        }
+    }
+
+    return cases;
+}
+
+BenchmarkResult Benchmark::runCase(const BenchmarkCase& benchmarkCase, bool useReferenceProcessing)
+{
+    /** a fresh processor per case, so no case inherits the delay line or smoothers of another */
+    KPChorusFlangerAudioProcessor processor;
+
+    for (const auto& value : benchmarkCase.parameterValues){
+        if (auto* parameter = findParameter(processor, value.first)){
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value.second));
+        }
+    }
+
+    processor.setUseReferenceProcessing(useReferenceProcessing);
+    processor.setNonRealtime(true);
+    processor.setProcessingPrecision(benchmarkCase.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                                   : juce::AudioProcessor::singlePrecision);
+    processor.setPlayConfigDetails(kNumChannels, kNumChannels, benchmarkCase.sampleRate, benchmarkCase.blockSize);
+    processor.prepareToPlay(benchmarkCase.sampleRate, benchmarkCase.blockSize);
+
+    /** the warm-up settles the smoothers and pulls code, tables and the delay line into cache.
+        Silent input is warmed up until the tail has run out */
+    fillWork(benchmarkCase);
+    processAll(processor, benchmarkCase);
+
+    for (int pass = 0; pass < 100 && benchmarkCase.silentInput && ! processor.isIdle(); pass++){
+        processAll(processor, benchmarkCase);
+    }
+
+    std::vector<double> ns, cycles, instructions;
+    const auto numBlocksBefore = processor.getNumBlocks();
+    const auto numSkippedBlocksBefore = processor.getNumSkippedBlocks();
+
+    for (int run = 0; run < mNumRuns; run++){
+        fillWork(benchmarkCase);
+
+        mCounters.start();
+        const juce::int64 startTicks = juce::Time::getHighResolutionTicks();
+
+        processAll(processor, benchmarkCase);
+
+        const juce::int64 endTicks = juce::Time::getHighResolutionTicks();
+        const auto reading = mCounters.stop();
+
+        ns.push_back(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1.0e9 / mNumFrames);
+        cycles.push_back(reading.cycles / mNumFrames);
+        instructions.push_back(reading.instructions / mNumFrames);
+    }
+
+    processor.releaseResources();
+
+    BenchmarkResult result;
+    result.name = benchmarkCase.getName();
+    result.nsPerSample = median(ns);
+    result.cyclesPerSample = median(cycles);
+    result.instructionsPerSample = median(instructions);
+    result.numBlocks = processor.getNumBlocks() - numBlocksBefore;
+    result.numSkippedBlocks = processor.getNumSkippedBlocks() - numSkippedBlocksBefore;
+    return result;
+}
+
+void Benchmark::fillWork(const BenchmarkCase& benchmarkCase)
+{
+    if (benchmarkCase.silentInput){
+        mWork.clear();
+        mDoubleWork.clear();
+        return;
+    }
+
+    for (int channel = 0; channel < kNumChannels; channel++){
+        if (benchmarkCase.doublePrecision){
+            const float* source = mSource.getReadPointer(channel);
+            double* destination = mDoubleWork.getWritePointer(channel);
+
+            for (int i = 0; i < mNumFrames; i++){
+                destination[i] = source[i];
+            }
+        } else {
+            mWork.copyFrom(channel, 0, mSource, channel, 0, mNumFrames);
+        }
+    }
+}
+
+void Benchmark::processAll(KPChorusFlangerAudioProcessor& processor, const BenchmarkCase& benchmarkCase)
+{
+    if (benchmarkCase.doublePrecision){
+        processBlocks(processor, mDoubleWork, benchmarkCase.blockSize);
+    } else {
+        processBlocks(processor, mWork, benchmarkCase.blockSize);
+    }
+}
+
+template <typename SampleType>
+void Benchmark::processBlocks(KPChorusFlangerAudioProcessor& processor, juce::AudioBuffer<SampleType>& work, int blockSize)
+{
+    SampleType* const* channels = work.getArrayOfWritePointers();
+
+    for (int start = 0; start < mNumFrames; start += blockSize){
+        /** a view into the work buffer, like the host buffer of one callback */
+        juce::AudioBuffer<SampleType> block (channels, kNumChannels, start, juce::jmin(blockSize, mNumFrames - start));
+
+        mMidi.clear();
+        processor.processBlock(block, mMidi);
+    }
+}
+
+//==============================================================================
+juce::String Benchmark::toJSON(const std::vector<BenchmarkResult>& results) const
+{
+    juce::Array<juce::var> cases;
+
+    for (const auto& result : results){
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("name", result.name);
+        entry->setProperty("nsPerSample", result.nsPerSample);
+        entry->setProperty("cyclesPerSample", result.cyclesPerSample);
+        entry->setProperty("instructionsPerSample", result.instructionsPerSample);
+        cases.add(juce::var(entry));
+    }
+
+    auto* document = new juce::DynamicObject();
+    document->setProperty("version", kFileVersion);
+    document->setProperty("cpu", juce::SystemStats::getCpuModel());
+    document->setProperty("cycleSource", mCounters.getCycleSource());
+    document->setProperty("numFrames", mNumFrames);
+    document->setProperty("numRuns", mNumRuns);
+    document->setProperty("cases", cases);
+
+    return juce::JSON::toString(juce::var(document));
+}
+
+juce::Result Benchmark::fromJSON(const juce::String& json, std::vector<BenchmarkResult>& results)
+{
+    juce::var document;
+    const auto parsed = juce::JSON::parse(json, document);
+
+    if (parsed.failed()){
+        return parsed;
+    }
+
+    if ((int)document.getProperty("version", 0) != kFileVersion){
+        return juce::Result::fail("Unsupported baseline version");
+    }
+
+    const auto* cases = document.getProperty("cases", juce::var()).getArray();
+
+    if (cases == nullptr){
+        return juce::Result::fail("Baseline has no cases");
+    }
+
+    results.clear();
+
+    for (const auto& entry : *cases){
+        BenchmarkResult result;
+        result.name = entry.getProperty("name", juce::var()).toString();
+        result.nsPerSample = entry.getProperty("nsPerSample", 0);
+        result.cyclesPerSample = entry.getProperty("cyclesPerSample", 0);
+        result.instructionsPerSample = entry.getProperty("instructionsPerSample", 0);
+        results.push_back(result);
+    }
+
+    return juce::Result::ok();
+}
+
+int Benchmark::compare(const std::vector<BenchmarkResult>& baseline,
+                       const std::vector<BenchmarkResult>& current,
+                       const juce::String& metric,
+                       double thresholdPercent,
+                       std::ostream& report)
+{
+    int numRegressions = 0;
+
+    for (const auto& result : current){
+        auto match = std::find_if(baseline.begin(), baseline.end(),
+                                  [&result] (const BenchmarkResult& b) { return b.name == result.name; });
+
+        if (match == baseline.end()){
+            report << result.name << ": not in baseline" << std::endl;
+            continue;
+        }
+
+        const double before = match->getMetric(metric);
+        const double after = result.getMetric(metric);
+
+        /** a metric this machine or the baseline machine could not count is not compared */
+        if (before <= 0 || after <= 0){
+            report << result.name << ": " << metric << " not available" << std::endl;
+            continue;
+        }
+
+        const double changePercent = (after - before) / before * 100.0;
+        const bool regressed = changePercent > thresholdPercent;
+
+        if (regressed){
+            numRegressions++;
+        }
+
+        report << result.name << ": " << before << " -> " << after << " " << metric << "/sample ("
+               << (changePercent >= 0 ? "+" : "") << changePercent << "%)"
+               << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+
+    return numRegressions;
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    Benchmark.h
+    Created: 17 Oct 2026 6:02:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "PerfCounters.h"
+
+//==============================================================================
+/** one point of the benchmark matrix */
+struct BenchmarkCase
+{
+    juce::String type;
+    juce::String settingsName;
+    double sampleRate = 48000;
+    int blockSize = 512;
+
+    /** plain parameter values keyed by parameter ID, applied on top of the defaults */
+    std::map<juce::String, float> parameterValues;
+
+    /** process digital silence instead of noise, after a warm-up long enough to run out the tail */
+    bool silentInput = false;
+
+    /** process juce::AudioBuffer<double> with the processor prepared for double precision */
+    bool doublePrecision = false;
+
+    /** e.g. "flanger/extreme/96000/64", the key used in baseline files */
+    juce::String getName() const;
+};
+
+/** per-sample cost of one case. A sample is one stereo frame, a value of 0 means not measured */
+struct BenchmarkResult
+{
+    juce::String name;
+    double nsPerSample = 0;
+    double cyclesPerSample = 0;
+    double instructionsPerSample = 0;
+
+    /** blocks in the timed runs, and how many of them the processor skipped as idle */
+    juce::int64 numBlocks = 0;
+    juce::int64 numSkippedBlocks = 0;
+
+    double getMetric(const juce::String& metric) const;
+};
+
+//==============================================================================
+/**
+    Times KPChorusFlangerAudioProcessor::processBlock over the benchmark matrix.
+
+    Every case processes the same pre-generated noise in consecutive blocks of its
+    block size, in single or double precision. The input is copied in before the counters start, so only
+    processBlock is measured. After a warm-up pass each case is run several times
+    and the median of every metric is reported, which keeps a single interrupted
+    run from moving the result.
+*/
+class Benchmark
+{
+public:
+
+    Benchmark(int numFrames, int numRuns);
+
+    /** block sizes 16-4096, 44.1-192 kHz, both types, default and extreme settings.
+        The quick matrix keeps the corners only, for a fast check while working */
+    static std::vector<BenchmarkCase> createCases(bool quick);
+
+    BenchmarkResult runCase(const BenchmarkCase& benchmarkCase, bool useReferenceProcessing);
+
+    const PerfCounters& getCounters() const     { return mCounters; }
+
+    //==============================================================================
+    /** results as a versioned JSON document, the format read back by fromJSON */
+    juce::String toJSON(const std::vector<BenchmarkResult>& results) const;
+
+    static juce::Result fromJSON(const juce::String& json, std::vector<BenchmarkResult>& results);
+
+    /** print how every current result compares with the baseline result of the same name,
+        returns the number of cases whose metric got worse by more than thresholdPercent */
+    static int compare(const std::vector<BenchmarkResult>& baseline,
+                       const std::vector<BenchmarkResult>& current,
+                       const juce::String& metric,
+                       double thresholdPercent,
+                       std::ostream& report);
+
+private:
+
+    static constexpr int kNumChannels = 2;
+    static constexpr int kFileVersion = 1;
+
+    /** process the work buffer of the case's precision in blocks of its block size */
+    void processAll(KPChorusFlangerAudioProcessor& processor, const BenchmarkCase& benchmarkCase);
+
+    template <typename SampleType>
+    void processBlocks(KPChorusFlangerAudioProcessor& processor, juce::AudioBuffer<SampleType>& work, int blockSize);
+
+    void fillWork(const BenchmarkCase& benchmarkCase);
+
+    const int mNumFrames;
+    const int mNumRuns;
+
+    juce::AudioBuffer<float> mSource;
+    juce::AudioBuffer<float> mWork;
+    juce::AudioBuffer<double> mDoubleWork;
+    juce::MidiBuffer mMidi;
+
+    PerfCounters mCounters;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Benchmark)
+};
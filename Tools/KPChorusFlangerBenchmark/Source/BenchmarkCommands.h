@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    BenchmarkCommands.h
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Benchmark.h"
+#include "RenderCheck.h"
+
+//==============================================================================
+/**
+    The benchmark's commands, one source file per feature. Each file registers
+    its own commands with their help text, main() adds them in this order.
+*/
+namespace BenchmarkCommands
+{
+    /** about 1.4 s of audio at 48 kHz, long enough to cover many LFO cycles at the default rate */
+    constexpr int kNumFrames = 65536;
+    constexpr int kNumRuns = 5;
+
+    /** run: the timing matrix and its baselines, RegressionChecks.cpp */
+    void addRegressionChecks(juce::ConsoleApplication& app);
+
+    /** voices, VoiceChecks.cpp */
+    void addVoiceChecks(juce::ConsoleApplication& app);
+
+    /** wrap and report, InterpolationChecks.cpp */
+    void addInterpolationChecks(juce::ConsoleApplication& app);
+
+    /** idle, IdleChecks.cpp */
+    void addIdleChecks(juce::ConsoleApplication& app);
+
+    /** allocations, AllocationChecks.cpp */
+    void addAllocationChecks(juce::ConsoleApplication& app);
+
+    /** state, StateChecks.cpp */
+    void addStateChecks(juce::ConsoleApplication& app);
+
+    /** temposync, TempoSyncChecks.cpp */
+    void addTempoSyncChecks(juce::ConsoleApplication& app);
+
+    /** engine, EngineChecks.cpp */
+    void addEngineChecks(juce::ConsoleApplication& app);
+
+    /** batch, BatchChecks.cpp */
+    void addBatchChecks(juce::ConsoleApplication& app);
+
+    /** streaming, StreamingChecks.cpp */
+    void addStreamingChecks(juce::ConsoleApplication& app);
+
+    /** reference, ReferenceChecks.cpp */
+    void addReferenceChecks(juce::ConsoleApplication& app);
+
+    /** midi, MidiChecks.cpp */
+    void addMidiChecks(juce::ConsoleApplication& app);
+
+    /** typeswitch, TypeSwitchChecks.cpp */
+    void addTypeSwitchChecks(juce::ConsoleApplication& app);
+
+    /** morph, MorphChecks.cpp */
+    void addMorphChecks(juce::ConsoleApplication& app);
+
+    /** isa, IsaChecks.cpp */
+    void addIsaChecks(juce::ConsoleApplication& app);
+}
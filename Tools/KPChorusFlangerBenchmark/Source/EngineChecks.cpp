@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    EngineChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include "AllocationCounter.h"
+
+namespace
+{
+    void engine(const juce::ArgumentList& args)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr int kBlockSize = 512;
+
+        const int numBlocks = args.containsOption("--quick") ? 64 : 256;
+        const auto input = RenderCheck::createNoise(2, numBlocks * kBlockSize);
+
+        std::cout << "Engine against the processor it sits in, max difference" << std::endl;
+
+        RenderCheck::Comparison comparison (0);
+
+        for (int type = 0; type < 2; type++){
+            for (int oversampling : { 0, 2 }){
+                auto processor = RenderCheck::createProcessor(kSampleRate, kBlockSize,
+                                                              { { "type", (float)type }, { "oversampling", (float)oversampling },
+                                                                { "voices", 3.f }, { "feedback", 0.7f } });
+
+                juce::AudioBuffer<float> processed;
+                processed.makeCopyOf(input);
+                RenderCheck::renderProcessor(*processor, processed, kBlockSize);
+
+                /** the engine on its own, out of place, with the least memory these settings need */
+                RenderCheck::EngineSettings settings;
+                settings.snapshot.type = type;
+                settings.snapshot.oversampling = oversampling;
+                settings.snapshot.voices = 3;
+                settings.snapshot.feedback = 0.7f;
+                settings.sampleRate = kSampleRate;
+                settings.blockSize = kBlockSize;
+                settings.maxOversamplingIndex = oversampling;
+                settings.outOfPlace = true;
+
+                juce::AudioBuffer<float> output;
+                RenderCheck::renderEngine(settings, input, output);
+
+                std::cout << (type == 0 ? "Chorus  " : "Flanger ") << Oversampler::getFactorNames()[oversampling].paddedRight(' ', 6)
+                          << comparison.compare(processed, output) << std::endl;
+            }
+        }
+
+        /** the heap the engine asks for, on top of the object itself */
+        auto measure = [] (int maxOversamplingIndex)
+        {
+            const AllocationCounter counter;
+            auto chorusFlanger = std::make_unique<ChorusFlangerEngine>();
+            chorusFlanger->setMemoryReservation(kSampleRate, maxOversamplingIndex);
+            chorusFlanger->prepare(kSampleRate, kBlockSize, 2);
+            return counter.getNumBytes();
+        };
+
+        std::cout << std::endl << "Footprint at 48 kHz, stereo, " << kBlockSize << " samples" << std::endl
+                  << "  object                    " << sizeof(ChorusFlangerEngine) << " bytes" << std::endl
+                  << "  prepared for up to 8x     " << measure(Oversampler::kMaxFactorIndex) << " bytes" << std::endl
+                  << "  prepared for 1x only      " << measure(0) << " bytes" << std::endl;
+
+        if (! AllocationCounter::isCountingMalloc()){
+            std::cout << "  (only operator new is counted on this platform)" << std::endl;
+        }
+
+        comparison.check("engine renders differ from the processor");
+    }
+}
+
+void BenchmarkCommands::addEngineChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "engine",
+                     "engine [--quick]",
+                     "Checks the standalone engine against the processor and reports its footprint.",
+                     "Renders noise through the processor and through a ChorusFlangerEngine used on its\n"
+                     "own, out of place and with only the memory its settings need, for both types at\n"
+                     "1x and 4x. Fails unless they are bit-identical. Then prints the size of an engine\n"
+                     "and the heap it takes when prepared for every factor and for 1x only.",
+                     engine });
+}
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    IdleChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void idle(const juce::ArgumentList& args)
+    {
+        using namespace BenchmarkCommands;
+
+        const bool quick = args.containsOption("--quick");
+        Benchmark benchmark (quick ? kNumFrames / 4 : kNumFrames, quick ? 3 : kNumRuns);
+
+        BenchmarkCase benchmarkCase;
+        benchmarkCase.type = "chorus";
+        benchmarkCase.settingsName = "default";
+        benchmarkCase.sampleRate = 48000;
+        benchmarkCase.blockSize = 512;
+
+        const auto active = benchmark.runCase(benchmarkCase, false);
+
+        benchmarkCase.settingsName = "silent";
+        benchmarkCase.silentInput = true;
+        const auto silent = benchmark.runCase(benchmarkCase, false);
+
+        std::cout << "Input    ns/sample  skipped blocks" << std::endl;
+
+        for (const auto* result : { &active, &silent }){
+            std::cout << juce::String(result == &active ? "noise" : "silence").paddedRight(' ', 9)
+                      << juce::String(result->nsPerSample, 2).paddedRight(' ', 11)
+                      << result->numSkippedBlocks << " of " << result->numBlocks << std::endl;
+        }
+
+        std::cout << "Tail at the default settings: " << KPChorusFlangerAudioProcessor().getTailLengthSeconds() << " s" << std::endl;
+
+        /** noise with a gap of digital silence longer than the tail, rendered in blocks, which go idle and
+            skip the rest of the gap, and as one call, which never does. Once the input is back the only
+            difference left is the tail below ChorusFlangerEngine::kTailLevel that going idle cleared */
+        constexpr double kSampleRate = 48000;
+        constexpr int kBlockSize = 512;
+        constexpr int kNumSamples = 262144;
+        constexpr int kGapStart = kNumSamples / 8;
+        constexpr int kGapEnd = 5 * kNumSamples / 8;
+
+        auto input = RenderCheck::createNoise(2, kNumSamples);
+        input.clear(kGapStart, kGapEnd - kGapStart);
+
+        juce::AudioBuffer<float> continuous;
+        juce::AudioBuffer<float> skipped;
+        RenderCheck::Comparison afterGap (ChorusFlangerEngine::kTailLevel);
+
+        std::cout << std::endl << "After an idle gap against no gap, max difference" << std::endl;
+
+        for (int type = 0; type < 2; type++){
+            for (int oversampling : { 0, 2 }){
+                for (float feedback : { 0.f, 0.5f }){
+                    RenderCheck::EngineSettings settings;
+                    settings.snapshot.type = type;
+                    settings.snapshot.oversampling = oversampling;
+                    settings.snapshot.feedback = feedback;
+                    settings.snapshot.voices = 3;
+                    settings.snapshot.rate = 3.f;
+                    settings.snapshot.waveform = type + oversampling;
+                    settings.sampleRate = kSampleRate;
+                    settings.preparedBlockSize = kBlockSize;
+
+                    settings.blockSize = kNumSamples;
+                    RenderCheck::renderEngine(settings, input, continuous);
+
+                    settings.blockSize = kBlockSize;
+                    const auto numSkipped = RenderCheck::renderEngine(settings, input, skipped).numSkippedBlocks;
+
+                    const auto maxDifference = afterGap.compare(continuous, skipped, kGapEnd);
+
+                    std::cout << (type == 0 ? "Chorus  " : "Flanger ") << Oversampler::getFactorNames()[oversampling].paddedRight(' ', 4)
+                              << "feedback " << juce::String(feedback, 1).paddedRight(' ', 5)
+                              << juce::String(numSkipped).paddedRight(' ', 4) << "skipped  " << maxDifference << std::endl;
+
+                    if (numSkipped == 0){
+                        afterGap.addFailure();
+                    }
+                }
+            }
+        }
+
+        /** a new oversampling factor clears the delay line, so while the noise plays it has to wait. The
+            output up to the gap is the same as without the change, and the gap switches the factor */
+        {
+            ParameterSnapshot snapshot;
+            snapshot.feedback = 0.5f;
+
+            auto changed = snapshot;
+            changed.oversampling = 2;
+
+            ChorusFlangerEngine unchanged, switched;
+            juce::AudioBuffer<float> unchangedOutput, switchedOutput;
+            int latencyBeforeGap = 0;
+
+            for (auto* chorusFlanger : { &unchanged, &switched }){
+                chorusFlanger->setParameters(snapshot);
+                chorusFlanger->prepare(kSampleRate, kBlockSize, 2);
+            }
+
+            unchangedOutput.makeCopyOf(input);
+            switchedOutput.makeCopyOf(input);
+
+            for (int position = 0; position < kNumSamples; position += kBlockSize){
+                if (position == kGapStart / 2){
+                    switched.setParameters(changed);
+                }
+
+                if (position == kGapStart){
+                    latencyBeforeGap = switched.getLatencySamples();
+                }
+
+                float* unchangedBlock[] = { unchangedOutput.getWritePointer(0, position), unchangedOutput.getWritePointer(1, position) };
+                float* switchedBlock[] = { switchedOutput.getWritePointer(0, position), switchedOutput.getWritePointer(1, position) };
+                unchanged.process(unchangedBlock, unchangedBlock, kBlockSize);
+                switched.process(switchedBlock, switchedBlock, kBlockSize);
+            }
+
+            const auto maxDifference = RenderCheck::getMaxDifference(unchangedOutput, switchedOutput, 0, kGapStart);
+
+            std::cout << std::endl << "1x to 4x while playing: max difference before the gap " << maxDifference
+                      << ", latency " << latencyBeforeGap << " before the gap and " << switched.getLatencySamples() << " after" << std::endl;
+
+            if (maxDifference > 0 || latencyBeforeGap != 0 || switched.getLatencySamples() == 0){
+                afterGap.addFailure();
+            }
+        }
+
+        /** a Type switched during the gap has nothing left to fade out, so once the noise is back the output
+            is the same as from an engine that had the new Type all along */
+        for (int type = 0; type < ChorusFlangerEngine::kNumTypes; type++){
+            RenderCheck::EngineSettings settings;
+            settings.snapshot.type = 1 - type;
+            settings.changed.type = type;
+            settings.changeSample = (kGapStart + kGapEnd) / 2;
+            settings.sampleRate = kSampleRate;
+            settings.blockSize = kBlockSize;
+
+            juce::AudioBuffer<float> switched;
+            const auto numSkipped = RenderCheck::renderEngine(settings, input, switched).numSkippedBlocks;
+
+            settings.snapshot.type = type;
+            juce::AudioBuffer<float> unswitched;
+            RenderCheck::renderEngine(settings, input, unswitched);
+
+            std::cout << (type == 0 ? "Flanger to Chorus" : "Chorus to Flanger") << " in the gap, "
+                      << numSkipped << " skipped, max difference after it "
+                      << afterGap.compare(unswitched, switched, kGapEnd) << std::endl;
+        }
+
+        afterGap.check("renders differ after an idle gap, or switched oversampling or Type in one");
+    }
+}
+
+void BenchmarkCommands::addIdleChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "idle",
+                     "idle [--quick]",
+                     "Times the chorus on noise and on digital silence.",
+                     "Silence is timed after the feedback tail has run out, when the processor\n"
+                     "skips its blocks. Also reports how many blocks were skipped. Then renders noise\n"
+                     "with a long gap of silence in blocks, which skip the gap, and in one call, which\n"
+                     "does not. Fails if the output after the gap differs by more than -120 dB. Then asks\n"
+                     "for 4x oversampling while the noise plays, and fails unless the factor waits for\n"
+                     "the gap and the output before it is unchanged. Last switches Type in the gap, and\n"
+                     "fails unless the output after it matches an engine that had the new Type all along.",
+                     idle });
+}
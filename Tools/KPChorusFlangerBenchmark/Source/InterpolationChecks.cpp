@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    InterpolationChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void wrap(const juce::ArgumentList&)
+    {
+        constexpr int kNumSamples = 16;
+
+        DelayLine delayLine;
+        delayLine.prepare(48000, 0.05f, 1);
+        delayLine.setSample(0, 0, 1.0f);
+
+        /** a position a hair below zero wraps to exactly the length once it is rounded to float */
+        const float position = (float)(delayLine.getLength() - 1.0e-6);
+
+        if (position != (float)delayLine.getLength()){
+            juce::ConsoleApplication::fail("The test position does not round to the length");
+        }
+
+        DelayLineReader reader;
+        reader.prepare(kNumSamples);
+        reader.setMode(DelayLineReader::kLinear);
+
+        std::vector<float> positions ((size_t)kNumSamples, position);
+        std::vector<float> read ((size_t)kNumSamples, 0.0f);
+        std::vector<float> added ((size_t)kNumSamples, 0.0f);
+
+        reader.read(delayLine, 0, positions.data(), read.data(), kNumSamples);
+        reader.readAndAdd(delayLine, 0, positions.data(), 1.0f, added.data(), kNumSamples, 0);
+
+        for (int i = 0; i < kNumSamples; i++){
+            if (read[(size_t)i] != 1.0f || added[(size_t)i] != 1.0f){
+                juce::ConsoleApplication::fail("A linear read just below zero did not read frame 0: "
+                                               + juce::String(read[(size_t)i]) + ", " + juce::String(added[(size_t)i]));
+            }
+        }
+
+        std::cout << "Linear reads at " << position << " of a " << delayLine.getLength()
+                  << " frame line read frame 0" << std::endl;
+    }
+
+    void report(const juce::ArgumentList&)
+    {
+        std::cout << "LFO backends:" << std::endl << LFO::createBackendReport() << std::endl
+                  << "Delay line interpolation:" << std::endl << DelayLineReader::createReport() << std::endl;
+    }
+}
+
+void BenchmarkCommands::addInterpolationChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "wrap",
+                     "wrap",
+                     "Checks that a linear read just below zero reads frame 0.",
+                     "Reads and mixes at a position a hair below zero, which wraps to exactly the\n"
+                     "delay length once rounded to float. Fails unless both read frame 0.",
+                     wrap });
+
+    app.addCommand({ "report",
+                     "report",
+                     "Prints the accuracy and cost of the LFO backends and the delay line interpolators.",
+                     "Each LFO backend is compared with std::sin. Each interpolator is measured on a\n"
+                     "high sine read half a sample late, and on a sine read through a sweeping delay.",
+                     report });
+}
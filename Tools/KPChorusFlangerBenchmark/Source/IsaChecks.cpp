@@ -0,0 +1,493 @@
+/*
+  ==============================================================================
+
+    IsaChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include "DspKernels.h"
+#include "ChorusFlangerBatch.h"
+
+namespace
+{
+    /** runs one kernel on fixed input with the copy of an Isa and returns everything it wrote */
+    using KernelCheck = std::function<std::vector<double>(DspKernels::Isa)>;
+
+    template <typename SampleType>
+    void addKernelChecks(std::vector<std::pair<juce::String, KernelCheck>>& checks, const juce::String& precision)
+    {
+        /** an odd length, so the vector loops also run their remainders */
+        constexpr int kNumSamples = 1001;
+        constexpr int kLength = 1024;
+        constexpr int kStride = 2;
+        constexpr int kNumTaps = 8;
+        constexpr int kNumPhases = 64;
+
+        juce::Random random (42);
+
+        auto createValues = [&random] (int size, double low, double high)
+        {
+            std::vector<SampleType> values ((size_t)size);
+
+            for (auto& value : values){
+                value = (SampleType)(low + (high - low) * random.nextDouble());
+            }
+
+            return values;
+        };
+
+        /** the delay line is two interleaved channels and the kernels read the second */
+        const auto buffer = createValues(kLength * kStride, -1, 1);
+        const auto taps = createValues(kNumTaps * kNumSamples, -1, 1);
+        const auto fractions = createValues(kNumSamples, 0, 1);
+        const auto delayed = createValues(kNumSamples, -1, 1);
+        const auto table = createValues((kNumPhases + 1) * kNumTaps, -1, 1);
+
+        std::vector<float> positions, amounts;
+        std::vector<int> indices;
+
+        for (int i = 0; i < kNumSamples; i++){
+            positions.push_back(random.nextFloat() * kLength);
+            amounts.push_back(random.nextFloat());
+            indices.push_back(random.nextInt(kLength));
+        }
+
+        auto getKernels = [] (DspKernels::Isa isa) -> const DspKernels::SampleKernels<SampleType>&
+        {
+            return DspKernels::getSampleKernels((SampleType*)nullptr, isa);
+        };
+
+        auto getTaps = [] (const std::vector<SampleType>& values)
+        {
+            std::array<const SampleType*, kNumTaps> rows;
+
+            for (int k = 0; k < kNumTaps; k++){
+                rows[(size_t)k] = values.data() + k * kNumSamples;
+            }
+
+            return rows;
+        };
+
+        auto add = [&checks, &precision] (const char* name, KernelCheck check)
+        {
+            checks.push_back({ juce::String(name) + " " + precision, std::move(check) });
+        };
+
+        add("readLinear", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).readLinear(buffer.data() + 1, kLength - 1, kStride, positions.data(), output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("readLinearAndAdd", [=] (DspKernels::Isa isa){
+            auto output = delayed;
+            getKernels(isa).readLinearAndAdd(buffer.data() + 1, kLength - 1, kStride, positions.data(), (SampleType)0.7, output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("splitPositions", [=] (DspKernels::Isa isa){
+            std::vector<int> split (kNumSamples);
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).splitPositions(positions.data(), split.data(), output.data(), kNumSamples);
+
+            std::vector<double> result (output.begin(), output.end());
+            result.insert(result.end(), split.begin(), split.end());
+            return result;
+        });
+
+        add("gatherTap", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).gatherTap(buffer.data() + 1, kLength - 1, kStride, indices.data(), -3, output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("interpolateHermite", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).interpolateHermite(getTaps(taps).data(), fractions.data(), output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("interpolateLagrange3", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).interpolateLagrange3(getTaps(taps).data(), fractions.data(), output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("interpolateLagrange5", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).interpolateLagrange5(getTaps(taps).data(), fractions.data(), output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("thiranCoefficients", [=] (DspKernels::Isa isa){
+            std::vector<SampleType> output (3 * kNumSamples);
+            getKernels(isa).thiranCoefficients(getTaps(taps).data(), fractions.data(), output.data(),
+                                               output.data() + kNumSamples, output.data() + 2 * kNumSamples, kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("interpolateSinc", [=] (DspKernels::Isa isa){
+            std::vector<int> rows (kNumSamples);
+            auto positionsBetweenRows = fractions;
+            std::vector<SampleType> output (kNumSamples);
+            getKernels(isa).interpolateSinc(getTaps(taps).data(), kNumTaps, table.data(), kNumPhases,
+                                            rows.data(), positionsBetweenRows.data(), output.data(), kNumSamples);
+
+            std::vector<double> result (output.begin(), output.end());
+            result.insert(result.end(), positionsBetweenRows.begin(), positionsBetweenRows.end());
+            result.insert(result.end(), rows.begin(), rows.end());
+            return result;
+        });
+
+        add("mixRamp", [=] (DspKernels::Isa isa){
+            auto output = fractions;
+            getKernels(isa).mixRamp(output.data(), delayed.data(), amounts.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("mixConstant", [=] (DspKernels::Isa isa){
+            auto output = fractions;
+            getKernels(isa).mixConstant(output.data(), delayed.data(), (SampleType)0.3, (SampleType)0.7, kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        });
+
+        add("writeWithFeedback", [=] (DspKernels::Isa isa){
+            auto written = buffer;
+            SampleType feedbackState = (SampleType)0.25;
+            getKernels(isa).writeWithFeedback(written.data() + 1, kLength - 1, kStride, 700, fractions.data(), delayed.data(),
+                                              feedbackState, amounts.data(), kNumSamples);
+
+            std::vector<double> result (written.begin(), written.end());
+            result.push_back(feedbackState);
+            return result;
+        });
+    }
+
+    void addLFOKernelChecks(std::vector<std::pair<juce::String, KernelCheck>>& checks)
+    {
+        constexpr int kNumSamples = 1001;
+        constexpr int kTableSize = 64;
+
+        juce::Random random (43);
+        std::vector<float> table, phases;
+
+        for (int i = 0; i <= kTableSize; i++){
+            table.push_back(random.nextFloat() * 2.0f - 1.0f);
+        }
+
+        /** phases of exactly 0 and 1 are allowed */
+        for (int i = 0; i < kNumSamples; i++){
+            phases.push_back(i == 0 ? 0.0f : (i == 1 ? 1.0f : random.nextFloat()));
+        }
+
+        checks.push_back({ "lfoWavetable", [=] (DspKernels::Isa isa){
+            std::vector<float> output (kNumSamples);
+            DspKernels::getLFOKernels(isa).wavetable(table.data(), kTableSize, phases.data(), output.data(), kNumSamples);
+            return std::vector<double> (output.begin(), output.end());
+        }});
+
+        for (int waveform = 0; waveform < LFO::kSmoothedRandom; waveform++){
+            checks.push_back({ "lfoPolynomial " + LFO::getWaveformNames()[waveform], [=] (DspKernels::Isa isa){
+                std::vector<float> output (kNumSamples);
+                DspKernels::getLFOKernels(isa).polynomial(waveform, phases.data(), output.data(), kNumSamples);
+                return std::vector<double> (output.begin(), output.end());
+            }});
+        }
+    }
+
+    /** stereo noise through an engine running the kernels of one Isa, in blocks of 512 with a change
+        of settings half way. Returns the ticks spent processing */
+    template <typename SampleType>
+    juce::int64 renderWithIsa(DspKernels::Isa isa, const ParameterSnapshot& snapshot, const ParameterSnapshot& changed,
+                              const juce::AudioBuffer<float>& input, std::vector<double>& output)
+    {
+        const int numSamples = input.getNumSamples();
+
+        DspKernels::setIsa(isa);
+
+        RenderCheck::EngineSettings settings;
+        settings.snapshot = snapshot;
+        settings.changed = changed;
+        settings.changeSample = numSamples / 2;
+
+        juce::AudioBuffer<SampleType> converted (2, numSamples);
+        juce::AudioBuffer<SampleType> buffer;
+
+        for (int channel = 0; channel < 2; channel++){
+            for (int i = 0; i < numSamples; i++){
+                converted.setSample(channel, i, (SampleType)input.getSample(channel, i));
+            }
+        }
+
+        const auto ticks = RenderCheck::renderEngine(settings, converted, buffer).ticks;
+
+        output.clear();
+
+        for (int channel = 0; channel < 2; channel++){
+            output.insert(output.end(), buffer.getReadPointer(channel), buffer.getReadPointer(channel) + numSamples);
+        }
+
+        return ticks;
+    }
+
+    /** 48 lanes of noise through a ChorusFlangerBatch running the group loops of one Isa, each lane
+        with its own settings and a ramp to new ones half way, every third lane fading to the other Type */
+    void renderBatchWithIsa(DspKernels::Isa isa, const juce::AudioBuffer<float>& input, std::vector<double>& output)
+    {
+        constexpr int kNumLanes = 48;
+        constexpr int kBlockSize = 512;
+        const int numSamples = input.getNumSamples();
+
+        DspKernels::setIsa(isa);
+
+        auto createSnapshot = [] (int lane, bool changed)
+        {
+            ParameterSnapshot snapshot;
+            snapshot.type = (lane + (changed && lane % 3 == 0 ? 1 : 0)) % 2;
+            snapshot.rate = 0.5f + 0.3f * (lane % 7);
+            snapshot.depth = changed ? 0.9f : 0.3f + 0.1f * (lane % 5);
+            snapshot.phaseOffset = 0.05f * (lane % 4);
+            snapshot.feedback = 0.3f * (lane % 3);
+            return snapshot;
+        };
+
+        ChorusFlangerBatch chorusFlangers;
+        chorusFlangers.prepare(48000, kBlockSize, kNumLanes);
+
+        for (int lane = 0; lane < kNumLanes; lane++){
+            chorusFlangers.startLane(lane, createSnapshot(lane, false));
+        }
+
+        juce::AudioBuffer<float> buffer (kNumLanes, numSamples);
+
+        for (int lane = 0; lane < kNumLanes; lane++){
+            buffer.copyFrom(lane, 0, input, lane % input.getNumChannels(), 0, numSamples);
+        }
+
+        for (int start = 0; start < numSamples; start += kBlockSize){
+            if (start == numSamples / 2){
+                for (int lane = 0; lane < kNumLanes; lane++){
+                    chorusFlangers.setParameters(lane, createSnapshot(lane, true));
+                }
+            }
+
+            std::vector<float*> channels;
+
+            for (int lane = 0; lane < kNumLanes; lane++){
+                channels.push_back(buffer.getWritePointer(lane, start));
+            }
+
+            chorusFlangers.process(channels.data(), channels.data(), juce::jmin(kBlockSize, numSamples - start));
+        }
+
+        output.clear();
+
+        for (int lane = 0; lane < kNumLanes; lane++){
+            output.insert(output.end(), buffer.getReadPointer(lane), buffer.getReadPointer(lane) + numSamples);
+        }
+    }
+
+    double getMaxVectorDifference(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        double maxDifference = a.size() == b.size() ? 0.0 : std::numeric_limits<double>::infinity();
+
+        for (size_t i = 0; i < juce::jmin(a.size(), b.size()); i++){
+            maxDifference = juce::jmax(maxDifference, std::abs(a[i] - b[i]));
+        }
+
+        return maxDifference;
+    }
+
+    void isa(const juce::ArgumentList& args)
+    {
+        using namespace BenchmarkCommands;
+
+        const bool quick = args.containsOption("--quick");
+        const double tolerance = args.getValueForOption("--tolerance").getDoubleValue();
+        const auto names = DspKernels::getIsaNames();
+        const auto initialIsa = DspKernels::getIsa();
+
+        std::cout << "Detected " << names[DspKernels::getDetectedIsa()] << ", in use " << names[initialIsa] << std::endl;
+
+        /** every copy this CPU can run is compared with the generic one */
+        std::vector<DspKernels::Isa> isas;
+
+        for (int isa = DspKernels::kGeneric + 1; isa < DspKernels::kNumIsas; isa++){
+            if (DspKernels::isSupported((DspKernels::Isa)isa)){
+                isas.push_back((DspKernels::Isa)isa);
+            } else {
+                std::cout << names[isa] << " is not supported by this CPU and is not tested" << std::endl;
+            }
+        }
+
+        auto printHeader = [&isas, &names] (const juce::String& title)
+        {
+            std::cout << std::endl << title.paddedRight(' ', 30);
+
+            for (const auto isa : isas){
+                std::cout << names[isa].paddedRight(' ', 12);
+            }
+
+            std::cout << std::endl;
+        };
+
+        /** a copy whose target the compiler dropped is the generic code again, and would pass every comparison */
+        int numMisbuilt = 0;
+
+        printHeader("Copy, built for");
+        std::cout << juce::String().paddedRight(' ', 30);
+
+        for (const auto isa : isas){
+            const auto builtIsa = DspKernels::getBuiltIsa(isa);
+            std::cout << names[builtIsa].paddedRight(' ', 12);
+
+            if (builtIsa != isa){
+                numMisbuilt++;
+            }
+        }
+
+        std::cout << std::endl;
+
+        int numFailures = 0;
+
+        auto printDifferences = [&isas, &numFailures, tolerance] (const juce::String& name, std::function<double(DspKernels::Isa)> getDifference)
+        {
+            std::cout << name.paddedRight(' ', 30);
+
+            for (const auto isa : isas){
+                const double difference = getDifference(isa);
+                std::cout << juce::String(difference).paddedRight(' ', 12);
+
+                if (! (difference <= tolerance)){
+                    numFailures++;
+                }
+            }
+
+            std::cout << std::endl;
+        };
+
+        /** each kernel on its own */
+        std::vector<std::pair<juce::String, KernelCheck>> checks;
+        addKernelChecks<float>(checks, "float");
+        addKernelChecks<double>(checks, "double");
+        addLFOKernelChecks(checks);
+
+        printHeader("Kernel, max difference");
+
+        for (const auto& check : checks){
+            const auto expected = check.second(DspKernels::kGeneric);
+
+            printDifferences(check.first, [&check, &expected] (DspKernels::Isa isa){
+                return getMaxVectorDifference(expected, check.second(isa));
+            });
+        }
+
+        /** the engine with each interpolator, both types, stacked voices, feedback and a ramp half way */
+        const int numSamples = quick ? 16384 : kNumFrames;
+
+        const auto noise = RenderCheck::createNoise(2, numSamples);
+
+        printHeader("Engine, max difference");
+
+        for (int precision = 0; precision < 2; precision++){
+            for (int interpolation = 0; interpolation < DelayLineReader::kNumModes; interpolation++){
+                ParameterSnapshot snapshot;
+                snapshot.interpolation = interpolation;
+                snapshot.type = interpolation % 2;
+                snapshot.waveform = interpolation % LFO::kNumWaveforms;
+                snapshot.voices = 3;
+                snapshot.feedback = 0.7f;
+
+                auto changed = snapshot;
+                changed.depth = 0.9f;
+                changed.dryWet = 0.8f;
+
+                std::vector<double> expected, output;
+                auto render = [&] (DspKernels::Isa isa)
+                {
+                    if (precision == 0){
+                        renderWithIsa<float>(isa, snapshot, changed, noise, output);
+                    } else {
+                        renderWithIsa<double>(isa, snapshot, changed, noise, output);
+                    }
+
+                    return output;
+                };
+
+                expected = render(DspKernels::kGeneric);
+
+                printDifferences(DelayLineReader::getModeNames()[interpolation] + (precision == 0 ? " float" : " double"), [&] (DspKernels::Isa isa){
+                    return getMaxVectorDifference(expected, render(isa));
+                });
+            }
+        }
+
+        /** the batch's group loops, which are built once per Isa as the kernels are */
+        {
+            std::vector<double> expected, output;
+            renderBatchWithIsa(DspKernels::kGeneric, noise, expected);
+
+            printDifferences("Batch, 48 lanes", [&] (DspKernels::Isa isa){
+                renderBatchWithIsa(isa, noise, output);
+                return getMaxVectorDifference(expected, output);
+            });
+        }
+
+        /** the best of a few runs at the default settings, and at the most expensive interpolator */
+        isas.insert(isas.begin(), DspKernels::kGeneric);
+        printHeader("Engine, ns/sample");
+
+        for (const int interpolation : { (int)DelayLineReader::kLinear, (int)DelayLineReader::kSinc }){
+            ParameterSnapshot snapshot;
+            snapshot.interpolation = interpolation;
+            snapshot.voices = (interpolation == DelayLineReader::kLinear) ? 1 : 3;
+
+            std::cout << (DelayLineReader::getModeNames()[interpolation] + ", " + juce::String(snapshot.voices)
+                            + (snapshot.voices == 1 ? " voice" : " voices")).paddedRight(' ', 30);
+
+            for (const auto isa : isas){
+                std::vector<double> output;
+                juce::int64 ticks = 0;
+
+                for (int run = 0; run < (quick ? 3 : kNumRuns); run++){
+                    const auto runTicks = renderWithIsa<float>(isa, snapshot, snapshot, noise, output);
+                    ticks = (run == 0) ? runTicks : juce::jmin(ticks, runTicks);
+                }
+
+                std::cout << juce::String(1.0e9 * juce::Time::highResolutionTicksToSeconds(ticks) / numSamples, 2).paddedRight(' ', 12);
+            }
+
+            std::cout << std::endl;
+        }
+
+        DspKernels::setIsa(initialIsa);
+
+        if (numMisbuilt > 0){
+            juce::ConsoleApplication::fail(juce::String(numMisbuilt) + " copies were not built for their instruction set");
+        }
+
+        if (numFailures > 0){
+            juce::ConsoleApplication::fail(juce::String(numFailures) + " results differ from the generic kernels by more than "
+                                           + juce::String(tolerance));
+        }
+    }
+}
+
+void BenchmarkCommands::addIsaChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "isa",
+                     "isa [--quick] [--tolerance=X]",
+                     "Checks the kernels built for each instruction set against the generic ones, and times them.",
+                     "Fails if a copy was not built for its instruction set, which a compiler that ignores\n"
+                     "a target attribute would do. Then runs every DspKernels loop on fixed random input,\n"
+                     "and renders noise through the engine with each interpolator, in float and double,\n"
+                     "and through a ChorusFlangerBatch of 48 lanes,\n"
+                     "once per instruction set this CPU supports. Fails if any result differs from the\n"
+                     "generic kernels by more than\n"
+                     "the tolerance, 0 by default. Then times the engine with each instruction set.\n"
+                     "KPCHORUSFLANGER_ISA=generic|sse4.1|avx2|avx512 forces the set used by every command.",
+                     isa });
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BenchmarkCommands.h"
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "Usage:", true);
+
+    BenchmarkCommands::addRegressionChecks(app);
+    BenchmarkCommands::addVoiceChecks(app);
+    BenchmarkCommands::addInterpolationChecks(app);
+    BenchmarkCommands::addIdleChecks(app);
+    BenchmarkCommands::addAllocationChecks(app);
+    BenchmarkCommands::addStateChecks(app);
+    BenchmarkCommands::addTempoSyncChecks(app);
+    BenchmarkCommands::addEngineChecks(app);
+    BenchmarkCommands::addBatchChecks(app);
+    BenchmarkCommands::addStreamingChecks(app);
+    BenchmarkCommands::addReferenceChecks(app);
+    BenchmarkCommands::addMidiChecks(app);
+    BenchmarkCommands::addTypeSwitchChecks(app);
+    BenchmarkCommands::addMorphChecks(app);
+    BenchmarkCommands::addIsaChecks(app);
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    MidiChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void midi(const juce::ArgumentList&)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr int kNumSamples = 65536;
+
+        /** a dense controller stream, its events fall at every offset into the block sizes tried */
+        constexpr int kEventInterval = 7;
+        const std::vector<int> controllers { MidiControllers::kDepth, MidiControllers::kRate, MidiControllers::kFeedback,
+                                             MidiControllers::kPhaseOffset, MidiControllers::kDryWet };
+
+        /** render the input through a processor in blocks of blockSize, with the controller events
+            of each block at their offsets into it. Returns how many blocks were skipped */
+        auto render = [] (const juce::AudioBuffer<float>& input, const std::vector<int>& eventControllers, int blockSize,
+                          juce::AudioBuffer<float>& output)
+        {
+            auto processor = RenderCheck::createProcessor(kSampleRate, blockSize);
+            output.makeCopyOf(input);
+
+            RenderCheck::renderProcessor(*processor, output, blockSize, [&eventControllers] (int position, int numSamples, juce::MidiBuffer& midi)
+            {
+                for (int event = (position + kEventInterval - 1) / kEventInterval; event * kEventInterval < position + numSamples; event++){
+                    const int controller = eventControllers[(size_t)event % eventControllers.size()];
+                    midi.addEvent(juce::MidiMessage::controllerEvent(1, controller, (event * 5) % 128), event * kEventInterval - position);
+                }
+            });
+
+            return processor->getNumSkippedBlocks();
+        };
+
+        const auto noise = RenderCheck::createNoise(2, kNumSamples);
+
+        /** the same noise with a gap of silence, and a stream that leaves Feedback alone so the tail
+            runs out and the events in the gap land in idle blocks. Where the last of the tail is cut
+            depends on the block size, so only what comes after the gap is compared */
+        constexpr int kGapEnd = kNumSamples * 5 / 8;
+        juce::AudioBuffer<float> gaps;
+        gaps.makeCopyOf(noise);
+        gaps.clear(kNumSamples / 8, kGapEnd - kNumSamples / 8);
+
+        const std::vector<int> idleControllers { MidiControllers::kDepth, MidiControllers::kRate };
+
+        juce::AudioBuffer<float> reference, idleReference;
+        juce::AudioBuffer<float> rendered;
+        render(noise, controllers, 4096, reference);
+        render(gaps, idleControllers, 4096, idleReference);
+        idleReference.clear(0, kGapEnd);
+
+        RenderCheck::Comparison comparison (0);
+
+        std::cout << "Controller events every " << kEventInterval << " samples against blocks of 4096, max difference" << std::endl
+                  << "Block  noise         with a gap    skipped blocks" << std::endl;
+
+        for (int blockSize : { 1, 16, 100, 512, 1000 }){
+            render(noise, controllers, blockSize, rendered);
+            std::cout << juce::String(blockSize).paddedRight(' ', 7) << juce::String(comparison.compare(reference, rendered)).paddedRight(' ', 14);
+
+            const auto numSkipped = render(gaps, idleControllers, blockSize, rendered);
+            rendered.clear(0, kGapEnd);
+            std::cout << juce::String(comparison.compare(idleReference, rendered)).paddedRight(' ', 14) << numSkipped << std::endl;
+
+            if (numSkipped == 0){
+                comparison.addFailure();
+            }
+        }
+
+        comparison.check("block sizes move the controller events, or never went idle");
+    }
+}
+
+void BenchmarkCommands::addMidiChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "midi",
+                     "midi",
+                     "Checks that MIDI controller events land on the same sample at any block size.",
+                     "Renders noise through the processor with a controller event every 7 samples,\n"
+                     "cycling through the assigned controllers, in blocks of 1 to 1000 samples. Then does\n"
+                     "the same with Depth and Rate events over noise with a gap of silence, whose events\n"
+                     "land in idle blocks. Fails unless every block size is bit-identical to blocks of 4096,\n"
+                     "after the gap for the second render.",
+                     midi });
+}
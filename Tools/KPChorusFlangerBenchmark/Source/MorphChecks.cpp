@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    MorphChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void morph(const juce::ArgumentList&)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr int kBlockSize = 64;
+        constexpr int kNumBlocks = 3000;
+
+        /** two presets that only differ in Type, so the delay range is all a morph moves */
+        ParameterSnapshot chorus;
+        chorus.type = ChorusFlangerEngine::kChorus;
+        chorus.rate = 0.5f;
+        chorus.feedback = 0;
+
+        auto flanger = chorus;
+        flanger.type = ChorusFlangerEngine::kFlanger;
+
+        const auto noise = RenderCheck::createNoise(2, kBlockSize);
+
+        /** the largest step between two points of the first channel's traced delay, in ms, with the
+            morph amount getAmount gives for each block */
+        auto getLargestStep = [&] (const std::function<float(int)>& getAmount)
+        {
+            ChorusFlangerEngine engine;
+            ModulationTrace trace;
+            engine.setParameters(PresetBank::morph(chorus, flanger, getAmount(0)));
+            engine.prepare(kSampleRate, kBlockSize, 2);
+            engine.setModulationTrace(&trace);
+            trace.setActive(true);
+
+            juce::AudioBuffer<float> output (2, kBlockSize);
+            ModulationTrace::Point points[ModulationTrace::kNumPoints];
+            float lastDelay = -1;
+            float largestStep = 0;
+
+            for (int block = 0; block < kNumBlocks; block++){
+                engine.setParameters(PresetBank::morph(chorus, flanger, getAmount(block)));
+                engine.process(noise.getArrayOfReadPointers(), output.getArrayOfWritePointers(), kBlockSize);
+
+                const int numPoints = trace.read(points, ModulationTrace::kNumPoints);
+
+                for (int i = 0; i < numPoints; i++){
+                    if (lastDelay >= 0){
+                        largestStep = juce::jmax(largestStep, std::abs(points[i].delayMs[0] - lastDelay));
+                    }
+
+                    lastDelay = points[i].delayMs[0];
+                }
+            }
+
+            return largestStep;
+        };
+
+        const float chorusStep = getLargestStep([] (int) { return 0.f; });
+        const float flangerStep = getLargestStep([] (int) { return 1.f; });
+        const float morphStep = getLargestStep([] (int block) { return (float)block / (float)(kNumBlocks - 1); });
+
+        std::cout << "Largest step of the traced delay, in ms, morphing from Chorus to Flanger over " << kNumBlocks << " blocks" << std::endl
+                  << "Chorus held        " << chorusStep << std::endl
+                  << "Flanger held       " << flangerStep << std::endl
+                  << "Morph sweep        " << morphStep << std::endl;
+
+        /** the LFO alone steps the delay this far, a jump of the range at the halfway switch is many times more */
+        if (morphStep > 1.5f * juce::jmax(chorusStep, flangerStep)){
+            juce::ConsoleApplication::fail("The morph jumps the delay");
+        }
+    }
+}
+
+void BenchmarkCommands::addMorphChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "morph",
+                     "morph",
+                     "Checks that sweeping Morph between Types sweeps the delay without a jump.",
+                     "Morphs an engine from a Chorus snapshot to the same snapshot as a Flanger, block by\n"
+                     "block, and traces the delay the LFO sweeps. Fails if the largest step between\n"
+                     "trace points is more than half as far again as with either Type held.",
+                     morph });
+}
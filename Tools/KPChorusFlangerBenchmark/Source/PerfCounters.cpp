@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    PerfCounters.cpp
+    Created: 17 Oct 2026 6:02:44pm
+
+  ==============================================================================
+*/
+
+#include "PerfCounters.h"
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+#if JUCE_INTEL
+ #include <x86intrin.h>
+#endif
+
+namespace
+{
+   #if JUCE_LINUX
+    int openCounter(juce::uint64 config)
+    {
+        perf_event_attr attributes;
+        juce::zeromem(&attributes, sizeof(attributes));
+
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    }
+
+    juce::uint64 readCounter(int fd)
+    {
+        juce::uint64 value = 0;
+        if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)){
+            return 0;
+        }
+        return value;
+    }
+   #endif
+
+    juce::uint64 readTimestamp()
+    {
+       #if JUCE_INTEL
+        return __rdtsc();
+       #else
+        return 0;
+       #endif
+    }
+}
+
+//==============================================================================
+PerfCounters::PerfCounters()
+{
+    mCyclesFd = -1;
+    mInstructionsFd = -1;
+    mStartTimestamp = 0;
+
+   #if JUCE_LINUX
+    mCyclesFd = openCounter(PERF_COUNT_HW_CPU_CYCLES);
+    mInstructionsFd = openCounter(PERF_COUNT_HW_INSTRUCTIONS);
+   #endif
+}
+
+PerfCounters::~PerfCounters()
+{
+   #if JUCE_LINUX
+    if (mCyclesFd >= 0){
+        close(mCyclesFd);
+    }
+    if (mInstructionsFd >= 0){
+        close(mInstructionsFd);
+    }
+   #endif
+}
+
+juce::String PerfCounters::getCycleSource() const
+{
+    return hasHardwareCycles() ? "perf" : "tsc";
+}
+
+void PerfCounters::start()
+{
+   #if JUCE_LINUX
+    for (int fd : { mCyclesFd, mInstructionsFd }){
+        if (fd >= 0){
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+   #endif
+
+    mStartTimestamp = readTimestamp();
+}
+
+PerfCounters::Reading PerfCounters::stop()
+{
+    const juce::uint64 endTimestamp = readTimestamp();
+
+    Reading reading;
+    reading.cycles = (double)(endTimestamp - mStartTimestamp);
+
+   #if JUCE_LINUX
+    for (int fd : { mCyclesFd, mInstructionsFd }){
+        if (fd >= 0){
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    if (mCyclesFd >= 0){
+        reading.cycles = (double)readCounter(mCyclesFd);
+    }
+    if (mInstructionsFd >= 0){
+        reading.instructions = (double)readCounter(mInstructionsFd);
+    }
+   #endif
+
+    return reading;
+}
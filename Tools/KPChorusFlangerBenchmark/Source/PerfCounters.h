@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    PerfCounters.h
+    Created: 17 Oct 2026 6:02:44pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Hardware cycle and instruction counters for the calling thread.
+
+    On Linux these come from perf_event_open. Elsewhere, or when the kernel does
+    not allow it, cycles fall back to the x86 time-stamp counter and instructions
+    are reported as unavailable.
+*/
+class PerfCounters
+{
+public:
+
+    struct Reading
+    {
+        double cycles = 0;
+        double instructions = 0;
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    void start();
+    Reading stop();
+
+    bool hasHardwareCycles() const      { return mCyclesFd >= 0; }
+    bool hasInstructions() const        { return mInstructionsFd >= 0; }
+
+    /** "perf" or "tsc", for the report header */
+    juce::String getCycleSource() const;
+
+private:
+
+    int mCyclesFd;
+    int mInstructionsFd;
+    juce::uint64 mStartTimestamp;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PerfCounters)
+};
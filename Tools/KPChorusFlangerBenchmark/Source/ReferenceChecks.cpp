@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    ReferenceChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void reference(const juce::ArgumentList&)
+    {
+        constexpr int kNumSamples = 131072;
+
+        const auto noise = RenderCheck::createNoise(2, kNumSamples);
+
+        juce::AudioBuffer<float> expected;
+        juce::AudioBuffer<float> rendered;
+        RenderCheck::Comparison comparison (KPChorusFlangerAudioProcessor::kBlockPathTolerance, true);
+
+        std::cout << "Block pipeline against the reference, max difference relative to the peak" << std::endl;
+
+        for (int type = 0; type < 2; type++){
+            for (float feedback : { 0.f, 0.7f }){
+                /** the block pipeline with the std::sin LFO, or the reference, with the parameters changing half way */
+                RenderCheck::EngineSettings settings;
+                settings.snapshot.type = type;
+                settings.snapshot.feedback = feedback;
+                settings.snapshot.phaseOffset = 0.25f;
+                settings.backend = LFO::kStdSine;
+
+                settings.changed = settings.snapshot;
+                settings.changed.depth = 0.9f;
+                settings.changed.rate = 3.f;
+                settings.changed.dryWet = 0.7f;
+                settings.changed.feedback = 0.5f * feedback;
+                settings.changeSample = kNumSamples / 2;
+
+                settings.useReference = true;
+                RenderCheck::renderEngine(settings, noise, expected);
+
+                settings.useReference = false;
+                RenderCheck::renderEngine(settings, noise, rendered);
+
+                std::cout << (type == 0 ? "Chorus  " : "Flanger ") << "feedback " << juce::String(feedback, 1).paddedRight(' ', 5)
+                          << comparison.compare(expected, rendered) << std::endl;
+            }
+        }
+
+        comparison.check("renders differ from the reference by more than "
+                         + juce::String(KPChorusFlangerAudioProcessor::kBlockPathTolerance) + " of the peak");
+    }
+}
+
+void BenchmarkCommands::addReferenceChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "reference",
+                     "reference",
+                     "Checks the block pipeline against the per-sample reference implementation.",
+                     "Renders noise through both with the std::sin LFO and the Sine waveform, for both\n"
+                     "types with and without feedback, changing the parameters half way. Fails if the\n"
+                     "outputs differ by more than KPChorusFlangerAudioProcessor::kBlockPathTolerance of\n"
+                     "the peak.",
+                     reference });
+}
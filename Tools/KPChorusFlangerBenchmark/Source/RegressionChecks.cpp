@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+    RegressionChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include "DspKernels.h"
+
+namespace
+{
+    /** the interpolation mode matching a name such as "lagrange5", or an index */
+    int findInterpolationMode(const juce::String& name)
+    {
+        const auto names = DelayLineReader::getModeNames();
+
+        for (int mode = 0; mode < names.size(); mode++){
+            if (names[mode].removeCharacters(" ").equalsIgnoreCase(name.removeCharacters(" "))){
+                return mode;
+            }
+        }
+
+        if (name.containsOnly("0123456789") && name.getIntValue() < DelayLineReader::kNumModes){
+            return name.getIntValue();
+        }
+
+        juce::ConsoleApplication::fail("Unknown interpolation: " + name);
+        return DelayLineReader::kLinear;
+    }
+
+    /** the Isa an --isa option names, failing on a name that is none */
+    DspKernels::Isa findIsaOption(const juce::String& name)
+    {
+        const auto isa = DspKernels::findIsa(name);
+
+        if (isa == DspKernels::kNumIsas){
+            juce::ConsoleApplication::fail("Unknown instruction set: " + name + ", one of " + DspKernels::getIsaNames().joinIntoString(", "));
+        }
+
+        return isa;
+    }
+
+    void run(const juce::ArgumentList& args)
+    {
+        using namespace BenchmarkCommands;
+
+        const bool quick = args.containsOption("--quick");
+        const juce::String filter = args.getValueForOption("--filter");
+        const juce::String metric = args.containsOption("--metric") ? args.getValueForOption("--metric") : juce::String("ns");
+        const double threshold = args.containsOption("--threshold") ? args.getValueForOption("--threshold").getDoubleValue() : 5.0;
+        const int interpolation = args.containsOption("--interpolation") ? findInterpolationMode(args.getValueForOption("--interpolation"))
+                                                                         : (int)DelayLineReader::kLinear;
+        const int oversampling = juce::jlimit(0, (int)Oversampler::kMaxFactorIndex, args.getValueForOption("--oversampling").getIntValue());
+
+        /** a forced instruction set names its cases, so they never compare against the detected one's */
+        const auto isa = args.containsOption("--isa") ? DspKernels::setIsa(findIsaOption(args.getValueForOption("--isa"))) : DspKernels::getIsa();
+
+        if (metric != "ns" && metric != "cycles" && metric != "instructions"){
+            juce::ConsoleApplication::fail("Unknown metric: " + metric);
+        }
+
+        std::vector<BenchmarkResult> baseline;
+
+        if (args.containsOption("--compare")){
+            const auto baselineFile = args.getExistingFileForOption("--compare");
+            const auto result = Benchmark::fromJSON(baselineFile.loadFileAsString(), baseline);
+
+            if (result.failed()){
+                juce::ConsoleApplication::fail(result.getErrorMessage() + " in " + baselineFile.getFullPathName());
+            }
+        }
+
+        Benchmark benchmark (quick ? kNumFrames / 4 : kNumFrames, quick ? 3 : kNumRuns);
+        std::vector<BenchmarkResult> results;
+
+        std::cout << "Kernels for " << DspKernels::getIsaNames()[isa] << std::endl
+                  << "Cycles from " << benchmark.getCounters().getCycleSource()
+                  << (benchmark.getCounters().hasInstructions() ? ", instructions from perf" : ", instructions not available")
+                  << std::endl;
+
+        for (auto benchmarkCase : Benchmark::createCases(quick)){
+            /** other interpolators get their own case names, so they never compare against a linear baseline */
+            if (interpolation != DelayLineReader::kLinear){
+                benchmarkCase.parameterValues["interpolation"] = (float)interpolation;
+                benchmarkCase.settingsName << "-" << DelayLineReader::getModeNames()[interpolation].removeCharacters(" ").toLowerCase();
+            }
+
+            /** the benchmark renders offline, so the offline factor is the one that applies */
+            if (oversampling > 0){
+                benchmarkCase.parameterValues["offlineoversampling"] = (float)oversampling;
+                benchmarkCase.settingsName << "-" << Oversampler::getFactorNames()[oversampling];
+            }
+
+            if (args.containsOption("--double")){
+                benchmarkCase.doublePrecision = true;
+                benchmarkCase.settingsName << "-double";
+            }
+
+            if (isa != DspKernels::getDetectedIsa()){
+                benchmarkCase.settingsName << "-" << DspKernels::getIsaNames()[isa].removeCharacters(".-").toLowerCase();
+            }
+
+            const auto name = benchmarkCase.getName();
+
+            if (filter.isNotEmpty() && ! name.contains(filter)){
+                continue;
+            }
+
+            const auto result = benchmark.runCase(benchmarkCase, args.containsOption("--reference"));
+            results.push_back(result);
+
+            std::cout << name.paddedRight(' ', 28)
+                      << result.nsPerSample << " ns  "
+                      << result.cyclesPerSample << " cycles  "
+                      << result.instructionsPerSample << " instructions /sample" << std::endl;
+        }
+
+        if (args.containsOption("--save")){
+            const auto outputFile = args.getFileForOption("--save");
+
+            if (! outputFile.replaceWithText(benchmark.toJSON(results))){
+                juce::ConsoleApplication::fail("Cannot write " + outputFile.getFullPathName());
+            }
+        }
+
+        if (args.containsOption("--compare")){
+            std::cout << std::endl << "Compared with the baseline, threshold " << threshold << "%:" << std::endl;
+
+            const int numRegressions = Benchmark::compare(baseline, results, metric, threshold, std::cout);
+
+            if (numRegressions > 0){
+                juce::ConsoleApplication::fail(juce::String(numRegressions) + " cases regressed by more than "
+                                               + juce::String(threshold) + "%");
+            }
+        }
+    }
+}
+
+void BenchmarkCommands::addRegressionChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "run",
+                     "run [options]",
+                     "Times processBlock over block sizes, sample rates, types and settings.",
+                     "Reports ns, cycles and instructions per stereo sample for every case.\n\n"
+                     "Options:\n"
+                     "  --save=file.json       write the results as a baseline file\n"
+                     "  --compare=file.json    compare with a baseline, fail on a regression\n"
+                     "  --threshold=P          allowed slowdown in percent (default 5)\n"
+                     "  --metric=ns|cycles|instructions\n"
+                     "                         the metric compared (default ns)\n"
+                     "  --filter=text          only run cases whose name contains text,\n"
+                     "                         e.g. --filter=flanger/extreme\n"
+                     "  --quick                a smaller matrix and shorter runs\n"
+                     "  --interpolation=mode   time a delay line interpolator other than linear,\n"
+                     "                         e.g. --interpolation=lagrange5\n"
+                     "  --oversampling=0|1|2|3 time the pipeline at 1x, 2x, 4x or 8x oversampling\n"
+                     "  --reference            time the per-sample reference implementation\n"
+                     "  --isa=generic|sse4.1|avx2|avx512\n"
+                     "                         time the kernels built for another instruction set\n"
+                     "  --double               process double-precision buffers",
+                     run });
+}
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    RenderCheck.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "RenderCheck.h"
+
+juce::AudioBuffer<float> RenderCheck::createNoise(int numChannels, int numSamples, juce::int64 seed)
+{
+    juce::AudioBuffer<float> noise (numChannels, numSamples);
+    juce::Random random (seed);
+
+    for (int channel = 0; channel < numChannels; channel++){
+        for (int i = 0; i < numSamples; i++){
+            noise.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+        }
+    }
+
+    return noise;
+}
+
+void RenderCheck::setParameters(juce::AudioProcessor& processor, const std::map<juce::String, float>& values)
+{
+    for (auto* parameter : processor.getParameters()){
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)){
+            const auto value = values.find(ranged->paramID);
+            if (value != values.end()){
+                ranged->setValueNotifyingHost(ranged->convertTo0to1(value->second));
+            }
+        }
+    }
+}
+
+std::unique_ptr<KPChorusFlangerAudioProcessor> RenderCheck::createProcessor(double sampleRate, int blockSize,
+                                                                            const std::map<juce::String, float>& values)
+{
+    auto processor = std::make_unique<KPChorusFlangerAudioProcessor>();
+    setParameters(*processor, values);
+
+    processor->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    processor->prepareToPlay(sampleRate, blockSize);
+    return processor;
+}
+
+void RenderCheck::renderProcessor(juce::AudioProcessor& processor, juce::AudioBuffer<float>& buffer, int blockSize,
+                                  const BlockCallback& beforeBlock, int start, int end)
+{
+    if (end < 0){
+        end = buffer.getNumSamples();
+    }
+
+    juce::MidiBuffer midi;
+
+    for (int position = start; position < end; position += blockSize){
+        const int numSamples = juce::jmin(blockSize, end - position);
+        midi.clear();
+
+        if (beforeBlock != nullptr){
+            beforeBlock(position, numSamples, midi);
+        }
+
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), position, numSamples);
+        processor.processBlock(block, midi);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+RenderCheck::RenderStats RenderCheck::renderEngine(const EngineSettings& settings, const juce::AudioBuffer<SampleType>& input,
+                                                   juce::AudioBuffer<SampleType>& output)
+{
+    const int numChannels = input.getNumChannels();
+    const int numSamples = input.getNumSamples();
+    jassert(numChannels <= DelayLine::kMaxChannels);
+
+    ChorusFlangerEngine chorusFlanger;
+    chorusFlanger.setUseReferenceProcessing(settings.useReference);
+    chorusFlanger.setLFOBackend(settings.backend);
+
+    if (settings.maxOversamplingIndex >= 0){
+        chorusFlanger.setMemoryReservation(settings.sampleRate, settings.maxOversamplingIndex);
+    }
+
+    chorusFlanger.setParameters(settings.snapshot);
+    chorusFlanger.prepare(settings.sampleRate, settings.preparedBlockSize > 0 ? settings.preparedBlockSize : settings.blockSize,
+                          numChannels, std::is_same<SampleType, double>::value);
+
+    if (settings.outOfPlace){
+        output.setSize(numChannels, numSamples, false, false, true);
+    } else {
+        output.makeCopyOf(input);
+    }
+
+    const SampleType* inputs[DelayLine::kMaxChannels];
+    SampleType* channels[DelayLine::kMaxChannels];
+    RenderStats stats;
+    size_t blockIndex = 0;
+
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    for (int position = 0; position < numSamples;){
+        const int blockSize = settings.blockSizes.empty() ? juce::jmin(settings.blockSize, numSamples - position)
+                                                          : settings.blockSizes[blockIndex++];
+
+        for (int channel = 0; channel < numChannels; channel++){
+            inputs[channel] = (settings.outOfPlace ? input.getReadPointer(channel) : output.getReadPointer(channel)) + position;
+            channels[channel] = output.getWritePointer(channel) + position;
+        }
+
+        const int changeOffset = settings.changeSample - position;
+
+        if (changeOffset == 0){
+            chorusFlanger.setParameters(settings.changed);
+        }
+
+        if (changeOffset > 0 && changeOffset < blockSize){
+            /** the change lands inside the block, the three-step form applies it at its sample */
+            jassert(! settings.outOfPlace);
+
+            chorusFlanger.startBlock(channels, numChannels, blockSize);
+            chorusFlanger.processSegment(channels, 0, changeOffset);
+            chorusFlanger.setParameters(settings.changed);
+            chorusFlanger.processSegment(channels, changeOffset, blockSize - changeOffset);
+            chorusFlanger.finishBlock();
+        } else {
+            chorusFlanger.process(inputs, channels, blockSize);
+        }
+
+        position += blockSize;
+    }
+
+    stats.ticks = juce::Time::getHighResolutionTicks() - start;
+    stats.numSkippedBlocks = chorusFlanger.getNumSkippedBlocks();
+    return stats;
+}
+
+template RenderCheck::RenderStats RenderCheck::renderEngine<float>(const EngineSettings&, const juce::AudioBuffer<float>&, juce::AudioBuffer<float>&);
+template RenderCheck::RenderStats RenderCheck::renderEngine<double>(const EngineSettings&, const juce::AudioBuffer<double>&, juce::AudioBuffer<double>&);
+
+//==============================================================================
+float RenderCheck::getMaxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start, int end)
+{
+    if (end < 0){
+        end = a.getNumSamples();
+    }
+
+    float maxDifference = 0;
+
+    for (int channel = 0; channel < a.getNumChannels(); channel++){
+        for (int i = start; i < end; i++){
+            maxDifference = juce::jmax(maxDifference, std::abs(a.getSample(channel, i) - b.getSample(channel, i)));
+        }
+    }
+
+    return maxDifference;
+}
+
+float RenderCheck::getPeak(const juce::AudioBuffer<float>& buffer)
+{
+    float peak = 0;
+
+    for (int channel = 0; channel < buffer.getNumChannels(); channel++){
+        for (int i = 0; i < buffer.getNumSamples(); i++){
+            peak = juce::jmax(peak, std::abs(buffer.getSample(channel, i)));
+        }
+    }
+
+    return peak;
+}
+
+//==============================================================================
+RenderCheck::Comparison::Comparison(float tolerance, bool relativeToPeak)
+    : mTolerance(tolerance), mRelativeToPeak(relativeToPeak)
+{
+}
+
+float RenderCheck::Comparison::compare(const juce::AudioBuffer<float>& expected, const juce::AudioBuffer<float>& rendered, int start, int end)
+{
+    float difference = getMaxDifference(expected, rendered, start, end);
+
+    if (mRelativeToPeak){
+        difference /= getPeak(expected);
+    }
+
+    if (difference > mTolerance){
+        mNumFailures++;
+    }
+
+    return difference;
+}
+
+void RenderCheck::Comparison::check(const juce::String& whatFailed) const
+{
+    if (mNumFailures > 0){
+        juce::ConsoleApplication::fail(juce::String(mNumFailures) + " " + whatFailed);
+    }
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    RenderCheck.h
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "ChorusFlangerEngine.h"
+
+//==============================================================================
+/**
+    The fixture the benchmark's checks share: fixed noise, a fresh processor or
+    engine to render it through, and a comparison that counts the renders that
+    are not bit-identical, or not within a tolerance, to what they should be.
+*/
+namespace RenderCheck
+{
+    /** noise in [-1, 1) on every channel, the same for the same seed */
+    juce::AudioBuffer<float> createNoise(int numChannels, int numSamples, juce::int64 seed = 1);
+
+    /** sets plain parameter values, keyed by parameter ID, the way a host would */
+    void setParameters(juce::AudioProcessor& processor, const std::map<juce::String, float>& values);
+
+    /** a new stereo processor with the given parameter values, prepared for sampleRate and blockSize */
+    std::unique_ptr<KPChorusFlangerAudioProcessor> createProcessor(double sampleRate, int blockSize,
+                                                                   const std::map<juce::String, float>& values = {});
+
+    /** called before each block with its position in the render and the MIDI buffer it is processed with */
+    using BlockCallback = std::function<void(int position, int numSamples, juce::MidiBuffer& midi)>;
+
+    /** processes [start, end) of buffer in place through the processor, in blocks of blockSize from start.
+        An end of -1 is the end of the buffer */
+    void renderProcessor(juce::AudioProcessor& processor, juce::AudioBuffer<float>& buffer, int blockSize,
+                         const BlockCallback& beforeBlock = {}, int start = 0, int end = -1);
+
+    //==============================================================================
+    /** how renderEngine() sets up and drives a new ChorusFlangerEngine */
+    struct EngineSettings
+    {
+        ParameterSnapshot snapshot;
+
+        /** set at changeSample, none if it is negative. A change inside a block splits that block into
+            two segments of one startBlock / finishBlock call */
+        ParameterSnapshot changed;
+        int changeSample = -1;
+
+        double sampleRate = 48000;
+        int blockSize = 512;
+
+        /** the block size the engine is prepared for, blockSize if 0 */
+        int preparedBlockSize = 0;
+
+        /** one process call per entry instead of blocks of blockSize, they have to add up to the input */
+        std::vector<int> blockSizes;
+
+        LFO::Backend backend = LFO::kWavetable;
+        bool useReference = false;
+
+        /** prepare for this factor at most, as setMemoryReservation() does, or for every factor if negative */
+        int maxOversamplingIndex = -1;
+
+        /** process from the input into a separate output rather than in place */
+        bool outOfPlace = false;
+    };
+
+    /** what a render cost */
+    struct RenderStats
+    {
+        juce::int64 ticks = 0;
+        juce::int64 numSkippedBlocks = 0;
+    };
+
+    /** renders input through a new engine into output, which takes input's size */
+    template <typename SampleType>
+    RenderStats renderEngine(const EngineSettings& settings, const juce::AudioBuffer<SampleType>& input, juce::AudioBuffer<SampleType>& output);
+
+    //==============================================================================
+    /** the largest difference between a and b over [start, end) of every channel, end -1 is the end */
+    float getMaxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start = 0, int end = -1);
+
+    /** the largest magnitude in the buffer */
+    float getPeak(const juce::AudioBuffer<float>& buffer);
+
+    /** counts the renders that differ from the ones they are compared with by more than a tolerance */
+    class Comparison
+    {
+    public:
+
+        /** a tolerance of 0 asks for bit-identical output. A relative one is a fraction of the expected peak */
+        explicit Comparison(float tolerance, bool relativeToPeak = false);
+
+        /** the difference over [start, end), relative if asked. Counted as a failure past the tolerance */
+        float compare(const juce::AudioBuffer<float>& expected, const juce::AudioBuffer<float>& rendered, int start = 0, int end = -1);
+
+        /** counts a failure the caller found some other way */
+        void addFailure()                       { mNumFailures++; }
+
+        int getNumFailures() const              { return mNumFailures; }
+
+        /** fails the command, e.g. with "3 renders differ from the reference", if anything failed */
+        void check(const juce::String& whatFailed) const;
+
+    private:
+
+        float mTolerance;
+        bool mRelativeToPeak;
+        int mNumFailures = 0;
+    };
+}
@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    StateChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include "AllocationCounter.h"
+#include "StateFormat.h"
+
+namespace
+{
+    void state(const juce::ArgumentList& args)
+    {
+        const int numInstances = args.containsOption("--quick") ? 100 : 1000;
+
+        std::vector<std::unique_ptr<KPChorusFlangerAudioProcessor>> processors;
+
+        for (int i = 0; i < numInstances; i++){
+            processors.push_back(std::make_unique<KPChorusFlangerAudioProcessor>());
+        }
+
+        /** away from the defaults, so every load moves every parameter */
+        ParameterSnapshot snapshot;
+        snapshot.dryWet = 0.25f;
+        snapshot.depth = 0.75f;
+        snapshot.rate = 2.5f;
+        snapshot.phaseOffset = 0.5f;
+        snapshot.feedback = 0.25f;
+        snapshot.type = 1;
+        snapshot.waveform = LFO::kNumWaveforms - 1;
+        snapshot.interpolation = DelayLineReader::kNumModes - 1;
+        snapshot.oversampling = 1;
+        snapshot.offlineOversampling = 2;
+        snapshot.voices = 3;
+
+        struct Format
+        {
+            juce::String name;
+            juce::MemoryBlock state;
+            double bestSeconds = 0;
+            juce::int64 numAllocations = 0;
+            juce::MemoryBlock restored;
+        };
+
+        Format formats[2];
+        formats[0].name = "xml";
+        formats[1].name = "binary";
+        StateFormat::writeXml(snapshot, formats[0].state);
+        StateFormat::write(snapshot, formats[1].state);
+
+        /** loaded in between, so each timed load changes the values */
+        juce::MemoryBlock defaults;
+        StateFormat::write(ParameterSnapshot(), defaults);
+
+        for (auto& format : formats){
+            for (int run = 0; run < BenchmarkCommands::kNumRuns; run++){
+                for (auto& processor : processors){
+                    processor->setStateInformation(defaults.getData(), (int)defaults.getSize());
+                }
+
+                AllocationCounter counter;
+                const auto start = juce::Time::getHighResolutionTicks();
+
+                for (auto& processor : processors){
+                    processor->setStateInformation(format.state.getData(), (int)format.state.getSize());
+                }
+
+                const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+                format.numAllocations = counter.getNumAllocations();
+
+                if (run == 0 || seconds < format.bestSeconds){
+                    format.bestSeconds = seconds;
+                }
+            }
+
+            processors.front()->getStateInformation(format.restored);
+        }
+
+        std::cout << "Loading " << numInstances << " instances" << std::endl
+                  << "Format  bytes  ms total  us/instance  allocations/instance" << std::endl;
+
+        for (const auto& format : formats){
+            std::cout << format.name.paddedRight(' ', 8)
+                      << juce::String((int)format.state.getSize()).paddedRight(' ', 7)
+                      << juce::String(1000.0 * format.bestSeconds, 3).paddedRight(' ', 10)
+                      << juce::String(1.0e6 * format.bestSeconds / numInstances, 3).paddedRight(' ', 13)
+                      << juce::String((double)format.numAllocations / numInstances, 1) << std::endl;
+        }
+
+        std::cout << "Binary is " << juce::String(formats[0].bestSeconds / formats[1].bestSeconds, 1) << "x faster" << std::endl;
+
+        /** the migrated XML session and the binary one must leave the parameters in the same place */
+        if (formats[0].restored != formats[1].restored){
+            juce::ConsoleApplication::fail("The XML and binary states restore different parameters");
+        }
+
+        if (formats[1].numAllocations > 0){
+            juce::ConsoleApplication::fail("Loading the binary state allocated");
+        }
+    }
+}
+
+void BenchmarkCommands::addStateChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "state",
+                     "state [--quick]",
+                     "Times setStateInformation for 1000 instances, in the XML and the binary format.",
+                     "Both formats hold the same non-default settings. Reports the size of each state,\n"
+                     "the best of several loads and the heap allocations per instance. Fails if the\n"
+                     "two formats restore different parameters or if the binary load allocates.",
+                     state });
+}
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    StreamingChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void streaming(const juce::ArgumentList& args)
+    {
+        constexpr double kSampleRate = 48000;
+
+        /** the live rig's buffer, hosts may still send anything from 0 to twice that */
+        constexpr int kLiveBlockSize = 32;
+
+        /** the one-block reference is processed in sub-blocks of this size */
+        constexpr int kReferenceBlockSize = 4096;
+
+        const bool quick = args.containsOption("--quick");
+        const int numSamples = quick ? 16384 : 65536;
+        const int changeSample = numSamples / 2;
+
+        const auto noise = RenderCheck::createNoise(2, numSamples);
+
+        /** the same noise with a stretch of digital silence, long enough for the tail to run out */
+        juce::AudioBuffer<float> gaps;
+        gaps.makeCopyOf(noise);
+        gaps.clear(numSamples / 8, changeSample - numSamples / 8);
+
+        /** block sizes from nextSize() covering the input, with a call starting at changeSample */
+        auto createBlockSizes = [numSamples, changeSample] (std::function<int()> nextSize)
+        {
+            std::vector<int> blockSizes;
+
+            for (int position = 0; position < numSamples;){
+                const int end = position < changeSample ? changeSample : numSamples;
+                blockSizes.push_back(juce::jmin(nextSize(), end - position));
+                position += blockSizes.back();
+            }
+
+            return blockSizes;
+        };
+
+        /** one process call per block size, or one block with the change of parameters inside it if
+            blockSizes is empty */
+        auto createSettings = [numSamples, changeSample] (const ParameterSnapshot& snapshot, const ParameterSnapshot& changed, LFO::Backend backend,
+                                                          int preparedSize, const std::vector<int>& blockSizes)
+        {
+            RenderCheck::EngineSettings settings;
+            settings.snapshot = snapshot;
+            settings.changed = changed;
+            settings.changeSample = changeSample;
+            settings.sampleRate = kSampleRate;
+            settings.blockSize = numSamples;
+            settings.preparedBlockSize = preparedSize;
+            settings.blockSizes = blockSizes;
+            settings.backend = backend;
+            return settings;
+        };
+
+        juce::AudioBuffer<float> reference;
+        juce::AudioBuffer<float> streamed;
+        RenderCheck::Comparison comparison (0);
+        juce::Random random (1);
+
+        std::cout << "Random blocks of 0 to " << 2 * kLiveBlockSize << " samples against one block, max difference" << std::endl;
+
+        for (int type = 0; type < 2; type++){
+            for (int oversampling : { 0, 2 }){
+                for (int interpolation : { (int)DelayLineReader::kLinear, (int)DelayLineReader::kThiran, (int)DelayLineReader::kSinc }){
+                    for (int voices : { 1, 3 }){
+                        ParameterSnapshot snapshot;
+                        snapshot.type = type;
+                        snapshot.oversampling = oversampling;
+                        snapshot.interpolation = interpolation;
+                        snapshot.voices = voices;
+                        snapshot.waveform = (interpolation + voices) % LFO::kNumWaveforms;
+                        snapshot.phaseOffset = 0.25f;
+
+                        auto changed = snapshot;
+                        changed.depth = 0.9f;
+                        changed.rate = 3.f;
+                        changed.feedback = 0.8f;
+                        changed.dryWet = 0.7f;
+
+                        /** a zero-length call now and then, as some hosts send */
+                        const auto blockSizes = createBlockSizes([&random] { return random.nextInt(8) == 0 ? 0 : random.nextInt(2 * kLiveBlockSize + 1); });
+
+                        RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, kReferenceBlockSize, {}), noise, reference);
+                        RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, kLiveBlockSize, blockSizes), noise, streamed);
+
+                        std::cout << (type == 0 ? "Chorus  " : "Flanger ") << Oversampler::getFactorNames()[oversampling].paddedRight(' ', 4)
+                                  << DelayLineReader::getModeNames()[interpolation].paddedRight(' ', 12)
+                                  << voices << (voices == 1 ? " voice   " : " voices  ")
+                                  << comparison.compare(reference, streamed) << std::endl;
+                    }
+                }
+            }
+        }
+
+        /** every block the same size, prepared for that size. The quadrature LFO resyncs once per
+            block, and the idle check decides per block when the tail has run out and skips the rest
+            of the silence, so those two are where the block size can show. The modulation runs on through
+            skipped blocks, so the comparison carries on past the silence to the end */
+        ParameterSnapshot snapshot;
+        snapshot.feedback = 0.3f;
+
+        auto changed = snapshot;
+        changed.depth = 0.9f;
+
+        juce::AudioBuffer<float> quadratureReference;
+        juce::AudioBuffer<float> gapsReference;
+        RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, kReferenceBlockSize, {}), noise, reference);
+        RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kQuadrature, kReferenceBlockSize, {}), noise, quadratureReference);
+        RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, kReferenceBlockSize, {}), gaps, gapsReference);
+
+        std::cout << std::endl << "Fixed block sizes against one block, max difference" << std::endl
+                  << "Block  ns/sample  wavetable LFO  quadrature LFO  tail skipped" << std::endl;
+
+        for (int blockSize = 1; blockSize <= 512; blockSize *= 2){
+            const auto blockSizes = createBlockSizes([blockSize] { return blockSize; });
+
+            /** the best of a few runs */
+            juce::int64 ticks = 0;
+
+            for (int run = 0; run < (quick ? 3 : BenchmarkCommands::kNumRuns); run++){
+                const auto runTicks = RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, blockSize, blockSizes), noise, streamed).ticks;
+                ticks = (run == 0) ? runTicks : juce::jmin(ticks, runTicks);
+            }
+
+            const float difference = comparison.compare(reference, streamed);
+
+            RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kQuadrature, blockSize, blockSizes), noise, streamed);
+            const float quadratureDifference = RenderCheck::getMaxDifference(quadratureReference, streamed);
+
+            RenderCheck::renderEngine(createSettings(snapshot, changed, LFO::kWavetable, blockSize, blockSizes), gaps, streamed);
+            const float gapsDifference = RenderCheck::getMaxDifference(gapsReference, streamed, numSamples / 8);
+
+            std::cout << juce::String(blockSize).paddedRight(' ', 7)
+                      << juce::String(1.0e9 * juce::Time::highResolutionTicksToSeconds(ticks) / numSamples, 2).paddedRight(' ', 11)
+                      << juce::String(difference).paddedRight(' ', 15)
+                      << juce::String(quadratureDifference).paddedRight(' ', 16)
+                      << gapsDifference << std::endl;
+        }
+
+        comparison.check("streamed renders differ from one block");
+    }
+}
+
+void BenchmarkCommands::addStreamingChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "streaming",
+                     "streaming [--quick]",
+                     "Checks that random host block sizes give the same output as one block, and times small blocks.",
+                     "Feeds noise through the engine in random calls of 0 to 64 samples, with a parameter\n"
+                     "change half way, for both types at 1x and 4x, three interpolators and 1 or 3 voices.\n"
+                     "Fails unless every run is bit-identical to one large block. Then times fixed blocks\n"
+                     "of 1 to 512 samples and reports how far the quadrature LFO and the idle check,\n"
+                     "which work per block, move the output.",
+                     streaming });
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    TempoSyncChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+#include <thread>
+
+namespace
+{
+    /** a transport playing from sample 0 at a fixed tempo */
+    class TimelinePlayHead : public juce::AudioPlayHead
+    {
+    public:
+        TimelinePlayHead(double sampleRate, double bpm)
+            : mSamplesPerQuarterNote(sampleRate * 60.0 / bpm), mBpm(bpm)
+        {
+        }
+
+        void setPosition(juce::int64 position)      { mPosition = position; }
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(mBpm);
+            info.setTimeInSamples(mPosition);
+            info.setPpqPosition((double)mPosition / mSamplesPerQuarterNote);
+            info.setIsPlaying(true);
+            return info;
+        }
+
+    private:
+        double mSamplesPerQuarterNote;
+        double mBpm;
+        juce::int64 mPosition = 0;
+    };
+
+    void tempoSync(const juce::ArgumentList& args)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr double kBpm = 97.5;
+        constexpr int kBlockSize = 512;
+        constexpr int kPreRollBlocks = 4;
+        constexpr int kNumRegions = 8;
+
+        const int numBlocks = args.containsOption("--quick") ? 256 : 1024;
+        const auto input = RenderCheck::createNoise(2, numBlocks * kBlockSize);
+
+        /** without feedback the pre-roll only has to refill the delay line */
+        auto render = [&input] (int waveform, int noteValue, int firstBlock, int lastBlock, juce::AudioBuffer<float>& output)
+        {
+            auto processor = RenderCheck::createProcessor(kSampleRate, kBlockSize,
+                                                          { { "temposync", 1.f }, { "notevalue", (float)noteValue },
+                                                            { "waveform", (float)waveform }, { "depth", 1.f }, { "feedback", 0.f } });
+
+            TimelinePlayHead playHead (kSampleRate, kBpm);
+            processor->setPlayHead(&playHead);
+
+            const int first = juce::jmax(0, firstBlock - kPreRollBlocks);
+            processor->advanceModulation((juce::int64)first * kBlockSize);
+
+            juce::AudioBuffer<float> buffer;
+            buffer.makeCopyOf(input);
+
+            RenderCheck::renderProcessor(*processor, buffer, kBlockSize,
+                                         [&playHead] (int position, int, juce::MidiBuffer&) { playHead.setPosition(position); },
+                                         first * kBlockSize, lastBlock * kBlockSize);
+
+            for (int channel = 0; channel < 2; channel++){
+                output.copyFrom(channel, firstBlock * kBlockSize, buffer, channel, firstBlock * kBlockSize, (lastBlock - firstBlock) * kBlockSize);
+            }
+
+            processor->setPlayHead(nullptr);
+        };
+
+        std::cout << "Rendering " << kNumRegions << " regions in parallel against one pass, at " << kBpm << " bpm" << std::endl
+                  << "Waveform          Note value  max difference" << std::endl;
+
+        RenderCheck::Comparison comparison (0);
+
+        for (int waveform = 0; waveform < LFO::kNumWaveforms; waveform++){
+            for (int noteValue : { 0, TempoSync::kDefaultNoteValue, 11, TempoSync::getNumNoteValues() - 1 }){
+                juce::AudioBuffer<float> fullPass (2, input.getNumSamples());
+                juce::AudioBuffer<float> regions (2, input.getNumSamples());
+                render(waveform, noteValue, 0, numBlocks, fullPass);
+
+                /** each region writes its own part of the output, from its own processor */
+                std::vector<std::thread> threads;
+
+                for (int region = 0; region < kNumRegions; region++){
+                    threads.emplace_back([&, region]
+                    {
+                        render(waveform, noteValue, region * numBlocks / kNumRegions, (region + 1) * numBlocks / kNumRegions, regions);
+                    });
+                }
+
+                for (auto& thread : threads){
+                    thread.join();
+                }
+
+                std::cout << LFO::getWaveformNames()[waveform].paddedRight(' ', 18)
+                          << TempoSync::getNoteValueNames()[noteValue].paddedRight(' ', 12)
+                          << comparison.compare(fullPass, regions) << std::endl;
+            }
+        }
+
+        comparison.check("renders differ from the full pass");
+    }
+}
+
+void BenchmarkCommands::addTempoSyncChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "temposync",
+                     "temposync [--quick]",
+                     "Checks that tempo-synced renders of separate regions match a full pass.",
+                     "Renders noise with the LFO synced to a play head, once from the start and once\n"
+                     "as eight regions on their own threads, each from its own processor with a short\n"
+                     "pre-roll. Feedback is off, so the pre-roll only refills the delay line. Fails\n"
+                     "unless every waveform and note value tried is bit-identical.",
+                     tempoSync });
+}
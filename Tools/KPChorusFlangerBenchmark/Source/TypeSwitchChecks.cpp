@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    TypeSwitchChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void typeSwitch(const juce::ArgumentList&)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr int kNumSamples = 48000;
+        constexpr int kSwitchSample = kNumSamples / 2;
+
+        /** a steady sine, fully wet, so the only jumps in the output come from the delay */
+        juce::AudioBuffer<float> sine (2, kNumSamples);
+
+        for (int channel = 0; channel < sine.getNumChannels(); channel++){
+            for (int i = 0; i < kNumSamples; i++){
+                sine.setSample(channel, i, 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi * 440.0 * i / kSampleRate));
+            }
+        }
+
+        /** the largest step from one sample to the next in [start, end) */
+        auto getLargestStep = [] (const juce::AudioBuffer<float>& buffer, int start, int end)
+        {
+            float largestStep = 0;
+
+            for (int channel = 0; channel < buffer.getNumChannels(); channel++){
+                for (int i = start; i < end; i++){
+                    largestStep = juce::jmax(largestStep, std::abs(buffer.getSample(channel, i) - buffer.getSample(channel, i - 1)));
+                }
+            }
+
+            return largestStep;
+        };
+
+        /** one block with the switch at kSwitchSample inside it */
+        RenderCheck::EngineSettings settings;
+        settings.snapshot.feedback = 0;
+        settings.snapshot.dryWet = 1;
+        settings.changeSample = kSwitchSample;
+        settings.sampleRate = kSampleRate;
+        settings.blockSize = kNumSamples;
+
+        const int fadeLength = (int)(kSampleRate * ChorusFlangerEngine::kTypeFadeMs / 1000.0);
+        RenderCheck::Comparison comparison (KPChorusFlangerAudioProcessor::kBlockPathTolerance, true);
+
+        std::cout << "Largest step after the Type switch, relative to the largest step before it, and the" << std::endl
+                  << "difference between the two paths relative to the peak" << std::endl
+                  << "Switch             block      reference  difference" << std::endl;
+
+        for (int type = 0; type < ChorusFlangerEngine::kNumTypes; type++){
+            float ratios[2];
+            juce::AudioBuffer<float> outputs[2];
+
+            /** the block pipeline and the reference both fade the old Type out, with the std::sin LFO
+                they stay within kBlockPathTolerance of each other */
+            for (int useReference = 0; useReference < 2; useReference++){
+                auto typeSettings = settings;
+                typeSettings.snapshot.type = type;
+                typeSettings.changed = typeSettings.snapshot;
+                typeSettings.changed.type = 1 - type;
+                typeSettings.backend = LFO::kStdSine;
+                typeSettings.useReference = useReference != 0;
+
+                auto& output = outputs[useReference];
+                RenderCheck::renderEngine(typeSettings, sine, output);
+
+                ratios[useReference] = getLargestStep(output, kSwitchSample, kSwitchSample + 2 * fadeLength)
+                                         / getLargestStep(output, kSwitchSample - 4 * fadeLength, kSwitchSample);
+            }
+
+            const float relativeDifference = comparison.compare(outputs[1], outputs[0]);
+
+            std::cout << (type == 0 ? "Chorus to Flanger  " : "Flanger to Chorus  ")
+                      << juce::String(ratios[0], 2).paddedRight(' ', 11) << juce::String(ratios[1], 2).paddedRight(' ', 11)
+                      << relativeDifference << std::endl;
+
+            /** the sweep itself moves the step size a little, a click is many times larger */
+            if (ratios[0] > 1.5f || ratios[1] > 1.5f){
+                comparison.addFailure();
+            }
+        }
+
+        /** the other discrete values switch while the wet signal is dipped, as a preset recall or a
+            morph past halfway does */
+        std::cout << std::endl << "Largest step after a switch with the wet signal dipped, relative to before it" << std::endl;
+
+        const std::pair<const char*, std::function<void(ParameterSnapshot&)>> switches[] =
+        {
+            { "Waveform", [] (ParameterSnapshot& s) { s.waveform = LFO::kNumWaveforms - 1; } },
+            { "Voices", [] (ParameterSnapshot& s) { s.voices = 3; } },
+            { "Interpolation", [] (ParameterSnapshot& s) { s.interpolation = DelayLineReader::kSinc; } },
+            { "Tempo sync", [] (ParameterSnapshot& s) { s.tempoSync = 1; } },
+            { "All of them", [] (ParameterSnapshot& s) { s.waveform = LFO::kNumWaveforms - 1; s.voices = 3;
+                                                          s.interpolation = DelayLineReader::kSinc; s.tempoSync = 1; } }
+        };
+
+        for (const auto& change : switches){
+            auto switchSettings = settings;
+            switchSettings.changed = switchSettings.snapshot;
+            change.second(switchSettings.changed);
+
+            juce::AudioBuffer<float> output;
+            RenderCheck::renderEngine(switchSettings, sine, output);
+
+            const float ratio = getLargestStep(output, kSwitchSample, kSwitchSample + 4 * fadeLength)
+                                  / getLargestStep(output, kSwitchSample - 4 * fadeLength, kSwitchSample);
+
+            std::cout << juce::String(change.first).paddedRight(' ', 19) << juce::String(ratio, 2) << std::endl;
+
+            if (ratio > 1.5f){
+                comparison.addFailure();
+            }
+        }
+
+        comparison.check("switches click");
+    }
+}
+
+void BenchmarkCommands::addTypeSwitchChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "typeswitch",
+                     "typeswitch",
+                     "Checks that switching Type, or another discrete value, does not click.",
+                     "Switches a fully wet sine from Chorus to Flanger and back half way through, once\n"
+                     "through the block pipeline and once through the reference, both of which fade the\n"
+                     "old Type out over ChorusFlangerEngine::kTypeFadeMs. Reports the largest\n"
+                     "sample-to-sample step after the switch against the largest before it, and how far\n"
+                     "the two paths differ. Fails if either steps more than half as far again, or if the\n"
+                     "paths differ by more than KPChorusFlangerAudioProcessor::kBlockPathTolerance of\n"
+                     "the peak. Then does the same for Waveform, Voices, Interpolation and tempo sync,\n"
+                     "which switch while the wet signal is dipped.",
+                     typeSwitch });
+}
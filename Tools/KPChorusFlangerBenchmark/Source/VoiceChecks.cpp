@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    VoiceChecks.cpp
+    Created: 18 Oct 2026 2:14:37pm
+
+  ==============================================================================
+*/
+
+#include "BenchmarkCommands.h"
+
+namespace
+{
+    void voices(const juce::ArgumentList& args)
+    {
+        using namespace BenchmarkCommands;
+
+        const bool quick = args.containsOption("--quick");
+        Benchmark benchmark (quick ? kNumFrames / 4 : kNumFrames, quick ? 3 : kNumRuns);
+
+        BenchmarkCase benchmarkCase;
+        benchmarkCase.type = "chorus";
+        benchmarkCase.settingsName = "voices";
+        benchmarkCase.sampleRate = 48000;
+        benchmarkCase.blockSize = 512;
+
+        /** stacking instances costs one single-voice instance per voice */
+        double singleVoice = 0;
+
+        std::cout << "Voices  ns/sample  vs stacked instances" << std::endl;
+
+        for (int numVoices = 1; numVoices <= DelayLineReader::kMaxVoices; numVoices++){
+            benchmarkCase.parameterValues["voices"] = (float)numVoices;
+            const auto result = benchmark.runCase(benchmarkCase, false);
+
+            if (numVoices == 1){
+                singleVoice = result.nsPerSample;
+            }
+
+            std::cout << juce::String(numVoices).paddedRight(' ', 8)
+                      << juce::String(result.nsPerSample, 2).paddedRight(' ', 11)
+                      << juce::String(100.0 * result.nsPerSample / (numVoices * singleVoice), 0) << "%" << std::endl;
+        }
+    }
+}
+
+void BenchmarkCommands::addVoiceChecks(juce::ConsoleApplication& app)
+{
+    app.addCommand({ "voices",
+                     "voices [--quick]",
+                     "Times the chorus with 1 to 8 voices.",
+                     "Compares each voice count with stacking that many single-voice instances.",
+                     voices });
+}
@@ -0,0 +1,431 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 17 Oct 2026 4:31:10pm
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+
+#include <deque>
+
+namespace
+{
+    constexpr int kNumChannels = 2;
+
+    /** leftover feedback history is considered gone once it has been scaled below this */
+    constexpr double kPreRollResidual = 1.0 / 4294967296.0;
+}
+
+//==============================================================================
+struct BatchRenderer::Job
+{
+    int fileIndex = 0;
+    int chunkIndex = 0;
+    int numChunks = 1;
+
+    juce::int64 start = 0;
+    juce::int64 length = 0;
+    juce::int64 preRoll = 0;
+};
+
+/** where the chunks of one file meet: they can finish in any order but are written in order.
+    nextChunkToWrite and failed are read without the lock when deciding which chunk can start */
+struct BatchRenderer::FileOutput
+{
+    FileJob file;
+    double sampleRate = 0;
+    int numChunks = 1;
+
+    juce::CriticalSection lock;
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    std::map<int, juce::AudioBuffer<float>> pendingChunks;
+    int maxPendingChunks = 0;
+    std::atomic<int> nextChunkToWrite { 0 };
+    std::atomic<bool> failed { false };
+};
+
+/** one worker's deque. Jobs are whole files or long chunks, so a short spin lock per
+    queue costs nothing next to the job itself and keeps the stealing logic simple */
+class BatchRenderer::JobQueue
+{
+public:
+
+    /** whether a job may start now, a chunk too far ahead of its file's writer has to wait */
+    using CanStart = std::function<bool (const Job&)>;
+
+    void pushBack(const Job& job)
+    {
+        const juce::SpinLock::ScopedLockType lock (mLock);
+        mJobs.push_back(job);
+    }
+
+    /** the owner works through its queue from the largest job down, passing over jobs that cannot start */
+    bool popFront(Job& job, const CanStart& canStart)
+    {
+        const juce::SpinLock::ScopedLockType lock (mLock);
+
+        for (auto it = mJobs.begin(); it != mJobs.end(); ++it){
+            if (canStart(*it)){
+                job = *it;
+                mJobs.erase(it);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** thieves take from the small end, so a late steal does not leave one long job running alone */
+    bool stealBack(Job& job, const CanStart& canStart)
+    {
+        const juce::SpinLock::ScopedLockType lock (mLock);
+
+        for (auto it = mJobs.rbegin(); it != mJobs.rend(); ++it){
+            if (canStart(*it)){
+                job = *it;
+                mJobs.erase(std::next(it).base());
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+
+    juce::SpinLock mLock;
+    std::deque<Job> mJobs;
+};
+
+class BatchRenderer::Worker : public juce::Thread
+{
+public:
+
+    Worker(BatchRenderer& owner, int index)
+        : juce::Thread("KPChorusFlanger render " + juce::String(index)),
+          mOwner(owner),
+          mIndex(index)
+    {
+    }
+
+    void run() override
+    {
+        Job job;
+
+        while (! threadShouldExit() && mOwner.takeJob(mIndex, job)){
+            mOwner.runJob(*this, job);
+        }
+    }
+
+    KPChorusFlangerAudioProcessor processor;
+    OfflineRenderer renderer;
+    double preparedSampleRate = 0;
+    RenderStats stats;
+
+private:
+
+    BatchRenderer& mOwner;
+    const int mIndex;
+};
+
+//==============================================================================
+BatchRenderer::BatchRenderer(const RenderSettings& settings, int numThreads, double chunkSeconds)
+    : mSettings(settings),
+      mChunkSeconds(chunkSeconds),
+      mMaxChunksInFlight(juce::jmax(1, numThreads)),
+      mResult(juce::Result::ok())
+{
+    mSettings.blockSize = juce::jmax(1, mSettings.blockSize);
+
+    for (int i = 0; i < juce::jmax(1, numThreads); i++){
+        mQueues.push_back(std::make_unique<JobQueue>());
+        mWorkers.push_back(std::make_unique<Worker>(*this, i));
+    }
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    for (auto& worker : mWorkers){
+        worker->stopThread(-1);
+    }
+}
+
+double BatchRenderer::getChunkPreRollSeconds(float feedback)
+{
+    /** the history a chunk cannot see returns scaled by the feedback on every trip around the
+        delay line, so allow enough trips of the longest delay for it to fall below float resolution */
+    int numTrips = 1;
+
+    if (feedback > 0){
+        numTrips = (int)std::ceil(std::log(kPreRollResidual) / std::log(juce::jmin(feedback, 0.999f))) + 1;
+    }
+
+    return numTrips * MAX_DELAY_TIME;
+}
+
+juce::Result BatchRenderer::renderFiles(const std::vector<FileJob>& files, RenderStats& totalStats)
+{
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+    const int blockSize = mSettings.blockSize;
+
+    for (auto& worker : mWorkers){
+        OfflineRenderer::applySettings(worker->processor, mSettings);
+    }
+
+    /** the chunk pre-roll is matched to the feedback the render will use, a preset's or a morph
+        target's as much as one given as an option */
+    const float feedback = OfflineRenderer::getLargestFeedback(mWorkers.front()->processor);
+
+    /** the pre-roll fast-forward follows the block pipeline, so the reference path renders whole files */
+    const bool allowChunks = mChunkSeconds > 0 && ! mSettings.useReferenceProcessing;
+
+    OfflineRenderer planner;
+    std::vector<Job> jobs;
+
+    mOutputs.clear();
+    mResult = juce::Result::ok();
+    mMaxPendingChunks = 0;
+
+    for (int fileIndex = 0; fileIndex < (int)files.size(); fileIndex++){
+        auto reader = planner.createReader(files[fileIndex].inputFile);
+
+        if (reader == nullptr){
+            setError(juce::Result::fail("Cannot read " + files[fileIndex].inputFile.getFullPathName()));
+            continue;
+        }
+
+        const double sampleRate = reader->sampleRate;
+        const juce::int64 totalLength = reader->lengthInSamples + (juce::int64)(mSettings.tailSeconds * sampleRate);
+
+        /** chunks and pre-roll are whole blocks, so every block lines up with a render from 0 */
+        const juce::int64 chunkLength = juce::jmax((juce::int64)1, (juce::int64)(mChunkSeconds * sampleRate) / blockSize) * blockSize;
+        const juce::int64 preRoll = (juce::int64)std::ceil(getChunkPreRollSeconds(feedback) * sampleRate / blockSize) * blockSize;
+
+        int numChunks = 1;
+        if (allowChunks && totalLength > 2 * chunkLength){
+            numChunks = (int)((totalLength + chunkLength - 1) / chunkLength);
+        }
+
+        auto output = std::make_unique<FileOutput>();
+        output->file = files[fileIndex];
+        output->sampleRate = sampleRate;
+        output->numChunks = numChunks;
+        mOutputs.push_back(std::move(output));
+
+        for (int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++){
+            Job job;
+            job.fileIndex = (int)mOutputs.size() - 1;
+            job.chunkIndex = chunkIndex;
+            job.numChunks = numChunks;
+            job.start = chunkIndex * chunkLength;
+            job.length = (numChunks == 1) ? totalLength : juce::jmin(chunkLength, totalLength - job.start);
+            job.preRoll = (numChunks == 1) ? 0 : preRoll;
+            jobs.push_back(job);
+        }
+    }
+
+    /** longest jobs first, dealt round-robin, so the queues start out balanced */
+    std::stable_sort(jobs.begin(), jobs.end(), [] (const Job& a, const Job& b) { return a.length + a.preRoll > b.length + b.preRoll; });
+
+    for (size_t i = 0; i < jobs.size(); i++){
+        mQueues[i % mQueues.size()]->pushBack(jobs[i]);
+    }
+
+    mNumQueuedJobs = (int)jobs.size();
+
+    /** the processors are prepared before the threads start, for the first file's sample rate */
+    for (auto& worker : mWorkers){
+        if (! mOutputs.empty()){
+            OfflineRenderer::prepareProcessor(worker->processor, mOutputs.front()->sampleRate, blockSize);
+            worker->preparedSampleRate = mOutputs.front()->sampleRate;
+        }
+
+        worker->stats = RenderStats();
+    }
+
+    for (auto& worker : mWorkers){
+        worker->startThread();
+    }
+
+    for (auto& worker : mWorkers){
+        worker->waitForThreadToExit(-1);
+    }
+
+    totalStats = RenderStats();
+    for (auto& worker : mWorkers){
+        totalStats.audioSeconds += worker->stats.audioSeconds;
+        totalStats.processSeconds += worker->stats.processSeconds;
+    }
+    totalStats.totalSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    for (auto& output : mOutputs){
+        mMaxPendingChunks = juce::jmax(mMaxPendingChunks, output->maxPendingChunks);
+    }
+
+    mOutputs.clear();
+
+    return mResult;
+}
+
+bool BatchRenderer::canStart(const Job& job) const
+{
+    if (job.numChunks == 1){
+        return true;
+    }
+
+    /** the chunk the writer waits for can always start, so the file keeps moving. After a failure
+        nothing more is written and the remaining chunks only need taking off the queues */
+    const auto& output = *mOutputs[job.fileIndex];
+    return output.failed || job.chunkIndex < output.nextChunkToWrite + mMaxChunksInFlight;
+}
+
+bool BatchRenderer::takeJob(int workerIndex, Job& job)
+{
+    const JobQueue::CanStart canStartJob = [this] (const Job& queued) { return canStart(queued); };
+    const int numQueues = (int)mQueues.size();
+
+    /** no job creates new jobs, so once every queue is empty the batch is done */
+    while (mNumQueuedJobs > 0){
+        if (mQueues[workerIndex]->popFront(job, canStartJob)){
+            mNumQueuedJobs--;
+            return true;
+        }
+
+        /** nothing to start locally, try the other queues in turn */
+        for (int offset = 1; offset < numQueues; offset++){
+            if (mQueues[(workerIndex + offset) % numQueues]->stealBack(job, canStartJob)){
+                mNumQueuedJobs--;
+                return true;
+            }
+        }
+
+        /** every job left is a chunk too far ahead of its file, wait until another chunk is written */
+        mChunkWritten.wait(10);
+    }
+
+    return false;
+}
+
+void BatchRenderer::runJob(Worker& worker, const Job& job)
+{
+    auto& output = *mOutputs[job.fileIndex];
+    const int blockSize = mSettings.blockSize;
+
+    /** a chunk of a file that has already failed would only be thrown away */
+    if (job.numChunks > 1 && output.failed){
+        return;
+    }
+
+    auto reader = worker.renderer.createReader(output.file.inputFile);
+
+    if (reader == nullptr){
+        setError(juce::Result::fail("Cannot read " + output.file.inputFile.getFullPathName()));
+
+        if (job.numChunks > 1){
+            const juce::ScopedLock lock (output.lock);
+            output.failed = true;
+            output.pendingChunks.clear();
+            output.writer.reset();
+            mChunkWritten.signal();
+        }
+
+        return;
+    }
+
+    if (worker.preparedSampleRate != reader->sampleRate){
+        OfflineRenderer::prepareProcessor(worker.processor, reader->sampleRate, blockSize);
+        worker.preparedSampleRate = reader->sampleRate;
+    }
+
+    auto result = juce::Result::ok();
+    double processSeconds = 0;
+
+    if (job.numChunks == 1){
+        /** a whole file streams straight to its writer */
+        auto writer = worker.renderer.createWriter(output.file.outputFile, reader->sampleRate, mSettings.bitsPerSample, result);
+
+        if (writer != nullptr){
+            result = OfflineRenderer::renderRange(worker.processor, *reader, 0, job.length, 0, blockSize, mSettings.bpm,
+                                                  [&writer] (const juce::AudioBuffer<float>& block)
+                                                  {
+                                                      return writer->writeFromAudioSampleBuffer(block, 0, block.getNumSamples());
+                                                  },
+                                                  processSeconds);
+        }
+    }
+    else {
+        /** a chunk is kept in memory until the chunks before it have been written */
+        juce::AudioBuffer<float> chunk (kNumChannels, (int)job.length);
+        int numWritten = 0;
+
+        result = OfflineRenderer::renderRange(worker.processor, *reader, job.start, job.length, job.preRoll, blockSize, mSettings.bpm,
+                                              [&chunk, &numWritten] (const juce::AudioBuffer<float>& block)
+                                              {
+                                                  for (int channel = 0; channel < kNumChannels; channel++){
+                                                      chunk.copyFrom(channel, numWritten, block, channel, 0, block.getNumSamples());
+                                                  }
+                                                  numWritten += block.getNumSamples();
+                                                  return true;
+                                              },
+                                              processSeconds);
+
+        const juce::ScopedLock lock (output.lock);
+
+        if (result.wasOk() && ! output.failed){
+            output.pendingChunks[job.chunkIndex] = std::move(chunk);
+            output.maxPendingChunks = juce::jmax(output.maxPendingChunks, (int)output.pendingChunks.size());
+
+            if (output.writer == nullptr && output.nextChunkToWrite == 0){
+                output.writer = worker.renderer.createWriter(output.file.outputFile, output.sampleRate, mSettings.bitsPerSample, result);
+            }
+
+            while (result.wasOk() && output.writer != nullptr){
+                auto next = output.pendingChunks.find(output.nextChunkToWrite);
+                if (next == output.pendingChunks.end()){
+                    break;
+                }
+
+                if (! output.writer->writeFromAudioSampleBuffer(next->second, 0, next->second.getNumSamples())){
+                    result = juce::Result::fail("Write failed");
+                }
+
+                output.pendingChunks.erase(next);
+                output.nextChunkToWrite++;
+            }
+
+            /** closing the writer finalises the file header */
+            if (output.nextChunkToWrite == output.numChunks){
+                output.writer.reset();
+            }
+        }
+
+        if (result.failed()){
+            output.failed = true;
+            output.pendingChunks.clear();
+            output.writer.reset();
+        }
+
+        /** a written chunk or a failure can let waiting chunks of this file start */
+        mChunkWritten.signal();
+    }
+
+    if (result.failed()){
+        setError(juce::Result::fail(result.getErrorMessage() + " for " + output.file.outputFile.getFullPathName()));
+        return;
+    }
+
+    worker.stats.audioSeconds += job.length / reader->sampleRate;
+    worker.stats.processSeconds += processSeconds;
+}
+
+void BatchRenderer::setError(const juce::Result& result)
+{
+    const juce::ScopedLock lock (mResultLock);
+
+    if (mResult.wasOk()){
+        mResult = result;
+    }
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 17 Oct 2026 4:31:10pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+//==============================================================================
+/**
+    Renders many files on all cores.
+
+    Each worker thread owns a prepared KPChorusFlangerAudioProcessor. Files, or
+    chunks of long files, are spread over per-worker queues; a worker takes jobs
+    from the front of its own queue and steals from the back of the others when it
+    runs dry.
+
+    Every job starts from a reset processor, so a whole-file job is identical to a
+    single-threaded render. A chunk fast-forwards the modulation to its start and
+    processes a pre-roll long enough for the missing feedback history to decay
+    below 2^-32. Chunked files are then usually bit-identical to it. With high
+    feedback a difference in a chunk's last bits of rounding can stay in the
+    feedback loop, so they are only held to 1e-6 of the peak, see the chunks command.
+
+    Chunks are written in order, so one that finishes early waits in memory. A
+    chunk only starts while it is fewer than the number of threads ahead of the
+    next one to write, which bounds that memory for files of any length.
+*/
+class BatchRenderer
+{
+public:
+
+    struct FileJob
+    {
+        juce::File inputFile;
+        juce::File outputFile;
+    };
+
+    BatchRenderer(const RenderSettings& settings, int numThreads, double chunkSeconds);
+    ~BatchRenderer();
+
+    /** render all files, returns the first error but still renders the other files */
+    juce::Result renderFiles(const std::vector<FileJob>& files, RenderStats& totalStats);
+
+    /** pre-roll needed before a chunk for a feedback amount, in seconds */
+    static double getChunkPreRollSeconds(float feedback);
+
+    /** the most finished chunks any one file held in memory during the last renderFiles(), waiting for
+        the chunks before them. A chunk only starts while it is fewer than the number of threads ahead
+        of the chunk its file's writer needs next, so this stays below the number of threads */
+    int getMaxPendingChunks() const     { return mMaxPendingChunks; }
+
+private:
+
+    struct Job;
+    struct FileOutput;
+    class JobQueue;
+    class Worker;
+
+    void runJob(Worker& worker, const Job& job);
+    bool takeJob(int workerIndex, Job& job);
+    bool canStart(const Job& job) const;
+    void setError(const juce::Result& result);
+
+    RenderSettings mSettings;
+    double mChunkSeconds;
+
+    /** chunks of one file that may be started before the first of them is written */
+    const int mMaxChunksInFlight;
+    std::atomic<int> mNumQueuedJobs { 0 };
+    int mMaxPendingChunks = 0;
+    juce::WaitableEvent mChunkWritten;
+
+    std::vector<std::unique_ptr<JobQueue>> mQueues;
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::unique_ptr<FileOutput>> mOutputs;
+
+    juce::CriticalSection mResultLock;
+    juce::Result mResult;
+    RenderStats mTotalStats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchRenderer)
+};
@@ -0,0 +1,347 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+#include "BatchRenderer.h"
+#include "DspKernels.h"
+
+namespace
+{
+    /** the parameter IDs that can be given as --id=value on the command line */
+    const char* kParameterIDs[] = { "drywet", "depth", "rate", "phaseoffset", "feedback", "waveform", "interpolation", "offlineoversampling", "voices", "morph", "morphtarget", "temposync", "notevalue" };
+
+    RenderSettings parseSettings(const juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+
+        if (args.containsOption("--block-size")){
+            settings.blockSize = args.getValueForOption("--block-size").getIntValue();
+        }
+        if (args.containsOption("--bits")){
+            settings.bitsPerSample = args.getValueForOption("--bits").getIntValue();
+        }
+        if (args.containsOption("--tail")){
+            settings.tailSeconds = args.getValueForOption("--tail").getDoubleValue();
+        }
+        if (args.containsOption("--bpm")){
+            settings.bpm = juce::jmax(1.0, args.getValueForOption("--bpm").getDoubleValue());
+        }
+
+        settings.presetName = args.getValueForOption("--preset");
+
+        for (auto* parameterID : kParameterIDs){
+            const juce::String option = "--" + juce::String(parameterID);
+            if (args.containsOption(option)){
+                settings.parameterValues[parameterID] = args.getValueForOption(option).getFloatValue();
+            }
+        }
+
+        /** Type takes either its name or its index */
+        if (args.containsOption("--type")){
+            const auto type = args.getValueForOption("--type");
+            if (type.equalsIgnoreCase("chorus")){
+                settings.parameterValues["type"] = 0;
+            } else if (type.equalsIgnoreCase("flanger")){
+                settings.parameterValues["type"] = 1;
+            } else {
+                settings.parameterValues["type"] = type.getFloatValue();
+            }
+        }
+
+        if (args.containsOption("--lfo")){
+            const auto backend = args.getValueForOption("--lfo");
+            if (backend.equalsIgnoreCase("quadrature"))     settings.lfoBackend = LFO::kQuadrature;
+            else if (backend.equalsIgnoreCase("polynomial")) settings.lfoBackend = LFO::kPolynomial;
+            else if (backend.equalsIgnoreCase("sin"))        settings.lfoBackend = LFO::kStdSine;
+            else                                             settings.lfoBackend = LFO::kWavetable;
+        }
+
+        settings.useReferenceProcessing = args.containsOption("--reference");
+
+        /** the instruction set is chosen for the whole process, like KPCHORUSFLANGER_ISA */
+        if (args.containsOption("--isa")){
+            const auto name = args.getValueForOption("--isa");
+            const auto isa = DspKernels::findIsa(name);
+
+            if (isa == DspKernels::kNumIsas){
+                juce::ConsoleApplication::fail("Unknown instruction set: " + name);
+            }
+
+            DspKernels::setIsa(isa);
+        }
+
+        return settings;
+    }
+
+    void render(const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments(3);
+
+        const auto inputFile = args[1].resolveAsExistingFile();
+        const auto outputFile = args[2].resolveAsFile();
+        const auto settings = parseSettings(args);
+
+        KPChorusFlangerAudioProcessor processor;
+        OfflineRenderer renderer;
+
+        auto result = OfflineRenderer::applySettings(processor, settings);
+
+        if (result.wasOk()){
+            RenderStats stats;
+            result = renderer.renderFile(processor, inputFile, outputFile, settings, stats);
+
+            if (result.wasOk()){
+                std::cout << "Rendered " << stats.audioSeconds << " s of audio in "
+                          << stats.totalSeconds << " s" << std::endl
+                          << "Real-time factor: " << stats.getTotalRealtimeFactor() << "x total, "
+                          << stats.getProcessRealtimeFactor() << "x processBlock only" << std::endl;
+            }
+        }
+
+        /** the processor's own per-block instrumentation, cycles, block sizes and events */
+        if (result.wasOk() && args.containsOption("--stats")){
+            const auto statsFile = args.getFileForOption("--stats");
+
+            if (! statsFile.replaceWithText(processor.getInstrumentation().toJSON())){
+                result = juce::Result::fail("Cannot write " + statsFile.getFullPathName());
+            }
+        }
+
+        if (result.failed()){
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+    }
+
+    void batch(const juce::ArgumentList& args)
+    {
+        args.checkMinNumArguments(3);
+
+        const auto outputFolder = args[1].resolveAsFile();
+        const auto settings = parseSettings(args);
+
+        const int numThreads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue()
+                                                                : juce::SystemStats::getNumCpus();
+        const double chunkSeconds = args.getValueForOption("--chunk-seconds").getDoubleValue();
+        const juce::String format = args.getValueForOption("--format");
+
+        if (! outputFolder.isDirectory() && ! outputFolder.createDirectory()){
+            juce::ConsoleApplication::fail("Cannot create " + outputFolder.getFullPathName());
+        }
+
+        /** every argument after the output folder that is not an option is an input file */
+        std::vector<BatchRenderer::FileJob> files;
+
+        for (int i = 2; i < args.size(); i++){
+            if (args[i].isOption()){
+                continue;
+            }
+
+            const auto inputFile = args[i].resolveAsExistingFile();
+            const auto extension = format.isNotEmpty() ? "." + format : inputFile.getFileExtension();
+            files.push_back({ inputFile, outputFolder.getChildFile(inputFile.getFileNameWithoutExtension() + extension) });
+        }
+
+        BatchRenderer renderer (settings, numThreads, chunkSeconds);
+        RenderStats stats;
+
+        const auto result = renderer.renderFiles(files, stats);
+
+        std::cout << "Rendered " << (int)files.size() << " files, " << stats.audioSeconds << " s of audio in "
+                  << stats.totalSeconds << " s on " << numThreads << " threads" << std::endl
+                  << "Real-time factor: " << stats.getTotalRealtimeFactor() << "x total, "
+                  << stats.getProcessRealtimeFactor() << "x per thread in processBlock" << std::endl;
+
+        if (result.failed()){
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+    }
+
+    void chunks(const juce::ArgumentList& args)
+    {
+        constexpr double kSampleRate = 48000;
+        constexpr double kLengthSeconds = 20;
+        constexpr double kChunkSeconds = 1;
+
+        /** the pre-roll leaves at most 2^-32 of the history a chunk cannot see. Most settings then come
+            out bit-identical, but a chunk's rounding can differ in the last bits, and with high feedback
+            the feedback loop keeps that going. Allowed relative to the peak, about 2^-20 */
+        constexpr float kTolerance = 1.0e-6f;
+
+        const int numThreads = args.containsOption("--threads") ? args.getValueForOption("--threads").getIntValue()
+                                                                : juce::SystemStats::getNumCpus();
+
+        /** float files, so the comparison is not hidden by the output's bit depth */
+        auto settings = parseSettings(args);
+        settings.bitsPerSample = 32;
+
+        const auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory).getNonexistentChildFile("KPChorusFlangerChunks", "");
+        folder.createDirectory();
+
+        const auto inputFile = folder.getChildFile("noise.wav");
+        const auto wholeFile = folder.getChildFile("whole.wav");
+        const auto chunkedFile = folder.getChildFile("chunked.wav");
+
+        /** noise long enough for twenty chunks */
+        OfflineRenderer renderer;
+        auto result = juce::Result::ok();
+
+        if (auto writer = renderer.createWriter(inputFile, kSampleRate, settings.bitsPerSample, result)){
+            juce::AudioBuffer<float> noise (2, (int)(kLengthSeconds * kSampleRate));
+            juce::Random random (1);
+
+            for (int channel = 0; channel < noise.getNumChannels(); channel++){
+                for (int i = 0; i < noise.getNumSamples(); i++){
+                    noise.setSample(channel, i, random.nextFloat() - 0.5f);
+                }
+            }
+
+            if (! writer->writeFromAudioSampleBuffer(noise, 0, noise.getNumSamples())){
+                result = juce::Result::fail("Cannot write " + inputFile.getFullPathName());
+            }
+        }
+
+        RenderStats stats;
+        int maxPendingChunks = 0;
+
+        if (result.wasOk()){
+            result = BatchRenderer (settings, numThreads, 0).renderFiles({ { inputFile, wholeFile } }, stats);
+        }
+
+        if (result.wasOk()){
+            BatchRenderer chunkedRenderer (settings, numThreads, kChunkSeconds);
+            result = chunkedRenderer.renderFiles({ { inputFile, chunkedFile } }, stats);
+            maxPendingChunks = chunkedRenderer.getMaxPendingChunks();
+        }
+
+        float maxDifference = 0;
+        float peak = 0;
+
+        if (result.wasOk()){
+            auto whole = renderer.createReader(wholeFile);
+            auto chunked = renderer.createReader(chunkedFile);
+
+            if (whole == nullptr || chunked == nullptr || whole->lengthInSamples != chunked->lengthInSamples){
+                result = juce::Result::fail("The chunked render is not the same length as the whole one");
+            } else {
+                juce::AudioBuffer<float> a (2, (int)whole->lengthInSamples);
+                juce::AudioBuffer<float> b (2, (int)chunked->lengthInSamples);
+                whole->read(&a, 0, a.getNumSamples(), 0, true, true);
+                chunked->read(&b, 0, b.getNumSamples(), 0, true, true);
+
+                for (int channel = 0; channel < 2; channel++){
+                    for (int i = 0; i < a.getNumSamples(); i++){
+                        maxDifference = juce::jmax(maxDifference, std::abs(a.getSample(channel, i) - b.getSample(channel, i)));
+                    }
+                }
+
+                peak = a.getMagnitude(0, a.getNumSamples());
+            }
+        }
+
+        folder.deleteRecursively();
+
+        if (result.failed()){
+            juce::ConsoleApplication::fail(result.getErrorMessage());
+        }
+
+        const float relativeDifference = peak > 0 ? maxDifference / peak : maxDifference;
+
+        std::cout << "Chunked against whole, max difference " << maxDifference << ", " << relativeDifference << " of the peak" << std::endl
+                  << "Most chunks waiting to be written " << maxPendingChunks << " on " << numThreads << " threads" << std::endl;
+
+        if (relativeDifference > kTolerance){
+            juce::ConsoleApplication::fail("The chunked render differs by more than " + juce::String(kTolerance) + " of the peak");
+        }
+
+        if (maxPendingChunks >= juce::jmax(1, numThreads)){
+            juce::ConsoleApplication::fail("More chunks waited to be written than there are threads");
+        }
+    }
+
+    void presets(const juce::ArgumentList&)
+    {
+        KPChorusFlangerAudioProcessor processor;
+        const auto& bank = processor.getPresetBank();
+
+        for (int i = 0; i < bank.getNumPresets(); i++){
+            std::cout << juce::String(i).paddedLeft(' ', 3) << "  "
+                      << bank.getName(i).paddedRight(' ', 24)
+                      << (bank.isFactoryPreset(i) ? "factory" : "user") << std::endl;
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+
+    app.addHelpCommand("--help|-h", "Usage:", true);
+
+    app.addCommand({ "render",
+                     "render <input> <output> [options]",
+                     "Renders an audio file through KPChorusFlanger.",
+                     "Streams <input> through the processor block by block and writes <output>.\n"
+                     "WAV and FLAC are chosen from the output file extension.\n\n"
+                     "Options:\n"
+                     "  --type=chorus|flanger  --drywet=  --depth=  --rate=  --phaseoffset=\n"
+                     "  --feedback=  --waveform=  --interpolation=  --voices=\n"
+                     "                         parameter values in their plain ranges\n"
+                     "  --preset=name          start from a factory or user preset, see presets\n"
+                     "  --morph=0..1  --morphtarget=N\n"
+                     "                         move towards preset N by the morph amount\n"
+                     "  --temposync=0|1  --notevalue=N  --bpm=T\n"
+                     "                         lock the LFO to note value N (0 is 8/1, 7 is 1/4,\n"
+                     "                         14 is 1/32) on a timeline at T bpm (default 120)\n"
+                     "  --offlineoversampling=0|1|2|3\n"
+                     "                         1x, 2x, 4x or 8x, the output is delayed by the\n"
+                     "                         filter latency the processor reports"
+                     "  --block-size=N         samples per processBlock call (default 512)\n"
+                     "  --bits=N               output bit depth (default 24)\n"
+                     "  --tail=S               seconds of silence to render after the input\n"
+                     "  --lfo=wavetable|quadrature|polynomial|sin\n"
+                     "  --reference            use the per-sample reference implementation\n"
+                     "  --isa=generic|sse4.1|avx2|avx512\n"
+                     "                         force the kernels of one instruction set, the output\n"
+                     "                         is the same with any of them\n"
+                     "  --stats=file.json      write the processor's block instrumentation as JSON",
+                     render });
+
+    app.addCommand({ "batch",
+                     "batch <output folder> <inputs...> [options]",
+                     "Renders many files in parallel.",
+                     "Renders every input into the output folder, using the same file name.\n"
+                     "Takes the render options, plus:\n"
+                     "  --threads=N            worker threads (default: number of CPUs)\n"
+                     "  --chunk-seconds=S      split long files into chunks of about S seconds\n"
+                     "  --format=wav|flac      output format (default: same as the input)\n\n"
+                     "Whole files are identical to rendering each file on its own. Chunked files\n"
+                     "usually are too, with high feedback their last bits can differ, see chunks.",
+                     batch });
+
+    app.addCommand({ "chunks",
+                     "chunks [options]",
+                     "Checks that a chunked batch render matches a whole-file render.",
+                     "Writes 20 s of noise to a temporary folder and renders it with batch, once whole\n"
+                     "and once in 1 s chunks, into 32-bit float files. Fails if they differ by more\n"
+                     "than 1e-6 of the peak, or if a chunk waited to be written while as many chunks\n"
+                     "as there are threads were ahead of it. Takes the render options and --threads,\n"
+                     "e.g. --type=flanger --feedback=0.9.",
+                     chunks });
+
+    app.addCommand({ "presets",
+                     "presets",
+                     "Lists the factory and user presets.",
+                     "Prints the index and name of every preset, for --preset and --morphtarget.",
+                     presets });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 17 Oct 2026 2:05:51pm
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+namespace
+{
+    /** the processor only supports a stereo in / stereo out layout */
+    constexpr int kNumChannels = 2;
+
+    juce::RangedAudioParameter* findParameter(juce::AudioProcessor& processor, const juce::String& parameterID)
+    {
+        for (auto* parameter : processor.getParameters()){
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)){
+                if (ranged->paramID == parameterID){
+                    return ranged;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /** a transport playing from input sample 0 at a fixed tempo */
+    class TimelinePlayHead : public juce::AudioPlayHead
+    {
+    public:
+        TimelinePlayHead(double sampleRate, double bpm)
+            : mSamplesPerQuarterNote(sampleRate * 60.0 / bpm), mBpm(bpm)
+        {
+        }
+
+        void setPosition(juce::int64 position)      { mPosition = position; }
+
+        juce::Optional<PositionInfo> getPosition() const override
+        {
+            PositionInfo info;
+            info.setBpm(mBpm);
+            info.setTimeInSamples(mPosition);
+            info.setPpqPosition((double)mPosition / mSamplesPerQuarterNote);
+            info.setIsPlaying(true);
+            return info;
+        }
+
+    private:
+        double mSamplesPerQuarterNote;
+        double mBpm;
+        juce::int64 mPosition = 0;
+    };
+}
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer()
+{
+    mFormatManager.registerBasicFormats();
+}
+
+juce::Result OfflineRenderer::applySettings(KPChorusFlangerAudioProcessor& processor, const RenderSettings& settings)
+{
+    if (settings.presetName.isNotEmpty()){
+        const int index = processor.getPresetBank().findPreset(settings.presetName);
+
+        if (index < 0){
+            return juce::Result::fail("Unknown preset: " + settings.presetName);
+        }
+
+        processor.setCurrentProgram(index);
+    }
+
+    for (const auto& value : settings.parameterValues){
+        auto* parameter = findParameter(processor, value.first);
+
+        if (parameter == nullptr){
+            return juce::Result::fail("Unknown parameter: " + value.first);
+        }
+
+        const auto& range = parameter->getNormalisableRange();
+        const float limited = juce::jlimit(range.start, range.end, value.second);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(limited));
+    }
+
+    processor.setUseReferenceProcessing(settings.useReferenceProcessing);
+    processor.setLFOBackend(settings.lfoBackend);
+
+    return juce::Result::ok();
+}
+
+float OfflineRenderer::getLargestFeedback(KPChorusFlangerAudioProcessor& processor)
+{
+    auto getValue = [&processor] (const juce::String& parameterID)
+    {
+        auto* parameter = findParameter(processor, parameterID);
+        return parameter->convertFrom0to1(parameter->getValue());
+    };
+
+    float feedback = getValue("feedback");
+
+    /** a morph moves the feedback in a straight line towards the target's, so one of the two is the most */
+    if (getValue("morph") > 0){
+        auto& presets = processor.getPresetBank();
+        const int target = juce::jmin((int)getValue("morphtarget"), presets.getNumPresets() - 1);
+        feedback = juce::jmax(feedback, presets.getPreset(target).feedback);
+    }
+
+    return feedback;
+}
+
+juce::Result OfflineRenderer::renderFile(KPChorusFlangerAudioProcessor& processor,
+                                         const juce::File& inputFile,
+                                         const juce::File& outputFile,
+                                         const RenderSettings& settings,
+                                         RenderStats& stats)
+{
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    auto reader = createReader(inputFile);
+
+    if (reader == nullptr){
+        return juce::Result::fail("Cannot read " + inputFile.getFullPathName());
+    }
+
+    auto result = juce::Result::ok();
+    auto writer = createWriter(outputFile, reader->sampleRate, settings.bitsPerSample, result);
+
+    if (writer == nullptr){
+        return result;
+    }
+
+    const int blockSize = juce::jmax(1, settings.blockSize);
+    prepareProcessor(processor, reader->sampleRate, blockSize);
+
+    const juce::int64 totalLength = reader->lengthInSamples + (juce::int64)(settings.tailSeconds * reader->sampleRate);
+
+    double processSeconds = 0;
+    result = renderRange(processor, *reader, 0, totalLength, 0, blockSize, settings.bpm,
+                         [&writer] (const juce::AudioBuffer<float>& block)
+                         {
+                             return writer->writeFromAudioSampleBuffer(block, 0, block.getNumSamples());
+                         },
+                         processSeconds);
+
+    processor.releaseResources();
+    writer.reset();
+
+    if (result.failed()){
+        return juce::Result::fail(result.getErrorMessage() + " for " + outputFile.getFullPathName());
+    }
+
+    stats.audioSeconds = totalLength / reader->sampleRate;
+    stats.processSeconds = processSeconds;
+    stats.totalSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::renderRange(KPChorusFlangerAudioProcessor& processor,
+                                          juce::AudioFormatReader& reader,
+                                          juce::int64 start,
+                                          juce::int64 length,
+                                          juce::int64 preRoll,
+                                          int blockSize,
+                                          double bpm,
+                                          const BlockWriter& writeBlock,
+                                          double& processSeconds)
+{
+    jassert (start % blockSize == 0 && preRoll % blockSize == 0 && bpm > 0);
+
+    const juce::int64 first = juce::jmax((juce::int64)0, start - preRoll);
+    const juce::int64 end = start + length;
+    const juce::int64 inputLength = reader.lengthInSamples;
+
+    TimelinePlayHead playHead (reader.sampleRate, bpm);
+    processor.setPlayHead(&playHead);
+
+    processor.reset();
+    processor.advanceModulation(first);
+
+    juce::AudioBuffer<float> buffer (kNumChannels, blockSize);
+    juce::MidiBuffer midiMessages;
+
+    double processMilliseconds = 0;
+
+    for (juce::int64 position = first; position < end; position += blockSize){
+        const int numSamples = (int)juce::jmin((juce::int64)blockSize, end - position);
+
+        /** the last block can be shorter, so process a view of the right size */
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), kNumChannels, numSamples);
+        block.clear();
+
+        /** a mono file is read into both channels, past the end of the input the tail runs on silence */
+        if (position < inputLength){
+            const int numToRead = (int)juce::jmin((juce::int64)numSamples, inputLength - position);
+            reader.read(&block, 0, numToRead, position, true, true);
+        }
+
+        playHead.setPosition(position);
+
+        const double blockStart = juce::Time::getMillisecondCounterHiRes();
+        processor.processBlock(block, midiMessages);
+        processMilliseconds += juce::Time::getMillisecondCounterHiRes() - blockStart;
+
+        /** pre-roll blocks only warm up the delay line and feedback */
+        if (position >= start && ! writeBlock(block)){
+            processor.setPlayHead(nullptr);
+            return juce::Result::fail("Write failed");
+        }
+    }
+
+    processor.setPlayHead(nullptr);
+
+    processSeconds += processMilliseconds / 1000.0;
+
+    return juce::Result::ok();
+}
+
+void OfflineRenderer::prepareProcessor(KPChorusFlangerAudioProcessor& processor, double sampleRate, int blockSize)
+{
+    processor.setNonRealtime(true);
+    processor.setPlayConfigDetails(kNumChannels, kNumChannels, sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+std::unique_ptr<juce::AudioFormatReader> OfflineRenderer::createReader(const juce::File& inputFile)
+{
+    return std::unique_ptr<juce::AudioFormatReader> (mFormatManager.createReaderFor(inputFile));
+}
+
+std::unique_ptr<juce::AudioFormatWriter> OfflineRenderer::createWriter(const juce::File& outputFile,
+                                                                       double sampleRate,
+                                                                       int bitsPerSample,
+                                                                       juce::Result& result)
+{
+    auto* format = mFormatManager.findFormatForFileExtension(outputFile.getFileExtension());
+
+    if (format == nullptr){
+        result = juce::Result::fail("Unsupported output format: " + outputFile.getFileName());
+        return {};
+    }
+
+    outputFile.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream (outputFile.createOutputStream());
+
+    if (stream == nullptr){
+        result = juce::Result::fail("Cannot write " + outputFile.getFullPathName());
+        return {};
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer (format->createWriterFor(stream.get(),
+                                                                             sampleRate,
+                                                                             kNumChannels,
+                                                                             bitsPerSample,
+                                                                             {},
+                                                                             0));
+    if (writer == nullptr){
+        result = juce::Result::fail("Cannot create a " + format->getFormatName() + " writer for "
+                                    + juce::String(bitsPerSample) + " bits");
+        return {};
+    }
+
+    /** the writer owns the stream from here on */
+    stream.release();
+
+    return writer;
+}
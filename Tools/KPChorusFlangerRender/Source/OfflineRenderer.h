@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 17 Oct 2026 2:05:51pm
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+//==============================================================================
+/** everything the command line can change about a render */
+struct RenderSettings
+{
+    int blockSize = 512;
+    int bitsPerSample = 24;
+    double tailSeconds = 0;
+
+    bool useReferenceProcessing = false;
+    LFO::Backend lfoBackend = LFO::kWavetable;
+
+    /** the tempo of the timeline a render plays, for a tempo-synced LFO */
+    double bpm = 120;
+
+    /** a factory or user preset, recalled before the parameter values are set */
+    juce::String presetName;
+
+    /** plain parameter values keyed by parameter ID, e.g. "rate" -> 2.5 */
+    std::map<juce::String, float> parameterValues;
+};
+
+/** timing of a render, used for the real-time factor report. In a batch processSeconds adds
+    up the time of every thread while totalSeconds is the wall-clock time of the whole batch */
+struct RenderStats
+{
+    double audioSeconds = 0;
+    double processSeconds = 0;
+    double totalSeconds = 0;
+
+    double getProcessRealtimeFactor() const { return processSeconds > 0 ? audioSeconds / processSeconds : 0; }
+    double getTotalRealtimeFactor() const   { return totalSeconds > 0 ? audioSeconds / totalSeconds : 0; }
+};
+
+//==============================================================================
+/**
+    Streams audio files through KPChorusFlangerAudioProcessor without a host.
+
+    Only one block of audio is held in memory at a time, so files of any length
+    render in bounded memory.
+*/
+class OfflineRenderer
+{
+public:
+
+    OfflineRenderer();
+
+    /** set parameters and processing options on a processor, fails on an unknown parameter ID */
+    static juce::Result applySettings(KPChorusFlangerAudioProcessor& processor, const RenderSettings& settings);
+
+    /** the most feedback a processor's settings reach: its own, or the morph target's while morphing */
+    static float getLargestFeedback(KPChorusFlangerAudioProcessor& processor);
+
+    /** render inputFile into outputFile, the output format follows the output file extension */
+    juce::Result renderFile(KPChorusFlangerAudioProcessor& processor,
+                            const juce::File& inputFile,
+                            const juce::File& outputFile,
+                            const RenderSettings& settings,
+                            RenderStats& stats);
+
+    /** receives each processed block of a range, returns false to abort the render */
+    using BlockWriter = std::function<bool (const juce::AudioBuffer<float>&)>;
+
+    /** render input samples [start, start + length) of a prepared processor from a clean state.
+        The modulation is fast-forwarded to start - preRoll, then the pre-roll is processed but
+        not written so the delay line and feedback hold what a render from 0 would hold. start and
+        preRoll must be multiples of blockSize so the blocks line up with a render from 0. Reads
+        past the end of the input feed silence, for tails. The processor sees a play head at bpm
+        whose timeline starts at input sample 0, so a tempo-synced LFO is where it would be in a
+        render from 0 */
+    static juce::Result renderRange(KPChorusFlangerAudioProcessor& processor,
+                                    juce::AudioFormatReader& reader,
+                                    juce::int64 start,
+                                    juce::int64 length,
+                                    juce::int64 preRoll,
+                                    int blockSize,
+                                    double bpm,
+                                    const BlockWriter& writeBlock,
+                                    double& processSeconds);
+
+    /** prepare a processor for offline rendering at the given format */
+    static void prepareProcessor(KPChorusFlangerAudioProcessor& processor, double sampleRate, int blockSize);
+
+    std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& inputFile);
+
+    /** create a stereo writer for outputFile, replacing any existing file */
+    std::unique_ptr<juce::AudioFormatWriter> createWriter(const juce::File& outputFile,
+                                                          double sampleRate,
+                                                          int bitsPerSample,
+                                                          juce::Result& result);
+
+private:
+
+    juce::AudioFormatManager mFormatManager;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};